@@ -0,0 +1,241 @@
+/*!
+* \brief:  Declares the read only memory mapped file
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ChessNS
+{
+    /*!
+     * \class   MappedFile
+     *
+     * \brief   A file mapped read only into the memory. The pages are loaded by the operating system on the first
+     *          access and shared with every other mapping of the same file, so opening is cheap for any size.
+     */
+    class MappedFile
+    {
+    public:
+
+        MappedFile() = default;
+
+        /*!
+         * \fn  explicit MappedFile::MappedFile(const std::string& filename)
+         *
+         * \brief   Constructor, opens the file
+         *
+         * \param   filename    The filename.
+         */
+        explicit MappedFile(const std::string& filename)
+        {
+            open(filename);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept
+        {
+            swap(other);
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            close();
+            swap(other);
+            return *this;
+        }
+
+        ~MappedFile()
+        {
+            close();
+        }
+
+        /*!
+         * \fn  bool MappedFile::open(const std::string& filename)
+         *
+         * \brief   Maps a file, a mapped file is closed before
+         *
+         * \param   filename    The filename.
+         *
+         * \returns True if it succeeds, false if the file can not be opened or mapped.
+         */
+        bool open(const std::string& filename)
+        {
+            close();
+
+#ifdef _WIN32
+            _file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+            LARGE_INTEGER size;
+            if (_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file, &size))
+            {
+                close();
+                return false;
+            }
+
+            _size = static_cast<size_t>(size.QuadPart);
+            if (_size != 0)
+            {
+                _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (_mapping != nullptr)
+                    _data = static_cast<const unsigned char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+                if (_data == nullptr)
+                {
+                    close();
+                    return false;
+                }
+            }
+#else
+            const auto file = ::open(filename.c_str(), O_RDONLY);
+            struct stat status{};
+            if (file < 0 || fstat(file, &status) != 0)
+            {
+                if (file >= 0)
+                    ::close(file);
+                return false;
+            }
+
+            // the mapping stays valid after closing the descriptor
+            _size = static_cast<size_t>(status.st_size);
+            if (_size != 0)
+            {
+                auto* data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, file, 0);
+                if (data == MAP_FAILED)
+                {
+                    ::close(file);
+                    _size = 0;
+                    return false;
+                }
+                _data = static_cast<const unsigned char*>(data);
+            }
+            ::close(file);
+#endif
+
+            _open = true;
+            return true;
+        }
+
+        /*!
+         * \fn  void MappedFile::close()
+         *
+         * \brief   Unmaps the file
+         */
+        void close()
+        {
+#ifdef _WIN32
+            if (_data != nullptr)
+                UnmapViewOfFile(_data);
+            if (_mapping != nullptr)
+                CloseHandle(_mapping);
+            if (_file != INVALID_HANDLE_VALUE)
+                CloseHandle(_file);
+            _mapping = nullptr;
+            _file    = INVALID_HANDLE_VALUE;
+#else
+            if (_data != nullptr)
+                munmap(const_cast<unsigned char*>(_data), _size);
+#endif
+            _data = nullptr;
+            _size = 0;
+            _open = false;
+        }
+
+        /*!
+         * \fn  bool MappedFile::isOpen() const
+         *
+         * \brief   Query if a file is mapped
+         *
+         * \returns True if a file is mapped, also an empty one.
+         */
+        bool isOpen() const
+        {
+            return _open;
+        }
+
+        /*!
+         * \fn  const unsigned char* MappedFile::data() const
+         *
+         * \brief   Gets the content of the file
+         *
+         * \returns The first byte, nullptr if the file is empty or not open.
+         */
+        const unsigned char* data() const
+        {
+            return _data;
+        }
+
+        /*!
+         * \fn  size_t MappedFile::size() const
+         *
+         * \brief   Gets the size of the file
+         *
+         * \returns The size in bytes.
+         */
+        size_t size() const
+        {
+            return _size;
+        }
+
+    private:
+
+        void swap(MappedFile& other) noexcept
+        {
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+            std::swap(_open, other._open);
+#ifdef _WIN32
+            std::swap(_file, other._file);
+            std::swap(_mapping, other._mapping);
+#endif
+        }
+
+        const unsigned char* _data{};
+        size_t               _size{};
+        bool                 _open{};
+#ifdef _WIN32
+        HANDLE _file{INVALID_HANDLE_VALUE};
+        HANDLE _mapping{};
+#endif
+    };
+}
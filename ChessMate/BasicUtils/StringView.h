@@ -0,0 +1,204 @@
+/*!
+* \brief:  Declares the string view class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace ChessNS
+{
+    /*!
+     * \class   StringView
+     *
+     * \brief   A read only view of characters owned by someone else, e.g. a mapped file. Copying and shortening it
+     *          never allocates, so it is the token type of the parsers. It works like std::string_view, which is
+     *          not available with C++14.
+     */
+    class StringView
+    {
+    public:
+
+        /*! \brief   The position which means not found or until the end */
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        StringView() = default;
+
+        /*!
+         * \fn  StringView::StringView(const char* data, size_t size)
+         *
+         * \brief   Constructor
+         *
+         * \param   data    The first character.
+         * \param   size    The number of characters.
+         */
+        StringView(const char* data, size_t size)
+            : _data(data),
+              _size(size) { }
+
+        /*!
+         * \fn  StringView::StringView(const char* text)
+         *
+         * \brief   Constructor for a zero terminated string
+         *
+         * \param   text    The text.
+         */
+        StringView(const char* text)
+            : _data(text),
+              _size(std::strlen(text)) { }
+
+        /*!
+         * \fn  StringView::StringView(const std::string& text)
+         *
+         * \brief   Constructor, the string has to live longer than the view
+         *
+         * \param   text    The text.
+         */
+        StringView(const std::string& text)
+            : _data(text.data()),
+              _size(text.size()) { }
+
+        const char* data() const { return _data; }
+
+        size_t size() const { return _size; }
+
+        size_t length() const { return _size; }
+
+        bool empty() const { return _size == 0; }
+
+        const char* begin() const { return _data; }
+
+        const char* end() const { return _data + _size; }
+
+        char operator[](size_t index) const { return _data[index]; }
+
+        char front() const { return _data[0]; }
+
+        char back() const { return _data[_size - 1]; }
+
+        /*!
+         * \fn  char StringView::at(size_t index) const
+         *
+         * \brief   Gets a character with a range check
+         *
+         * \param   index   The index.
+         *
+         * \returns The character, throws std::out_of_range behind the end.
+         */
+        char at(size_t index) const
+        {
+            if (index >= _size)
+                throw std::out_of_range("StringView::at");
+            return _data[index];
+        }
+
+        /*!
+         * \fn  StringView StringView::substr(size_t position, size_t count = npos) const
+         *
+         * \brief   Gets a part of the view
+         *
+         * \param   position    The first character, it is limited to the size.
+         * \param   count       (Optional) The number of characters, it is limited to the rest.
+         *
+         * \returns The part.
+         */
+        StringView substr(size_t position, size_t count = npos) const
+        {
+            position = std::min(position, _size);
+            return StringView(_data + position, std::min(count, _size - position));
+        }
+
+        void removePrefix(size_t count)
+        {
+            count = std::min(count, _size);
+            _data += count;
+            _size -= count;
+        }
+
+        void removeSuffix(size_t count)
+        {
+            _size -= std::min(count, _size);
+        }
+
+        /*!
+         * \fn  size_t StringView::find(char c, size_t position = 0) const
+         *
+         * \brief   Searches a character
+         *
+         * \param   c           The character.
+         * \param   position    (Optional) The first position to look at.
+         *
+         * \returns The position of the character, npos if it is not found.
+         */
+        size_t find(char c, size_t position = 0) const
+        {
+            if (position >= _size)
+                return npos;
+
+            const auto found = static_cast<const char*>(std::memchr(_data + position, c, _size - position));
+            return found ? static_cast<size_t>(found - _data) : npos;
+        }
+
+        bool startsWith(StringView prefix) const
+        {
+            return prefix._size <= _size && std::memcmp(_data, prefix._data, prefix._size) == 0;
+        }
+
+        bool endsWith(StringView suffix) const
+        {
+            return suffix._size <= _size && std::memcmp(_data + _size - suffix._size, suffix._data, suffix._size) == 0;
+        }
+
+        std::string toString() const
+        {
+            return std::string(_data, _size);
+        }
+
+        int compare(StringView other) const
+        {
+            const auto result = std::memcmp(_data, other._data, std::min(_size, other._size));
+            if (result != 0)
+                return result;
+            return _size < other._size ? -1 : _size > other._size ? 1 : 0;
+        }
+
+        friend bool operator==(StringView a, StringView b) { return a._size == b._size && a.compare(b) == 0; }
+
+        friend bool operator!=(StringView a, StringView b) { return !(a == b); }
+
+        friend bool operator<(StringView a, StringView b) { return a.compare(b) < 0; }
+
+        friend std::ostream& operator<<(std::ostream& out, StringView view) { return out.write(view._data, static_cast<std::streamsize>(view._size)); }
+
+    private:
+        const char* _data{""};
+        size_t      _size{};
+    };
+}
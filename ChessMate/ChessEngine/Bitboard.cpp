@@ -0,0 +1,131 @@
+/*!
+* \brief:  Implements the attack tables
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "Bitboard.h"
+
+namespace ChessNS
+{
+    struct Tables
+    {
+        Tables()
+        {
+            const int knightSteps[8][2] = {{2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+            const int kingSteps[8][2]   = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+
+            for (int square = 0; square < 64; square++)
+            {
+                const auto row    = square / 8;
+                const auto column = square % 8;
+
+                for (int i = 0; i < 8; i++)
+                {
+                    knights[square] |= step(row + knightSteps[i][0], column + knightSteps[i][1]);
+                    kings[square] |= step(row + kingSteps[i][0], column + kingSteps[i][1]);
+
+                    // the king steps are also the ray directions
+                    for (int r = row + kingSteps[i][0], c = column + kingSteps[i][1]; r >= 0 && r < 8 && c >= 0 && c < 8;
+                         r += kingSteps[i][0], c += kingSteps[i][1])
+                        rays[i][square] |= step(r, c);
+                }
+
+                pawns[0][square] = step(row + 1, column - 1) | step(row + 1, column + 1);
+                pawns[1][square] = step(row - 1, column - 1) | step(row - 1, column + 1);
+            }
+        }
+
+        static Bitboard step(int row, int column)
+        {
+            if (row < 0 || row > 7 || column < 0 || column > 7)
+                return 0;
+            return BitboardHelper::bit(row * 8 + column);
+        }
+
+        Bitboard pawns[2][64]{};
+        Bitboard knights[64]{};
+        Bitboard kings[64]{};
+        Bitboard rays[8][64]{};
+    };
+
+    static const Tables tables;
+
+    // Directions in the order of the king steps, the first three and the last one go to higher squares
+    static const bool increasing[8] = {true, true, true, false, false, false, false, true};
+
+    Bitboard AttackTables::pawnAttacks(Color color, int square)
+    {
+        return tables.pawns[color == Color::white ? 0 : 1][square];
+    }
+
+    Bitboard AttackTables::knightAttacks(int square)
+    {
+        return tables.knights[square];
+    }
+
+    Bitboard AttackTables::kingAttacks(int square)
+    {
+        return tables.kings[square];
+    }
+
+    Bitboard AttackTables::bishopAttacks(int square, Bitboard occupied)
+    {
+        return rayAttacks(1, square, occupied) | rayAttacks(3, square, occupied)
+            | rayAttacks(5, square, occupied) | rayAttacks(7, square, occupied);
+    }
+
+    Bitboard AttackTables::rookAttacks(int square, Bitboard occupied)
+    {
+        return rayAttacks(0, square, occupied) | rayAttacks(2, square, occupied)
+            | rayAttacks(4, square, occupied) | rayAttacks(6, square, occupied);
+    }
+
+    Bitboard AttackTables::attacks(FigureType type, Color color, int square, Bitboard occupied)
+    {
+        switch (type)
+        {
+            case FigureType::pawn: return pawnAttacks(color, square);
+            case FigureType::knight: return knightAttacks(square);
+            case FigureType::bishop: return bishopAttacks(square, occupied);
+            case FigureType::rook: return rookAttacks(square, occupied);
+            case FigureType::queen: return bishopAttacks(square, occupied) | rookAttacks(square, occupied);
+            case FigureType::king: return kingAttacks(square);
+            default: return 0;
+        }
+    }
+
+    Bitboard AttackTables::rayAttacks(int direction, int square, Bitboard occupied)
+    {
+        auto       attacks  = tables.rays[direction][square];
+        const auto blockers = attacks & occupied;
+
+        if (blockers != 0)
+        {
+            const auto first = increasing[direction] ? BitboardHelper::lsb(blockers) : BitboardHelper::msb(blockers);
+            attacks ^= tables.rays[direction][first];
+        }
+
+        return attacks;
+    }
+}
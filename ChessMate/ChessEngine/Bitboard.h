@@ -0,0 +1,255 @@
+/*!
+* \brief:  Declares the bitboard helpers and attack tables
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include "ChessTypes.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ChessNS
+{
+    /*!
+     * \typedef uint64_t Bitboard
+     *
+     * \brief   A set of fields, bit 0 is a1, bit 7 is h1 and bit 63 is h8.
+     */
+    typedef uint64_t Bitboard;
+
+    /*!
+     * \class   BitboardHelper
+     *
+     * \brief   A helper class for bitboards.
+     */
+    class BitboardHelper
+    {
+    public:
+
+        /*!
+         * \fn  static int BitboardHelper::square(const Position& position)
+         *
+         * \brief   Gets the square index (0 to 63) of a position
+         *
+         * \param   position    The position.
+         *
+         * \returns The square index.
+         */
+        static int square(const Position& position)
+        {
+            return static_cast<int>(position.row) * 8 + static_cast<int>(position.column);
+        }
+
+        /*!
+         * \fn  static Position BitboardHelper::position(int square)
+         *
+         * \brief   Gets the position of a square index
+         *
+         * \param   square  The square index.
+         *
+         * \returns The position.
+         */
+        static Position position(int square)
+        {
+            return Position(square / 8, square % 8);
+        }
+
+        /*!
+         * \fn  static Bitboard BitboardHelper::bit(int square)
+         *
+         * \brief   Gets a bitboard with only the given square set
+         *
+         * \param   square  The square index.
+         *
+         * \returns The bitboard.
+         */
+        static Bitboard bit(int square)
+        {
+            return Bitboard(1) << square;
+        }
+
+        /*!
+         * \fn  static int BitboardHelper::lsb(Bitboard bitboard)
+         *
+         * \brief   Gets the lowest set square, the bitboard must not be empty
+         *
+         * \param   bitboard    The bitboard.
+         *
+         * \returns The square index.
+         */
+        static int lsb(Bitboard bitboard)
+        {
+            #if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, bitboard);
+            return static_cast<int>(index);
+            #else
+            return __builtin_ctzll(bitboard);
+            #endif
+        }
+
+        /*!
+         * \fn  static int BitboardHelper::msb(Bitboard bitboard)
+         *
+         * \brief   Gets the highest set square, the bitboard must not be empty
+         *
+         * \param   bitboard    The bitboard.
+         *
+         * \returns The square index.
+         */
+        static int msb(Bitboard bitboard)
+        {
+            #if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse64(&index, bitboard);
+            return static_cast<int>(index);
+            #else
+            return 63 - __builtin_clzll(bitboard);
+            #endif
+        }
+
+        /*!
+         * \fn  static int BitboardHelper::popLsb(Bitboard& bitboard)
+         *
+         * \brief   Removes the lowest set square, the bitboard must not be empty
+         *
+         * \param [in,out]  bitboard    The bitboard.
+         *
+         * \returns The removed square index.
+         */
+        static int popLsb(Bitboard& bitboard)
+        {
+            const auto square = lsb(bitboard);
+            bitboard &= bitboard - 1;
+            return square;
+        }
+
+        /*!
+         * \fn  static int BitboardHelper::count(Bitboard bitboard)
+         *
+         * \brief   Counts the set squares
+         *
+         * \param   bitboard    The bitboard.
+         *
+         * \returns The number of set squares.
+         */
+        static int count(Bitboard bitboard)
+        {
+            #if defined(_MSC_VER)
+            return static_cast<int>(__popcnt64(bitboard));
+            #else
+            return __builtin_popcountll(bitboard);
+            #endif
+        }
+    };
+
+    /*!
+     * \class   AttackTables
+     *
+     * \brief   Precomputed attacks of all figure types.
+     */
+    class AttackTables
+    {
+    public:
+
+        /*!
+         * \fn  static Bitboard AttackTables::pawnAttacks(Color color, int square);
+         *
+         * \brief   Gets the fields a pawn of a color attacks
+         *
+         * \param   color   The color of the pawn.
+         * \param   square  The square of the pawn.
+         *
+         * \returns The attacked fields.
+         */
+        static Bitboard pawnAttacks(Color color, int square);
+
+        /*!
+         * \fn  static Bitboard AttackTables::knightAttacks(int square);
+         *
+         * \brief   Gets the fields a knight attacks
+         *
+         * \param   square  The square of the knight.
+         *
+         * \returns The attacked fields.
+         */
+        static Bitboard knightAttacks(int square);
+
+        /*!
+         * \fn  static Bitboard AttackTables::kingAttacks(int square);
+         *
+         * \brief   Gets the fields a king attacks
+         *
+         * \param   square  The square of the king.
+         *
+         * \returns The attacked fields.
+         */
+        static Bitboard kingAttacks(int square);
+
+        /*!
+         * \fn  static Bitboard AttackTables::bishopAttacks(int square, Bitboard occupied);
+         *
+         * \brief   Gets the fields a bishop attacks, including the first occupied field in each direction
+         *
+         * \param   square      The square of the bishop.
+         * \param   occupied    All occupied fields.
+         *
+         * \returns The attacked fields.
+         */
+        static Bitboard bishopAttacks(int square, Bitboard occupied);
+
+        /*!
+         * \fn  static Bitboard AttackTables::rookAttacks(int square, Bitboard occupied);
+         *
+         * \brief   Gets the fields a rook attacks, including the first occupied field in each direction
+         *
+         * \param   square      The square of the rook.
+         * \param   occupied    All occupied fields.
+         *
+         * \returns The attacked fields.
+         */
+        static Bitboard rookAttacks(int square, Bitboard occupied);
+
+        /*!
+         * \fn  static Bitboard AttackTables::attacks(FigureType type, Color color, int square, Bitboard occupied);
+         *
+         * \brief   Gets the fields a figure attacks
+         *
+         * \param   type        The type of the figure.
+         * \param   color       The color of the figure.
+         * \param   square      The square of the figure.
+         * \param   occupied    All occupied fields.
+         *
+         * \returns The attacked fields.
+         */
+        static Bitboard attacks(FigureType type, Color color, int square, Bitboard occupied);
+
+    private:
+
+        static Bitboard rayAttacks(int direction, int square, Bitboard occupied);
+    };
+}
@@ -25,6 +25,9 @@
  */
 
 #include "Board.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <utility>
 
 namespace ChessNS
@@ -149,62 +152,375 @@ namespace ChessNS
 
     bool Board::changeFigureType(const Position& position, FigureType figure)
     {
-        if (at(position).empty)
+        auto& field = at(position);
+        if (field.empty)
             return false;
 
-        at(position).figure.setType(figure);
+        const auto square = BitboardHelper::square(position);
+        const auto color  = static_cast<size_t>(field.figure.getColor());
+        _figures[color][static_cast<size_t>(field.figure.getType())] &= ~BitboardHelper::bit(square);
+        _figures[color][static_cast<size_t>(figure)] |= BitboardHelper::bit(square);
+        _hash ^= Zobrist::figure(field.figure.getColor(), field.figure.getType(), square)
+            ^ Zobrist::figure(field.figure.getColor(), figure, square);
+        updateEval(field.figure.getColor(), field.figure.getType(), square, -1);
+        updateEval(field.figure.getColor(), figure, square, 1);
+        updateNetwork(field.figure.getColor(), field.figure.getType(), square, -1);
+        updateNetwork(field.figure.getColor(), figure, square, 1);
+
+        if (field.figure.getType() == FigureType::pawn)
+            _pawnHash ^= Zobrist::figure(field.figure.getColor(), FigureType::pawn, square);
+        if (figure == FigureType::pawn)
+            _pawnHash ^= Zobrist::figure(field.figure.getColor(), FigureType::pawn, square);
+
+        field.figure.setType(figure);
         return true;
     }
 
+    void Board::placeFigure(const Position& position, const Figure& figure)
+    {
+        removeFigure(position);
+
+        auto&      field  = at(position);
+        const auto square = BitboardHelper::bit(BitboardHelper::square(position));
+        const auto color  = static_cast<size_t>(figure.getColor());
+
+        field.figure = figure;
+        field.empty  = false;
+        _figures[color][static_cast<size_t>(figure.getType())] |= square;
+        _colors[color] |= square;
+        _hash ^= Zobrist::figure(figure.getColor(), figure.getType(), BitboardHelper::square(position));
+        updateEval(figure.getColor(), figure.getType(), BitboardHelper::square(position), 1);
+        updateNetwork(figure.getColor(), figure.getType(), BitboardHelper::square(position), 1);
+        if (figure.getType() == FigureType::pawn)
+            _pawnHash ^= Zobrist::figure(figure.getColor(), FigureType::pawn, BitboardHelper::square(position));
+    }
+
+    void Board::removeFigure(const Position& position)
+    {
+        auto& field = at(position);
+        if (!field.empty)
+        {
+            const auto square = ~BitboardHelper::bit(BitboardHelper::square(position));
+            const auto color  = static_cast<size_t>(field.figure.getColor());
+
+            _figures[color][static_cast<size_t>(field.figure.getType())] &= square;
+            _colors[color] &= square;
+            _hash ^= Zobrist::figure(field.figure.getColor(), field.figure.getType(), BitboardHelper::square(position));
+            updateEval(field.figure.getColor(), field.figure.getType(), BitboardHelper::square(position), -1);
+            updateNetwork(field.figure.getColor(), field.figure.getType(), BitboardHelper::square(position), -1);
+            if (field.figure.getType() == FigureType::pawn)
+                _pawnHash ^= Zobrist::figure(field.figure.getColor(), FigureType::pawn, BitboardHelper::square(position));
+        }
+
+        field.figure = Figure();
+        field.empty  = true;
+    }
+
+    Bitboard Board::getFigures(Color color, FigureType figureType) const
+    {
+        return _figures[static_cast<size_t>(color)][static_cast<size_t>(figureType)];
+    }
+
+    Bitboard Board::getOccupied(Color color) const
+    {
+        if (color == Color::none)
+            return _colors[static_cast<size_t>(Color::white)] | _colors[static_cast<size_t>(Color::black)];
+
+        return _colors[static_cast<size_t>(color)];
+    }
+
+    Bitboard Board::getAttackers(const Position& position, Color byColor) const
+    {
+        return attackersTo(BitboardHelper::square(position), getOccupied()) & getOccupied(byColor);
+    }
+
+    int Board::see(const Position& origin, const Position& destination) const
+    {
+        const auto from      = BitboardHelper::square(origin);
+        const auto to        = BitboardHelper::square(destination);
+        const auto moverType = getFigureType(from);
+
+        if (moverType == FigureType::none)
+            return 0;
+
+        auto occupied = getOccupied() ^ BitboardHelper::bit(from);
+        auto side     = (getOccupied(Color::white) & BitboardHelper::bit(from)) != 0 ? Color::black : Color::white;
+        auto onTarget = ChessTypes::getFigureValue(moverType);
+
+        int swapList[32];
+        swapList[0] = ChessTypes::getFigureValue(getFigureType(to));
+
+        if (moverType == FigureType::pawn)
+        {
+            // en passant
+            if (origin.column != destination.column && getFigureType(to) == FigureType::none)
+            {
+                swapList[0] = ChessTypes::getFigureValue(FigureType::pawn);
+                occupied ^= BitboardHelper::bit(BitboardHelper::square(Position(origin.row, destination.column)));
+            }
+
+            if (destination.row == BoardRow::r1 || destination.row == BoardRow::r8)
+            {
+                swapList[0] += ChessTypes::getFigureValue(FigureType::queen) - ChessTypes::getFigureValue(FigureType::pawn);
+                onTarget = ChessTypes::getFigureValue(FigureType::queen);
+            }
+        }
+
+        const auto diagonal = getFigures(Color::white, FigureType::bishop) | getFigures(Color::black, FigureType::bishop)
+            | getFigures(Color::white, FigureType::queen) | getFigures(Color::black, FigureType::queen);
+        const auto straight = getFigures(Color::white, FigureType::rook) | getFigures(Color::black, FigureType::rook)
+            | getFigures(Color::white, FigureType::queen) | getFigures(Color::black, FigureType::queen);
+
+        const FigureType order[] = {FigureType::pawn, FigureType::knight, FigureType::bishop, FigureType::rook, FigureType::queen, FigureType::king};
+
+        auto attackers = attackersTo(to, occupied) & occupied;
+        int  n         = 1;
+
+        for (; n < 32; n++)
+        {
+            const auto own = attackers & getOccupied(side);
+            if (own == 0)
+                break;
+
+            // the least valuable attacker captures next
+            auto     type       = FigureType::none;
+            Bitboard candidates = 0;
+            for (auto t : order)
+            {
+                candidates = own & getFigures(side, t);
+                if (candidates != 0)
+                {
+                    type = t;
+                    break;
+                }
+            }
+
+            const auto opponent = ChessTypes::getOpponent(side);
+            if (type == FigureType::king && (attackers & getOccupied(opponent)) != 0)
+                break;
+
+            swapList[n] = onTarget - swapList[n - 1];
+            onTarget    = ChessTypes::getFigureValue(type);
+
+            // removing the attacker may uncover a slider behind it
+            occupied ^= BitboardHelper::bit(BitboardHelper::lsb(candidates));
+            attackers |= (AttackTables::bishopAttacks(to, occupied) & diagonal) | (AttackTables::rookAttacks(to, occupied) & straight);
+            attackers &= occupied;
+            side = opponent;
+        }
+
+        while (--n)
+            swapList[n - 1] = std::min(swapList[n - 1], -swapList[n]);
+
+        return swapList[0];
+    }
+
+    int Board::see(Movement& movement) const
+    {
+        return see(movement.origin(), movement.destination());
+    }
+
     Movement Board::move(Movement movement)
     {
         if (movement.origin().isValid())
             return move(movement.origin(), movement.destination());
 
         // estimate origin
-        const auto fields = getAllOccupiedFields(movement.color());
-        auto       result = Movement::invalid();
+        if (movement.color() != _currentColorTurn || resolve(movement) != ResolveResult::unique)
+            return Movement::invalid();
 
-        for (auto* f : fields)
+        auto result = makeMove(movement.origin(), movement.destination(), movement.promotedTo());
+        if (!result.isValid() || hasLegalMove())
+            return result;
+
+        // the opponent can not move, it is checkmate or stalemate
+        if (result.hasFlag(EventFlag::check))
         {
-            if (f->figure.getType() != movement.figureType())
-                continue;
+            result.removeFlag(EventFlag::check);
+            result.addFlag(EventFlag::checkmate);
+            _movements.back() = result;
+        }
+
+        _ended = true;
+        return result;
+    }
 
-            if (f->figure.move(movement.destination(), this, false).isValid())
+    ResolveResult Board::resolve(Movement& movement)
+    {
+        const auto color       = _currentColorTurn;
+        const auto opponent    = ChessTypes::getOpponent(color);
+        const auto destination = movement.destination();
+        if (_ended || !destination.isValid())
+            return ResolveResult::illegal;
+
+        const auto to       = BitboardHelper::square(destination);
+        const auto occupied = getOccupied();
+        if ((getOccupied(color) & BitboardHelper::bit(to)) != 0)
+            return ResolveResult::illegal;
+
+        // castling has more rules than attacks, it is rare enough for the figure to check it
+        const auto type  = movement.figureType();
+        const auto kings = getFigures(color, FigureType::king);
+        const auto king  = kings != 0 ? BitboardHelper::lsb(kings) : -1;
+        if (movement.hasFlag(EventFlag::castling)
+            || (type == FigureType::king && king / 8 == to / 8 && (king % 8 - to % 8 == 2 || to % 8 - king % 8 == 2)))
+        {
+            if (kings == 0)
+                return ResolveResult::illegal;
+
+            const auto origin = BitboardHelper::position(king);
+            if (!at(origin).figure.move(destination, this, false).isValid())
+                return ResolveResult::illegal;
+
+            movement.origin() = origin;
+            return ResolveResult::unique;
+        }
+
+        Bitboard candidates = 0;
+        Bitboard enPassant  = 0;
+        if (type == FigureType::pawn)
+        {
+            const auto pawns     = getFigures(color, FigureType::pawn);
+            const auto direction = color == Color::white ? 8 : -8;
+            if ((occupied & BitboardHelper::bit(to)) == 0)
             {
-                const auto rc = movement.origin().getCord();
-                if ((rc.first == -1 && rc.second == -1)
-                    || (rc.first != -1 && f->position.getCord().first == rc.first)
-                    || (rc.second != -1 && f->position.getCord().second == rc.second))
+                // a step or a double step from the start row
+                const auto from      = to - direction;
+                const auto doubleRow = color == Color::white ? 3 : 4;
+                if (from >= 0 && from < 64)
                 {
-                    result = move(f->position, movement.destination());
-                    break;
+                    if ((pawns & BitboardHelper::bit(from)) != 0)
+                        candidates |= BitboardHelper::bit(from);
+                    else if ((occupied & BitboardHelper::bit(from)) == 0 && to / 8 == doubleRow)
+                        candidates |= pawns & BitboardHelper::bit(from - direction);
+                }
+
+                // en passant
+                const auto captureRow = color == Color::white ? 5 : 2;
+                if (to / 8 == captureRow && getEnPassantColumn() == to % 8)
+                {
+                    candidates |= AttackTables::pawnAttacks(opponent, to) & pawns;
+                    enPassant = BitboardHelper::bit(to - direction);
                 }
             }
+            else
+                candidates = AttackTables::pawnAttacks(opponent, to) & pawns;
         }
+        else if (type != FigureType::none)
+            candidates = AttackTables::attacks(type, color, to, occupied) & getFigures(color, type);
 
-        if (movement.promotedTo() != FigureType::none)
+        const auto hint   = movement.origin().getCord();
+        auto       result = ResolveResult::illegal;
+        while (candidates != 0)
         {
-            changeFigureType(movement.destination(), movement.promotedTo());
+            const auto from   = BitboardHelper::popLsb(candidates);
+            const auto origin = BitboardHelper::position(from);
+            const auto cord   = origin.getCord();
+            if ((hint.first >= 0 && hint.first != cord.first) || (hint.second >= 0 && hint.second != cord.second))
+                continue;
 
-            result.removeFlag(EventFlag::checkmate);
-            result.removeFlag(EventFlag::check);
+            // an en passant capture comes from the side, a step never does
+            if (!leavesKingSafe(color, from, to, from % 8 != to % 8 ? enPassant : 0))
+                continue;
 
-            const auto opponentColor = ChessTypes::getOpponent(movement.color());
-            const auto vic           = checkVictory(opponentColor);
+            if (result == ResolveResult::unique)
+                return ResolveResult::ambiguous;
 
-            if (vic == GameResult::victoryBlack || vic == GameResult::victoryWhite)
-                result.addFlag(EventFlag::checkmate);
+            movement.origin() = origin;
+            result            = ResolveResult::unique;
+        }
 
-            if (!_ended && isCheck(opponentColor))
-                result.addFlag(EventFlag::check);
+        return result;
+    }
 
-            _movements.back() = result;
+    Movement Board::makeMove(Position origin, Position destination, FigureType promotedTo)
+    {
+        if (_ended || !origin.isValid() || !destination.isValid() || origin == destination)
+            return Movement::invalid();
+
+        auto& figure = at(origin).figure;
+        if (figure.getColor() == Color::none || !figure.move(destination, this, false).isValid())
+            return Movement::invalid();
+
+        return executeMove(origin, destination, promotedTo, true);
+    }
+
+    Movement Board::makeLegalMove(Position origin, Position destination, FigureType promotedTo)
+    {
+        return executeMove(origin, destination, promotedTo, false);
+    }
+
+    Movement Board::executeMove(Position origin, Position destination, FigureType promotedTo, bool checkKing)
+    {
+        auto&      figure       = at(origin).figure;
+        const auto currentColor = figure.getColor();
+
+        MoveRecord record;
+        record.currentMove                  = _currentMove;
+        record.currentColorTurn             = _currentColorTurn;
+        record.fields[record.nbrOfFields++] = at(origin);
+        record.fields[record.nbrOfFields++] = at(destination);
+
+        // en passant and castling touch a third and a fourth field
+        const auto distance = (destination - origin).getCord();
+        if (figure.getType() == FigureType::pawn && distance.second != 0 && at(destination).empty)
+            record.fields[record.nbrOfFields++] = at(origin.row, destination.column);
+
+        else if (figure.getType() == FigureType::king && std::abs(distance.second) == 2)
+        {
+            record.fields[record.nbrOfFields++] = at(origin.row, distance.second > 0 ? BoardColumn::cH : BoardColumn::cA);
+            record.fields[record.nbrOfFields++] = at(origin.row, distance.second > 0 ? BoardColumn::cF : BoardColumn::cD);
         }
 
+        auto result = figure.move(destination, this, true);
+        if (!result.isValid() || (checkKing && isCheck(currentColor)))
+        {
+            restore(record);
+            return Movement::invalid();
+        }
+
+        if (promotedTo != FigureType::none && result.hasFlag(EventFlag::promotion))
+        {
+            changeFigureType(destination, promotedTo);
+            result.promotedTo() = promotedTo;
+        }
+
+        const auto opponentColor = ChessTypes::getOpponent(currentColor);
+        if (isCheck(opponentColor))
+            result.addFlag(EventFlag::check);
+
+        result.round()    = _currentMove / 2 + 1;
+        result.origin()   = origin;
+        _currentColorTurn = opponentColor;
+
+        ++_currentMove;
+        _movements.emplace_back(result);
+        _moveRecords.emplace_back(record);
         return result;
     }
 
+    void Board::makeNullMove()
+    {
+        MoveRecord record;
+        record.currentMove      = _currentMove;
+        record.currentColorTurn = _currentColorTurn;
+
+        _currentColorTurn = ChessTypes::getOpponent(_currentColorTurn);
+        ++_currentMove;
+        _movements.emplace_back(Movement::invalid());
+        _moveRecords.emplace_back(record);
+    }
+
+    void Board::unmakeMove()
+    {
+        if (_moveRecords.empty())
+            return;
+
+        restore(_moveRecords.back());
+        _moveRecords.pop_back();
+        _movements.pop_back();
+    }
+
     bool Board::isCheck(Color color)
     {
         auto* kingField = getFigure(color, FigureType::king);
@@ -254,9 +570,12 @@ namespace ChessNS
 
         for (auto& field : *this)
         {
-            auto res = allowed(origin, field.position, false);
+            auto res = makeMove(origin, field.position);
             if (res.isValid())
+            {
+                unmakeMove();
                 result.emplace_back(res);
+            }
         }
 
         return result;
@@ -274,6 +593,101 @@ namespace ChessNS
         return result;
     }
 
+    std::vector<Movement> Board::getAllPossibleCaptures(Color ofColor)
+    {
+        std::vector<Movement> result;
+        const auto            fields    = getAllOccupiedFields(ofColor);
+        const auto            targets   = getAllOccupiedFields(ChessTypes::getOpponent(ofColor));
+        const auto            direction = ofColor == Color::white ? 1 : -1;
+        const auto            lastRow   = ofColor == Color::white ? BoardRow::r8 : BoardRow::r1;
+
+        for (auto* field : fields)
+        {
+            const auto origin = field->position;
+            const auto isPawn = field->figure.getType() == FigureType::pawn;
+
+            for (auto* target : targets)
+            {
+                auto res = makeMove(origin, target->position);
+                if (res.isValid())
+                {
+                    unmakeMove();
+                    result.emplace_back(res);
+                }
+            }
+
+            if (!isPawn)
+                continue;
+
+            // en passant and promotions are the only ones to an empty field
+            for (int column = -1; column <= 1; column++)
+            {
+                const auto destination = origin + Position(direction, column);
+                if (!destination.isValid() || !at(destination).empty)
+                    continue;
+
+                if (column == 0 && destination.row != lastRow)
+                    continue;
+
+                auto res = makeMove(origin, destination);
+                if (res.isValid())
+                {
+                    unmakeMove();
+                    result.emplace_back(res);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<Movement> Board::getAllPossibleQuietMoves(Color ofColor)
+    {
+        std::vector<Movement> result;
+        const auto            occupied  = getOccupied();
+        const auto            direction = ofColor == Color::white ? 8 : -8;
+
+        for (auto* field : getAllOccupiedFields(ofColor))
+        {
+            const auto origin = field->position;
+            const auto square = BitboardHelper::square(origin);
+            const auto type   = field->figure.getType();
+            Bitboard   targets;
+
+            if (type == FigureType::pawn)
+            {
+                // promotions are generated with the captures
+                const auto startRow = ofColor == Color::white ? BoardRow::r2 : BoardRow::r7;
+                const auto lastRow  = ofColor == Color::white ? BoardRow::r8 : BoardRow::r1;
+
+                targets = 0;
+                if ((origin + Position(direction / 8, 0)).row != lastRow)
+                    targets |= BitboardHelper::bit(square + direction);
+                if (origin.row == startRow)
+                    targets |= BitboardHelper::bit(square + 2 * direction);
+            }
+            else
+            {
+                targets = AttackTables::attacks(type, ofColor, square, occupied);
+                if (type == FigureType::king && origin.column == BoardColumn::cE)
+                    targets |= BitboardHelper::bit(square - 2) | BitboardHelper::bit(square + 2);
+            }
+
+            targets &= ~occupied;
+            while (targets != 0)
+            {
+                auto res = makeMove(origin, BitboardHelper::position(BitboardHelper::popLsb(targets)));
+                if (res.isValid())
+                {
+                    unmakeMove();
+                    result.emplace_back(res);
+                }
+            }
+        }
+
+        return result;
+    }
+
     std::vector<Movement> Board::getAllMadeMoves() const
     {
         return _movements;
@@ -286,49 +700,365 @@ namespace ChessNS
 
     bool Board::isFieldUnderAttack(Field& field, Color byColor)
     {
-        const auto fields = getAllOccupiedFields(byColor);
+        return getAttackers(field.position, byColor) != 0;
+    }
+
+    Color Board::getCurrentColorTurn() const
+    {
+        return _currentColorTurn;
+    }
+
+    uint64_t Board::getPawnHash() const
+    {
+        return _pawnHash;
+    }
+
+    int Board::getPhase() const
+    {
+        return std::max(0, std::min(_phase, _evalParams->fullPhase()));
+    }
+
+    int Board::evaluate() const
+    {
+        const auto fullPhase = _evalParams->fullPhase();
+        const auto phase     = getPhase();
+        const auto score     = fullPhase == 0 ? _score[1] : (_score[0] * phase + _score[1] * (fullPhase - phase)) / fullPhase;
+
+        return _currentColorTurn == Color::black ? -score : score;
+    }
 
-        for (auto* f : fields)
+    int Board::evaluate(GamePhase phase) const
+    {
+        return _score[static_cast<size_t>(phase)];
+    }
+
+    void Board::setEvalParams(std::shared_ptr<const EvalParams> params)
+    {
+        // a counter and not the address, new parameters may be allocated where freed ones were
+        static std::atomic<uint32_t> generations{0};
+
+        _evalParams     = std::move(params);
+        _evalGeneration = ++generations;
+        _score[0]       = 0;
+        _score[1]       = 0;
+        _phase          = 0;
+
+        for (auto color : {Color::white, Color::black})
+            for (size_t type = 1; type < 7; type++)
+            {
+                auto figures = _figures[static_cast<size_t>(color)][type];
+                while (figures != 0)
+                    updateEval(color, static_cast<FigureType>(type), BitboardHelper::popLsb(figures), 1);
+            }
+    }
+
+    const EvalParams& Board::getEvalParams() const
+    {
+        return *_evalParams;
+    }
+
+    uint32_t Board::getEvalGeneration() const
+    {
+        return _evalGeneration;
+    }
+
+    void Board::setNetwork(std::shared_ptr<const Nnue> network)
+    {
+        _network = std::move(network);
+        for (size_t perspective = 0; perspective < 2; perspective++)
         {
-            auto res = f->figure.move(field.position, this, false);
-            if (res.moveResult() == MoveResult::valid)
-                return true;
+            _accumulators[perspective].assign(_network ? _network->accumulatorSize() : 0, 0);
+            _accumulatorValid[perspective] = false;
         }
+    }
 
-        return false;
+    const std::shared_ptr<const Nnue>& Board::getNetwork() const
+    {
+        return _network;
     }
 
-    Color Board::getCurrentColorTurn() const
+    int Board::evaluateNetwork()
     {
-        return _currentColorTurn;
+        if (!_network)
+            return 0;
+
+        for (auto perspective : {Color::white, Color::black})
+            if (!_accumulatorValid[static_cast<size_t>(perspective) - 1])
+                refreshAccumulator(perspective);
+
+        const auto own = _currentColorTurn == Color::black ? 1 : 0;
+        return _network->evaluate(_accumulators[own].data(), _accumulators[1 - own].data());
+    }
+
+    uint64_t Board::getHash()
+    {
+        auto hash = _hash;
+        if (_currentColorTurn == Color::black)
+            hash ^= Zobrist::side();
+
+        for (auto color : {Color::white, Color::black})
+            for (auto kingSide : {true, false})
+                if (hasCastlingRight(color, kingSide))
+                    hash ^= Zobrist::castling(color, kingSide);
+
+        const auto column = getEnPassantColumn();
+        if (column >= 0)
+            hash ^= Zobrist::enPassant(column);
+
+        return hash;
+    }
+
+    bool Board::hasCastlingRight(Color color, bool kingSide)
+    {
+        // castling is possible as long as the king and the rook have not moved
+        const auto  row  = color == Color::white ? BoardRow::r1 : BoardRow::r8;
+        const auto& king = at(row, BoardColumn::cE);
+        const auto& rook = at(row, kingSide ? BoardColumn::cH : BoardColumn::cA);
+
+        return !king.empty && king.figure.getType() == FigureType::king && king.figure.getColor() == color
+            && king.figure.nbrOfMovements() == 0 && !rook.empty && rook.figure.getType() == FigureType::rook
+            && rook.figure.getColor() == color && rook.figure.nbrOfMovements() == 0;
+    }
+
+    int Board::getEnPassantColumn()
+    {
+        // a pawn which made a double step with the last move can be captured en passant
+        const auto opponent = ChessTypes::getOpponent(_currentColorTurn);
+        Bitboard   pawns    = getFigures(opponent, FigureType::pawn)
+            & (opponent == Color::white ? 0x00000000FF000000ull : 0x000000FF00000000ull);
+
+        while (pawns != 0)
+        {
+            const auto  square = BitboardHelper::popLsb(pawns);
+            const auto& pawn   = at(BitboardHelper::position(square)).figure;
+            if (pawn.nbrOfMovements() == 1 && pawn.lastMoved() + 1 == _currentMove)
+                return square % 8;
+        }
+
+        return -1;
+    }
+
+    void Board::restore(const MoveRecord& record)
+    {
+        for (size_t i = 0; i < record.nbrOfFields; i++)
+        {
+            const auto& field = record.fields[i];
+            if (field.empty)
+                removeFigure(field.position);
+            else
+                placeFigure(field.position, field.figure);
+        }
+
+        _currentMove      = record.currentMove;
+        _currentColorTurn = record.currentColorTurn;
     }
 
     void Board::createFigure(Field& field, FigureType figure, Color color)
     {
-        field.figure = Figure(figure, color, field.position);
-        field.empty  = false;
+        placeFigure(field.position, Figure(figure, color, field.position));
     }
 
-    std::vector<Field*> Board::getAllOccupiedFields(Color ofColor)
+    Bitboard Board::attackersTo(int square, Bitboard occupied) const
     {
-        std::vector<Field*> result;
-        for (auto& field : *this)
+        const auto queens = getFigures(Color::white, FigureType::queen) | getFigures(Color::black, FigureType::queen);
+
+        return (AttackTables::pawnAttacks(Color::white, square) & getFigures(Color::black, FigureType::pawn))
+            | (AttackTables::pawnAttacks(Color::black, square) & getFigures(Color::white, FigureType::pawn))
+            | (AttackTables::knightAttacks(square) & (getFigures(Color::white, FigureType::knight) | getFigures(Color::black, FigureType::knight)))
+            | (AttackTables::kingAttacks(square) & (getFigures(Color::white, FigureType::king) | getFigures(Color::black, FigureType::king)))
+            | (AttackTables::bishopAttacks(square, occupied)
+                & (getFigures(Color::white, FigureType::bishop) | getFigures(Color::black, FigureType::bishop) | queens))
+            | (AttackTables::rookAttacks(square, occupied)
+                & (getFigures(Color::white, FigureType::rook) | getFigures(Color::black, FigureType::rook) | queens));
+    }
+
+    template <typename Callback>
+    bool Board::forEachLegalMove(Callback&& callback)
+    {
+        const auto color     = _currentColorTurn;
+        const auto opponent  = ChessTypes::getOpponent(color);
+        const auto occupied  = getOccupied();
+        const auto enemies   = getOccupied(opponent);
+        const auto direction = color == Color::white ? 8 : -8;
+        const auto startRow  = color == Color::white ? 1 : 6;
+        const auto enPassant = getEnPassantColumn();
+
+        // the king first, it can move in most positions
+        const FigureType order[] = {FigureType::king, FigureType::queen, FigureType::rook, FigureType::bishop, FigureType::knight, FigureType::pawn};
+        for (auto type : order)
         {
-            if (field.figure.getColor() == ofColor)
-                result.push_back(&field);
+            auto figures = getFigures(color, type);
+            while (figures != 0)
+            {
+                const auto from = BitboardHelper::popLsb(figures);
+                Bitboard   targets;
+                if (type == FigureType::pawn)
+                {
+                    targets = AttackTables::pawnAttacks(color, from) & enemies;
+                    const auto step = from + direction;
+                    if ((occupied & BitboardHelper::bit(step)) == 0)
+                    {
+                        targets |= BitboardHelper::bit(step);
+                        if (from / 8 == startRow && (occupied & BitboardHelper::bit(step + direction)) == 0)
+                            targets |= BitboardHelper::bit(step + direction);
+                    }
+
+                    // en passant
+                    if (enPassant >= 0 && from / 8 == startRow + 3 * (direction / 8) && (from % 8 - enPassant == 1 || enPassant - from % 8 == 1)
+                        && leavesKingSafe(color, from, from + direction + enPassant - from % 8, BitboardHelper::bit(from + enPassant - from % 8)))
+                        targets |= BitboardHelper::bit(from + direction + enPassant - from % 8);
+                }
+                else
+                    targets = AttackTables::attacks(type, color, from, occupied) & ~getOccupied(color);
+
+                while (targets != 0)
+                {
+                    const auto to = BitboardHelper::popLsb(targets);
+                    if ((type == FigureType::pawn && to % 8 != from % 8 && (enemies & BitboardHelper::bit(to)) == 0)
+                        || leavesKingSafe(color, from, to, 0))
+                        if (callback(from, to))
+                            return true;
+                }
+
+                // castling has more rules than attacks, the figure checks them
+                if (type == FigureType::king)
+                    for (auto kingSide : {true, false})
+                        if (hasCastlingRight(color, kingSide))
+                        {
+                            const auto to = from + (kingSide ? 2 : -2);
+                            if (at(BitboardHelper::position(from)).figure.move(BitboardHelper::position(to), this, false).isValid() && callback(from, to))
+                                return true;
+                        }
+            }
         }
 
-        return result;
+        return false;
     }
 
-    Field* Board::getFigure(Color byColor, FigureType figureType)
+    bool Board::hasLegalMove()
     {
-        for (auto& field : *this)
+        return forEachLegalMove([](int, int) { return true; });
+    }
+
+    void Board::getLegalMoves(std::vector<uint16_t>& moves)
+    {
+        moves.clear();
+        forEachLegalMove([&moves](int from, int to)
+        {
+            moves.push_back(static_cast<uint16_t>(from | to << 6));
+            return false;
+        });
+    }
+
+    bool Board::leavesKingSafe(Color color, int origin, int destination, Bitboard enPassant) const
+    {
+        const auto kings = getFigures(color, FigureType::king);
+        if (kings == 0)
+            return true;
+
+        // the moved figure may uncover a slider or block it, a captured figure attacks no longer
+        const auto occupied = ((getOccupied() ^ BitboardHelper::bit(origin)) | BitboardHelper::bit(destination)) & ~enPassant;
+        const auto king     = (kings & BitboardHelper::bit(origin)) != 0 ? destination : BitboardHelper::lsb(kings);
+        const auto enemies  = getOccupied(ChessTypes::getOpponent(color)) & ~(BitboardHelper::bit(destination) | enPassant);
+
+        return (attackersTo(king, occupied) & enemies) == 0;
+    }
+
+    FigureType Board::getFigureType(int square) const
+    {
+        const auto bit   = BitboardHelper::bit(square);
+        const auto color = (_colors[static_cast<size_t>(Color::white)] & bit) != 0 ? Color::white : Color::black;
+        if ((_colors[static_cast<size_t>(color)] & bit) == 0)
+            return FigureType::none;
+
+        for (size_t type = 1; type < 7; type++)
+            if ((_figures[static_cast<size_t>(color)][type] & bit) != 0)
+                return static_cast<FigureType>(type);
+
+        return FigureType::none;
+    }
+
+    void Board::updateEval(Color color, FigureType type, int square, int sign)
+    {
+        // the tables are from the view of white, black uses the square mirrored at the middle rank
+        const auto index    = static_cast<size_t>(type);
+        const auto relative = color == Color::white ? square : square ^ 56;
+        const auto side     = color == Color::white ? sign : -sign;
+
+        for (size_t phase = 0; phase < 2; phase++)
+            _score[phase] += side * (_evalParams->material[phase][index] + _evalParams->pst[phase][index][relative]);
+
+        _phase += sign * _evalParams->phase[index];
+    }
+
+    void Board::updateNetwork(Color color, FigureType type, int square, int sign)
+    {
+        if (!_network)
+            return;
+
+        for (auto perspective : {Color::white, Color::black})
         {
-            if (field.figure.getType() == figureType && field.figure.getColor() == byColor)
-                return &field;
+            const auto index = static_cast<size_t>(perspective) - 1;
+
+            // the features depend on the own king, so its move needs a new accumulator
+            if (type == FigureType::king)
+            {
+                if (color == perspective)
+                    _accumulatorValid[index] = false;
+                continue;
+            }
+
+            if (!_accumulatorValid[index])
+                continue;
+
+            const auto kings   = _figures[static_cast<size_t>(perspective)][static_cast<size_t>(FigureType::king)];
+            const auto feature = Nnue::feature(perspective, kings == 0 ? 0 : BitboardHelper::lsb(kings), color, type, square);
+            if (sign > 0)
+                _network->addFeature(feature, _accumulators[index].data());
+            else
+                _network->removeFeature(feature, _accumulators[index].data());
         }
+    }
+
+    void Board::refreshAccumulator(Color perspective)
+    {
+        const auto index = static_cast<size_t>(perspective) - 1;
+        const auto kings = _figures[static_cast<size_t>(perspective)][static_cast<size_t>(FigureType::king)];
+        const auto king  = kings == 0 ? 0 : BitboardHelper::lsb(kings);
+
+        _network->resetAccumulator(_accumulators[index].data());
+        for (auto color : {Color::white, Color::black})
+            for (size_t type = 2; type < 7; type++)
+            {
+                auto figures = _figures[static_cast<size_t>(color)][type];
+                while (figures != 0)
+                {
+                    const auto square = BitboardHelper::popLsb(figures);
+                    _network->addFeature(Nnue::feature(perspective, king, color, static_cast<FigureType>(type), square),
+                                         _accumulators[index].data());
+                }
+            }
+
+        _accumulatorValid[index] = true;
+    }
+
+    std::vector<Field*> Board::getAllOccupiedFields(Color ofColor)
+    {
+        std::vector<Field*> result;
+        auto                fields = getOccupied(ofColor);
+
+        while (fields != 0)
+            result.push_back(&at(BitboardHelper::position(BitboardHelper::popLsb(fields))));
+
+        return result;
+    }
+
+    Field* Board::getFigure(Color byColor, FigureType figureType)
+    {
+        const auto fields = getFigures(byColor, figureType);
+        if (fields == 0)
+            return nullptr;
 
-        return nullptr;
+        return &at(BitboardHelper::position(BitboardHelper::lsb(fields)));
     }
 }
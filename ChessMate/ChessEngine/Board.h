@@ -27,6 +27,10 @@
 #pragma once
 
 #include "BasicUtils/Matrix.h"
+#include "Bitboard.h"
+#include "EvalParams.h"
+#include "Nnue.h"
+#include "Zobrist.h"
 #include "ChessTypes.h"
 #include "Figure.h"
 
@@ -54,6 +58,8 @@ namespace ChessNS
     class TestBoardRelationalMove;
     class TestBoardDiagonalMove;
     class TestBoardRankFieldMove;
+    class TestSearch;
+    class TestMcts;
     #endif
 
     /*!
@@ -70,6 +76,8 @@ namespace ChessNS
         friend TestBoardRelationalMove;
         friend TestBoardDiagonalMove;
         friend TestBoardRankFieldMove;
+        friend TestSearch;
+        friend TestMcts;
         #endif
 
         /*!
@@ -158,6 +166,65 @@ namespace ChessNS
          */
         Movement move(Movement movement);
 
+        /*!
+         * \fn  ResolveResult Board::resolve(Movement& movement);
+         *
+         * \brief   Finds the origin of a parsed movement of the current player. The figures of its type which reach
+         *          the destination are taken from the attack tables, filtered by the given part of the origin and by
+         *          whether they would leave the own king in check.
+         *
+         * \param [in,out]  movement    The movement with figure type, destination and if given a part of the
+         *                              origin. The origin is set if there is exactly one legal move.
+         *
+         * \returns ResolveResult::unique if the origin was set, otherwise whether there are several or no legal
+         *          moves.
+         */
+        ResolveResult resolve(Movement& movement);
+
+        /*!
+         * \fn  Movement Board::makeMove(Position origin, Position destination, FigureType promotedTo = FigureType::none);
+         *
+         * \brief   Makes a move directly on this board without checking the victory condition. The move can be
+         *          taken back with unmakeMove, which makes it the cheap way to walk through positions in a search.
+         *
+         * \param   origin      The origin.
+         * \param   destination Destination for the move.
+         * \param   promotedTo  (Optional) The figure type a pawn reaching the last row shall become.
+         *
+         * \returns The result of the move, the board is unchanged if the move is invalid.
+         */
+        Movement makeMove(Position origin, Position destination, FigureType promotedTo = FigureType::none);
+
+        /*!
+         * \fn  Movement Board::makeLegalMove(Position origin, Position destination, FigureType promotedTo = FigureType::none);
+         *
+         * \brief   Makes a move like makeMove, but trusts it to be legal, e.g. because it was resolved or generated
+         *          as a legal move on this board. It is not checked a second time whether the figure can move there
+         *          and whether the own king is left in check.
+         *
+         * \param   origin      The origin.
+         * \param   destination Destination for the move.
+         * \param   promotedTo  (Optional) The figure type a pawn reaching the last row shall become.
+         *
+         * \returns The result of the move.
+         */
+        Movement makeLegalMove(Position origin, Position destination, FigureType promotedTo = FigureType::none);
+
+        /*!
+         * \fn  void Board::makeNullMove();
+         *
+         * \brief   Passes the turn to the opponent without moving a figure, an en passant capture is no longer
+         *          possible afterwards. It is taken back with unmakeMove like any other move.
+         */
+        void makeNullMove();
+
+        /*!
+         * \fn  void Board::unmakeMove();
+         *
+         * \brief   Takes back the last move made by makeMove or makeNullMove
+         */
+        void unmakeMove();
+
         /*!
          * \fn  bool Board::changeFigureType(const Position& position, FigureType figure);
          *
@@ -170,6 +237,84 @@ namespace ChessNS
          */
         bool changeFigureType(const Position& position, FigureType figure);
 
+        /*!
+         * \fn  void Board::placeFigure(const Position& position, const Figure& figure);
+         *
+         * \brief   Places a figure on a field, a figure which is already there is replaced
+         *
+         * \param   position    The position of the field.
+         * \param   figure      The figure.
+         */
+        void placeFigure(const Position& position, const Figure& figure);
+
+        /*!
+         * \fn  void Board::removeFigure(const Position& position);
+         *
+         * \brief   Removes the figure from a field
+         *
+         * \param   position    The position of the field.
+         */
+        void removeFigure(const Position& position);
+
+        /*!
+         * \fn  Bitboard Board::getFigures(Color color, FigureType figureType) const;
+         *
+         * \brief   Gets the fields of all figures of a type and color
+         *
+         * \param   color       The color.
+         * \param   figureType  The figure type.
+         *
+         * \returns The fields as Bitboard.
+         */
+        Bitboard getFigures(Color color, FigureType figureType) const;
+
+        /*!
+         * \fn  Bitboard Board::getOccupied(Color color) const;
+         *
+         * \brief   Gets the fields occupied by a color
+         *
+         * \param   color   The color, Color::none for both colors.
+         *
+         * \returns The fields as Bitboard.
+         */
+        Bitboard getOccupied(Color color = Color::none) const;
+
+        /*!
+         * \fn  Bitboard Board::getAttackers(const Position& position, Color byColor) const;
+         *
+         * \brief   Gets the figures of a color which attack a field
+         *
+         * \param   position    The position of the field.
+         * \param   byColor     The attacking color.
+         *
+         * \returns The fields of the attackers as Bitboard.
+         */
+        Bitboard getAttackers(const Position& position, Color byColor) const;
+
+        /*!
+         * \fn  int Board::see(const Position& origin, const Position& destination) const;
+         *
+         * \brief   Static exchange evaluation, computes the material outcome of the capture sequence on the
+         *          destination which starts with this move. No move is made on the board.
+         *
+         * \param   origin      The origin of the move.
+         * \param   destination The destination of the move.
+         *
+         * \returns The material gain in centipawns for the color making the move.
+         */
+        int see(const Position& origin, const Position& destination) const;
+
+        /*!
+         * \fn  int Board::see(Movement& movement) const;
+         *
+         * \brief   Static exchange evaluation of a movement with a known origin
+         *
+         * \param   movement    The movement.
+         *
+         * \returns The material gain in centipawns for the color making the move.
+         */
+        int see(Movement& movement) const;
+
         /*!
          * \fn  bool Board::isCheck(Color color);
          *
@@ -232,6 +377,51 @@ namespace ChessNS
          */
         std::vector<Movement> getAllPossibleMoves(Color ofColor);
 
+        /*!
+         * \fn  bool Board::hasLegalMove();
+         *
+         * \brief   Query if the color on turn can move at all. It stops at the first legal move and makes no moves,
+         *          which is much cheaper than generating all of them to find a checkmate or stalemate.
+         *
+         * \returns True if there is a legal move, false if not.
+         */
+        bool hasLegalMove();
+
+        /*!
+         * \fn  void Board::getLegalMoves(std::vector<uint16_t>& moves);
+         *
+         * \brief   Gets the legal moves of the color on turn without making them. The order only depends on the
+         *          position, so a move can be stored as its index in the list. A promotion is in the list once.
+         *
+         * \param [out]     moves   The moves, the square of the origin in the lower six bits and the square of
+         *                          the destination in the next six bits. The memory is reused.
+         */
+        void getLegalMoves(std::vector<uint16_t>& moves);
+
+        /*!
+         * \fn  std::vector<Movement> Board::getAllPossibleCaptures(Color ofColor);
+         *
+         * \brief   Gets all captures and promotions a color can make now. Only the fields of the opponent and the
+         *          fields in front of pawns are tried, quiet moves are never generated.
+         *
+         * \param   ofColor The color which shall make the moves.
+         *
+         * \returns all possible captures and promotions.
+         */
+        std::vector<Movement> getAllPossibleCaptures(Color ofColor);
+
+        /*!
+         * \fn  std::vector<Movement> Board::getAllPossibleQuietMoves(Color ofColor);
+         *
+         * \brief   Gets all moves a color can make now which are neither captures nor promotions. Only the fields
+         *          attacked by the figures, the fields in front of pawns and the castling fields are tried.
+         *
+         * \param   ofColor The color which shall make the moves.
+         *
+         * \returns all possible quiet moves.
+         */
+        std::vector<Movement> getAllPossibleQuietMoves(Color ofColor);
+
         /*!
          * \fn  std::vector<Movement> Board::getAllMadeMoves() const;
          *
@@ -271,23 +461,198 @@ namespace ChessNS
          */
         Color getCurrentColorTurn() const;
 
+        /*!
+         * \fn  uint64_t Board::getPawnHash() const;
+         *
+         * \brief   Gets the Zobrist hash of the pawns only, positions with the same pawn structure share it
+         *
+         * \returns The hash.
+         */
+        uint64_t getPawnHash() const;
+
+        /*!
+         * \fn  int Board::getPhase() const;
+         *
+         * \brief   Gets the game phase by the weights of the remaining figures
+         *
+         * \returns The phase from 0 for the endgame up to EvalParams::fullPhase for the middlegame.
+         */
+        int getPhase() const;
+
+        /*!
+         * \fn  int Board::evaluate() const;
+         *
+         * \brief   Evaluates the material and the piece square tables, tapered between middlegame and endgame by the
+         *          remaining figures. The sums are kept up to date with every placed, removed or changed figure.
+         *
+         * \returns The score in centipawns from the view of the color on turn.
+         */
+        int evaluate() const;
+
+        /*!
+         * \fn  int Board::evaluate(GamePhase phase) const;
+         *
+         * \brief   Gets the untapered sum of the material and the piece square tables of one phase
+         *
+         * \param   phase   The phase.
+         *
+         * \returns The score in centipawns from the view of white.
+         */
+        int evaluate(GamePhase phase) const;
+
+        /*!
+         * \fn  void Board::setEvalParams(std::shared_ptr<const EvalParams> params);
+         *
+         * \brief   Changes the parameters of the evaluation, the sums are calculated again
+         *
+         * \param   params  The parameters.
+         */
+        void setEvalParams(std::shared_ptr<const EvalParams> params);
+
+        /*!
+         * \fn  const EvalParams& Board::getEvalParams() const;
+         *
+         * \brief   Gets the parameters of the evaluation
+         *
+         * \returns The parameters.
+         */
+        const EvalParams& getEvalParams() const;
+
+        /*!
+         * \fn  uint32_t Board::getEvalGeneration() const;
+         *
+         * \brief   Gets the generation of the parameters of the evaluation, every call of setEvalParams gives a new
+         *          one. Caches of evaluated terms keep it with their entries.
+         *
+         * \returns The generation, 0 for the default parameters.
+         */
+        uint32_t getEvalGeneration() const;
+
+        /*!
+         * \fn  void Board::setNetwork(std::shared_ptr<const Nnue> network);
+         *
+         * \brief   Changes the neural network of evaluateNetwork, the accumulators are calculated again when needed
+         *
+         * \param   network The network, nullptr to stop updating the accumulators.
+         */
+        void setNetwork(std::shared_ptr<const Nnue> network);
+
+        /*!
+         * \fn  const std::shared_ptr<const Nnue>& Board::getNetwork() const;
+         *
+         * \brief   Gets the neural network
+         *
+         * \returns The network, nullptr if there is none.
+         */
+        const std::shared_ptr<const Nnue>& getNetwork() const;
+
+        /*!
+         * \fn  int Board::evaluateNetwork();
+         *
+         * \brief   Evaluates the position with the neural network. The accumulators are updated with every placed,
+         *          removed or changed figure, only a move of a king calculates the one of its perspective again.
+         *
+         * \returns The score in centipawns from the view of the color on turn, 0 if there is no network.
+         */
+        int evaluateNetwork();
+
+        /*!
+         * \fn  uint64_t Board::getHash();
+         *
+         * \brief   Gets the Zobrist hash of the position, including the color on turn, the castling rights and a
+         *          possible en passant capture
+         *
+         * \returns The hash.
+         */
+        uint64_t getHash();
+
+        /*!
+         * \fn  bool Board::hasCastlingRight(Color color, bool kingSide);
+         *
+         * \brief   Query if a color may still castle to a side, i.e. the king and the rook have not moved yet
+         *
+         * \param   color       The color.
+         * \param   kingSide    True for the king side, false for the queen side.
+         *
+         * \returns True if the right still exists, castling may still be blocked or attacked.
+         */
+        bool hasCastlingRight(Color color, bool kingSide);
+
+        /*!
+         * \fn  int Board::getEnPassantColumn();
+         *
+         * \brief   Gets the column of a pawn which made a double step with the last move
+         *
+         * \returns The column, -1 if there is none.
+         */
+        int getEnPassantColumn();
+
     private:
 
+        /*!
+         * \struct  MoveRecord
+         *
+         * \brief   Everything needed to take back a move made by makeMove.
+         */
+        struct MoveRecord
+        {
+            /*! \brief   The fields as they were before the move */
+            Field fields[4];
+            /*! \brief   The number of stored fields */
+            size_t nbrOfFields{};
+            /*! \brief   The move counter before the move */
+            unsigned currentMove{};
+            /*! \brief   The color which was on turn before the move */
+            Color currentColorTurn{};
+        };
+
         explicit Board(BoardStartType boardStart);
 
         Movement move(Position origin, Position destination, bool checkVictory);
 
         Movement allowed(Position origin, Position destination, bool checkVictory) const;
 
-        static void createFigure(Field& field, FigureType figure, Color color);
+        Movement executeMove(Position origin, Position destination, FigureType promotedTo, bool checkKing);
+
+        void restore(const MoveRecord& record);
+
+        void createFigure(Field& field, FigureType figure, Color color);
+
+        Bitboard attackersTo(int square, Bitboard occupied) const;
+
+        bool leavesKingSafe(Color color, int origin, int destination, Bitboard enPassant) const;
+
+        template <typename Callback>
+        bool forEachLegalMove(Callback&& callback);
+
+        FigureType getFigureType(int square) const;
+
+        void updateEval(Color color, FigureType type, int square, int sign);
+
+        void updateNetwork(Color color, FigureType type, int square, int sign);
+
+        void refreshAccumulator(Color perspective);
 
         std::vector<Field*> getAllOccupiedFields(Color ofColor);
 
         Field* getFigure(Color byColor, FigureType figureType);
 
-        unsigned              _currentMove{1};
-        Color                 _currentColorTurn{Color::white};
-        bool                  _ended{false};
-        std::vector<Movement> _movements;
+        unsigned                _currentMove{1};
+        Color                   _currentColorTurn{Color::white};
+        bool                    _ended{false};
+        std::vector<Movement>   _movements;
+        std::vector<MoveRecord> _moveRecords;
+        Bitboard                _figures[3][7]{};
+        Bitboard                _colors[3]{};
+        uint64_t                _hash{};
+        uint64_t                _pawnHash{};
+        int                     _score[2]{};
+        int                     _phase{};
+
+        std::shared_ptr<const EvalParams> _evalParams{EvalParams::defaults()};
+        uint32_t                          _evalGeneration{};
+        std::shared_ptr<const Nnue>       _network;
+        std::vector<int16_t>              _accumulators[2];
+        bool                              _accumulatorValid[2]{};
     };
 }
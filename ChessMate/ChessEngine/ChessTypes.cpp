@@ -203,4 +203,98 @@ namespace ChessNS
         if (pos != _events.end())
             _events.erase(pos);
     }
+
+    void GameHeader::clear()
+    {
+        _text.clear();
+        _tags.clear();
+    }
+
+    void GameHeader::add(StringView name, StringView value)
+    {
+        const auto found = find(name);
+        if (found >= 0)
+            _tags.erase(_tags.begin() + found);
+
+        Tag tag{};
+        tag.name      = static_cast<uint32_t>(_text.size());
+        tag.nameSize  = static_cast<uint16_t>(std::min<size_t>(name.size(), UINT16_MAX));
+        tag.value     = tag.name + tag.nameSize;
+        tag.valueSize = static_cast<uint16_t>(std::min<size_t>(value.size(), UINT16_MAX));
+        _text.append(name.data(), tag.nameSize);
+        _text.append(value.data(), tag.valueSize);
+        _tags.push_back(tag);
+    }
+
+    StringView GameHeader::tag(StringView name) const
+    {
+        const auto found = find(name);
+        return found >= 0 ? value(static_cast<size_t>(found)) : StringView();
+    }
+
+    bool GameHeader::has(StringView name) const
+    {
+        return find(name) >= 0;
+    }
+
+    size_t GameHeader::size() const
+    {
+        return _tags.size();
+    }
+
+    StringView GameHeader::name(size_t index) const
+    {
+        return StringView(_text.data() + _tags[index].name, _tags[index].nameSize);
+    }
+
+    StringView GameHeader::value(size_t index) const
+    {
+        return StringView(_text.data() + _tags[index].value, _tags[index].valueSize);
+    }
+
+    namespace
+    {
+        unsigned toUnsigned(StringView text)
+        {
+            unsigned result = 0;
+            for (const auto c : text)
+            {
+                if (c < '0' || c > '9')
+                    return 0;
+                result = result * 10 + static_cast<unsigned>(c - '0');
+            }
+            return result;
+        }
+    }
+
+    unsigned GameHeader::whiteElo() const
+    {
+        return toUnsigned(tag("WhiteElo"));
+    }
+
+    unsigned GameHeader::blackElo() const
+    {
+        return toUnsigned(tag("BlackElo"));
+    }
+
+    GameResult GameHeader::result() const
+    {
+        const auto result = tag("Result");
+        if (result == "1-0")
+            return GameResult::victoryWhite;
+        if (result == "0-1")
+            return GameResult::victoryBlack;
+        if (result == "1/2-1/2")
+            return GameResult::draw;
+        return GameResult::none;
+    }
+
+    int GameHeader::find(StringView name) const
+    {
+        // a game has about a dozen tags, searching them is faster than any map
+        for (size_t i = 0; i < _tags.size(); i++)
+            if (_tags[i].nameSize == name.size() && this->name(i) == name)
+                return static_cast<int>(i);
+        return -1;
+    }
 }
@@ -25,9 +25,11 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
+#include "BasicUtils/StringView.h"
 
 /*!
  * \namespace   ChessNS
@@ -68,6 +70,13 @@ namespace ChessNS
      */
     enum class MoveResult { invalid, valid };
 
+    /*!
+     * \enum    ResolveResult
+     *
+     * \brief   Values that represent the results of finding the origin of a parsed movement
+     */
+    enum class ResolveResult { unique, ambiguous, illegal };
+
     /*!
      * \enum    EventFlag
      *
@@ -163,6 +172,29 @@ namespace ChessNS
                 default: return Color::none;
             }
         }
+
+        /*!
+         * \fn  static int ChessTypes::getFigureValue(FigureType type)
+         *
+         * \brief   Gets the material value of a figure type in centipawns
+         *
+         * \param   type    The figure type.
+         *
+         * \returns The value, 0 for FigureType::none.
+         */
+        static int getFigureValue(FigureType type)
+        {
+            switch (type)
+            {
+                case FigureType::pawn: return 100;
+                case FigureType::knight: return 320;
+                case FigureType::bishop: return 330;
+                case FigureType::rook: return 500;
+                case FigureType::queen: return 900;
+                case FigureType::king: return 20000;
+                default: return 0;
+            }
+        }
     };
 
     /*!
@@ -450,6 +482,142 @@ namespace ChessNS
         FigureType _promotedTo{};
     };
 
+    /*!
+     * \class   GameHeader
+     *
+     * \brief   The tag pairs of a game. The names and values are kept in one string, so a header reused for many
+     *          games allocates only while it grows.
+     */
+    class GameHeader
+    {
+    public:
+
+        /*!
+         * \fn  void GameHeader::clear();
+         *
+         * \brief   Removes all tags and keeps the memory
+         */
+        void clear();
+
+        /*!
+         * \fn  void GameHeader::add(StringView name, StringView value);
+         *
+         * \brief   Adds a tag, a tag which is already there is replaced
+         *
+         * \param   name    The name.
+         * \param   value   The value.
+         */
+        void add(StringView name, StringView value);
+
+        /*!
+         * \fn  StringView GameHeader::tag(StringView name) const;
+         *
+         * \brief   Gets the value of a tag
+         *
+         * \param   name    The name.
+         *
+         * \returns The value, empty if there is no such tag.
+         */
+        StringView tag(StringView name) const;
+
+        /*!
+         * \fn  bool GameHeader::has(StringView name) const;
+         *
+         * \brief   Query if there is a tag
+         *
+         * \param   name    The name.
+         *
+         * \returns True if there is the tag, false if not.
+         */
+        bool has(StringView name) const;
+
+        /*!
+         * \fn  size_t GameHeader::size() const;
+         *
+         * \brief   Gets the number of tags
+         *
+         * \returns The number of tags.
+         */
+        size_t size() const;
+
+        /*!
+         * \fn  StringView GameHeader::name(size_t index) const;
+         *
+         * \brief   Gets the name of a tag in the order they were added
+         *
+         * \param   index   Zero-based index of the tag.
+         *
+         * \returns The name.
+         */
+        StringView name(size_t index) const;
+
+        /*!
+         * \fn  StringView GameHeader::value(size_t index) const;
+         *
+         * \brief   Gets the value of a tag in the order they were added
+         *
+         * \param   index   Zero-based index of the tag.
+         *
+         * \returns The value.
+         */
+        StringView value(size_t index) const;
+
+        /*! \brief   The Event tag */
+        StringView event() const { return tag("Event"); }
+        /*! \brief   The Site tag */
+        StringView site() const { return tag("Site"); }
+        /*! \brief   The Date tag */
+        StringView date() const { return tag("Date"); }
+        /*! \brief   The White tag */
+        StringView white() const { return tag("White"); }
+        /*! \brief   The Black tag */
+        StringView black() const { return tag("Black"); }
+        /*! \brief   The ECO tag */
+        StringView eco() const { return tag("ECO"); }
+
+        /*!
+         * \fn  unsigned GameHeader::whiteElo() const;
+         *
+         * \brief   Gets the rating of white
+         *
+         * \returns The WhiteElo tag, 0 if it is missing or not a number.
+         */
+        unsigned whiteElo() const;
+
+        /*!
+         * \fn  unsigned GameHeader::blackElo() const;
+         *
+         * \brief   Gets the rating of black
+         *
+         * \returns The BlackElo tag, 0 if it is missing or not a number.
+         */
+        unsigned blackElo() const;
+
+        /*!
+         * \fn  GameResult GameHeader::result() const;
+         *
+         * \brief   Gets the result of the Result tag
+         *
+         * \returns The result, GameResult::none if it is missing or unknown.
+         */
+        GameResult result() const;
+
+    private:
+
+        struct Tag
+        {
+            uint32_t name;
+            uint16_t nameSize;
+            uint32_t value;
+            uint16_t valueSize;
+        };
+
+        int find(StringView name) const;
+
+        std::string      _text;
+        std::vector<Tag> _tags;
+    };
+
     /*!
      * \class   Game
      *
@@ -462,5 +630,7 @@ namespace ChessNS
         GameResult result{};
         /*! \brief   The movements */
         std::vector<Movement> movements{};
+        /*! \brief   The tag pairs */
+        GameHeader header{};
     };
 }
@@ -0,0 +1,317 @@
+/*!
+* \brief:  Implements the evaluation parameters
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "EvalParams.h"
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace ChessNS
+{
+    // Piece square tables as printed boards from the view of white, a8 first
+    static const int pawnTable[2][64] = {
+        {  0,   0,   0,   0,   0,   0,   0,   0,
+          50,  50,  50,  50,  50,  50,  50,  50,
+          10,  10,  20,  30,  30,  20,  10,  10,
+           5,   5,  10,  25,  25,  10,   5,   5,
+           0,   0,   0,  20,  20,   0,   0,   0,
+           5,  -5, -10,   0,   0, -10,  -5,   5,
+           5,  10,  10, -20, -20,  10,  10,   5,
+           0,   0,   0,   0,   0,   0,   0,   0},
+        {  0,   0,   0,   0,   0,   0,   0,   0,
+          80,  80,  80,  80,  80,  80,  80,  80,
+          50,  50,  50,  50,  50,  50,  50,  50,
+          30,  30,  30,  30,  30,  30,  30,  30,
+          15,  15,  15,  15,  15,  15,  15,  15,
+           5,   5,   5,   5,   5,   5,   5,   5,
+           0,   0,   0,   0,   0,   0,   0,   0,
+           0,   0,   0,   0,   0,   0,   0,   0}};
+
+    static const int knightTable[64] = {
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   0,  15,  20,  20,  15,   0, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50};
+
+    static const int bishopTable[64] = {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20};
+
+    static const int rookTable[64] = {
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,  10,  10,  10,  10,  10,  10,   5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+          0,   0,   0,   5,   5,   0,   0,   0};
+
+    static const int queenTable[64] = {
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+         -5,   0,   5,   5,   5,   5,   0,  -5,
+          0,   0,   5,   5,   5,   5,   0,  -5,
+        -10,   5,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,   0,   0,   0,   0, -10,
+        -20, -10, -10,  -5,  -5, -10, -10, -20};
+
+    static const int kingTable[2][64] = {
+        {-30, -40, -40, -50, -50, -40, -40, -30,
+         -30, -40, -40, -50, -50, -40, -40, -30,
+         -30, -40, -40, -50, -50, -40, -40, -30,
+         -30, -40, -40, -50, -50, -40, -40, -30,
+         -20, -30, -30, -40, -40, -30, -30, -20,
+         -10, -20, -20, -20, -20, -20, -20, -10,
+          20,  20,   0,   0,   0,   0,  20,  20,
+          20,  30,  10,   0,   0,  10,  30,  20},
+        {-50, -40, -30, -20, -20, -30, -40, -50,
+         -30, -20, -10,   0,   0, -10, -20, -30,
+         -30, -10,  20,  30,  30,  20, -10, -30,
+         -30, -10,  30,  40,  40,  30, -10, -30,
+         -30, -10,  30,  40,  40,  30, -10, -30,
+         -30, -10,  20,  30,  30,  20, -10, -30,
+         -30, -30,   0,   0,   0,   0, -30, -30,
+         -50, -30, -30, -30, -30, -30, -30, -50}};
+
+    static const FigureType figureTypes[6] = {
+        FigureType::king, FigureType::queen, FigureType::rook, FigureType::knight, FigureType::bishop, FigureType::pawn};
+
+    static const char* phaseNames[2] = {"middlegame", "endgame"};
+
+    // the tables are printed with rank 8 first, the squares start at a1
+    static int printedIndex(int square)
+    {
+        return (7 - square / 8) * 8 + square % 8;
+    }
+
+    struct PawnTerm
+    {
+        const char* name;
+        int*        values;
+        int         count;
+    };
+
+    // the pawn structure entries of one phase
+    static std::vector<PawnTerm> pawnTerms(EvalParams& params, int gamePhase)
+    {
+        return {{"passed", params.passed[gamePhase], 8},
+                {"isolated", &params.isolated[gamePhase], 1},
+                {"doubled", &params.doubled[gamePhase], 1},
+                {"backward", &params.backward[gamePhase], 1},
+                {"shield", &params.shield[gamePhase], 1}};
+    }
+
+    static EvalParams createDefaults()
+    {
+        EvalParams params;
+        const int  middlegame[7] = {0, 0, 900, 500, 320, 330, 100};
+        const int  endgame[7]    = {0, 0, 950, 520, 300, 320, 120};
+        const int  phase[7]      = {0, 0, 4, 2, 1, 1, 0};
+        const int  passed[2][8]  = {{0, 5, 10, 15, 25, 40, 60, 0}, {0, 10, 20, 35, 60, 100, 150, 0}};
+
+        for (size_t type = 0; type < 7; type++)
+        {
+            params.material[0][type] = middlegame[type];
+            params.material[1][type] = endgame[type];
+            params.phase[type]       = phase[type];
+        }
+
+        for (int rank = 0; rank < 8; rank++)
+        {
+            params.passed[0][rank] = passed[0][rank];
+            params.passed[1][rank] = passed[1][rank];
+        }
+
+        params.isolated[0] = -10;
+        params.isolated[1] = -15;
+        params.doubled[0]  = -10;
+        params.doubled[1]  = -20;
+        params.backward[0] = -8;
+        params.backward[1] = -10;
+        params.shield[0]   = 10;
+        params.shield[1]   = 0;
+
+        for (int gamePhase = 0; gamePhase < 2; gamePhase++)
+            for (int square = 0; square < 64; square++)
+            {
+                auto&      pst     = params.pst[gamePhase];
+                const auto printed = printedIndex(square);
+
+                pst[static_cast<size_t>(FigureType::king)][square]   = kingTable[gamePhase][printed];
+                pst[static_cast<size_t>(FigureType::queen)][square]  = queenTable[printed];
+                pst[static_cast<size_t>(FigureType::rook)][square]   = rookTable[printed];
+                pst[static_cast<size_t>(FigureType::knight)][square] = knightTable[printed];
+                pst[static_cast<size_t>(FigureType::bishop)][square] = bishopTable[printed];
+                pst[static_cast<size_t>(FigureType::pawn)][square]   = pawnTable[gamePhase][printed];
+            }
+
+        return params;
+    }
+
+    std::shared_ptr<const EvalParams> EvalParams::defaults()
+    {
+        static const auto params = std::make_shared<const EvalParams>(createDefaults());
+        return params;
+    }
+
+    int EvalParams::fullPhase() const
+    {
+        return 16 * phase[static_cast<size_t>(FigureType::pawn)]
+            + 4 * (phase[static_cast<size_t>(FigureType::knight)] + phase[static_cast<size_t>(FigureType::bishop)]
+                + phase[static_cast<size_t>(FigureType::rook)])
+            + 2 * (phase[static_cast<size_t>(FigureType::queen)] + phase[static_cast<size_t>(FigureType::king)]);
+    }
+
+    bool EvalParams::load(std::istream& in)
+    {
+        std::stringstream entries;
+        std::string       line;
+
+        while (std::getline(in, line))
+            entries << line.substr(0, line.find('#')) << '\n';
+
+        std::string name;
+        std::string figure;
+        while (entries >> name)
+        {
+            if (!(entries >> figure))
+                return false;
+
+            auto type = FigureType::none;
+            for (auto candidate : figureTypes)
+                if (toString(candidate) == figure)
+                    type = candidate;
+
+            if (type == FigureType::none)
+                return false;
+
+            const auto index = static_cast<size_t>(type);
+            if (name == "phase")
+            {
+                if (!(entries >> phase[index]))
+                    return false;
+                continue;
+            }
+
+            auto found = false;
+            for (int gamePhase = 0; gamePhase < 2; gamePhase++)
+            {
+                if (name == std::string("material.") + phaseNames[gamePhase])
+                {
+                    if (!(entries >> material[gamePhase][index]))
+                        return false;
+                    found = true;
+                }
+                else if (name == std::string("pst.") + phaseNames[gamePhase])
+                {
+                    for (int square = 0; square < 64; square++)
+                        if (!(entries >> pst[gamePhase][index][printedIndex(square)]))
+                            return false;
+                    found = true;
+                }
+                else if (type == FigureType::pawn)
+                {
+                    int* values = nullptr;
+                    auto count  = 1;
+
+                    for (auto& term : pawnTerms(*this, gamePhase))
+                        if (name == std::string(term.name) + "." + phaseNames[gamePhase])
+                        {
+                            values = term.values;
+                            count  = term.count;
+                        }
+
+                    if (values == nullptr)
+                        continue;
+
+                    for (int i = 0; i < count; i++)
+                        if (!(entries >> values[i]))
+                            return false;
+                    found = true;
+                }
+            }
+
+            if (!found)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool EvalParams::load(const std::string& filename)
+    {
+        std::ifstream in(filename);
+        if (!in)
+            return false;
+
+        return load(in);
+    }
+
+    void EvalParams::save(std::ostream& out) const
+    {
+        out << "# ChessMate evaluation parameters, piece square tables from the view of white with a8 first\n";
+        for (auto type : figureTypes)
+        {
+            const auto index = static_cast<size_t>(type);
+            out << "\nphase " << toString(type) << ' ' << phase[index] << '\n';
+
+            for (int gamePhase = 0; gamePhase < 2; gamePhase++)
+                out << "material." << phaseNames[gamePhase] << ' ' << toString(type) << ' ' << material[gamePhase][index] << '\n';
+
+            for (int gamePhase = 0; gamePhase < 2; gamePhase++)
+            {
+                out << "pst." << phaseNames[gamePhase] << ' ' << toString(type);
+                for (int square = 0; square < 64; square++)
+                    out << (square % 8 == 0 ? "\n   " : "") << ' ' << pst[gamePhase][index][printedIndex(square)];
+                out << '\n';
+            }
+        }
+
+        // pawnTerms gives write access for load, so save reads a copy
+        auto copy = *this;
+        out << "\n# pawn structure, passed pawns by rank from the own side\n";
+        for (int gamePhase = 0; gamePhase < 2; gamePhase++)
+            for (auto& term : pawnTerms(copy, gamePhase))
+            {
+                out << term.name << '.' << phaseNames[gamePhase] << " pawn";
+                for (int i = 0; i < term.count; i++)
+                    out << ' ' << term.values[i];
+                out << '\n';
+            }
+    }
+}
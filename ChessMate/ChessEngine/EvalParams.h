@@ -0,0 +1,121 @@
+/*!
+* \brief:  Declares the evaluation parameters
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include "ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \enum    GamePhase
+     *
+     * \brief   Values that represent the phases between which the evaluation is tapered
+     */
+    enum class GamePhase { middlegame, endgame };
+
+    /*!
+     * \struct  EvalParams
+     *
+     * \brief   The parameters of the tapered material and piece square table evaluation. All values are in
+     *          centipawns from the view of white, a black figure uses the square mirrored at the middle rank.
+     */
+    struct EvalParams
+    {
+        /*! \brief   The material per phase and figure type */
+        int material[2][7]{};
+        /*! \brief   The piece square tables per phase and figure type, indexed by square (a1 is 0, h8 is 63) */
+        int pst[2][7][64]{};
+        /*! \brief   The weight of a figure type for the game phase, the start position is the full middlegame */
+        int phase[7]{};
+        /*! \brief   The bonus of a passed pawn per phase and rank seen from its own side */
+        int passed[2][8]{};
+        /*! \brief   The penalty of a pawn without own pawns on the neighbouring columns per phase */
+        int isolated[2]{};
+        /*! \brief   The penalty of a pawn with an own pawn in front of it per phase */
+        int doubled[2]{};
+        /*! \brief   The penalty of a pawn which can not be supported and whose next field is attacked by a pawn */
+        int backward[2]{};
+        /*! \brief   The bonus per own pawn on the two rows in front of the king and the columns around it */
+        int shield[2]{};
+
+        /*!
+         * \fn  static std::shared_ptr<const EvalParams> EvalParams::defaults();
+         *
+         * \brief   Gets the built in parameters
+         *
+         * \returns The parameters, shared by all boards which use them.
+         */
+        static std::shared_ptr<const EvalParams> defaults();
+
+        /*!
+         * \fn  int EvalParams::fullPhase() const;
+         *
+         * \brief   Gets the phase of the start position
+         *
+         * \returns The sum of the phase weights of all figures of the start position.
+         */
+        int fullPhase() const;
+
+        /*!
+         * \fn  bool EvalParams::load(std::istream& in);
+         *
+         * \brief   Loads parameters in the format written by save. Lines may contain comments starting with #, every
+         *          entry is a name, a figure type and one value for "material" and "phase" or 64 values for "pst",
+         *          which are listed from a8 to h8 down to a1 to h1 like a printed board. The pawn structure entries
+         *          "passed" with 8 values by rank, "isolated", "doubled", "backward" and "shield" belong to the
+         *          pawn. Entries which are not given keep their value.
+         *
+         * \param [in,out]  in  The stream to read.
+         *
+         * \returns True if it succeeds, false if an entry is malformed.
+         */
+        bool load(std::istream& in);
+
+        /*!
+         * \fn  bool EvalParams::load(const std::string& filename);
+         *
+         * \brief   Loads parameters from a file
+         *
+         * \param   filename    The filename.
+         *
+         * \returns True if it succeeds, false if the file can not be read or an entry is malformed.
+         */
+        bool load(const std::string& filename);
+
+        /*!
+         * \fn  void EvalParams::save(std::ostream& out) const;
+         *
+         * \brief   Writes all parameters in the format read by load
+         *
+         * \param [in,out]  out The stream to write.
+         */
+        void save(std::ostream& out) const;
+    };
+}
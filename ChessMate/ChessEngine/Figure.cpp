@@ -103,10 +103,10 @@ namespace ChessNS
         _lastMoved        = board->currentMove();
         ++_nbrOfMovements;
 
-        board->at(destination).figure       = *this;
-        board->at(destination).empty        = false;
-        board->at(_previousPosition).empty  = true;
-        board->at(_previousPosition).figure = Figure();
+        // this figure lives on the previous field, so it must not be used after it was removed there
+        const auto previousPosition = _previousPosition;
+        board->placeFigure(destination, *this);
+        board->removeFigure(previousPosition);
     }
 
     bool Figure::isPathBlocked(const Position& position, Board* board) const
@@ -183,10 +183,7 @@ namespace ChessNS
                     result.addFlag(EventFlag::capture);
 
                     if (execute && result.isValid())
-                    {
-                        f.figure = Figure();
-                        f.empty  = true;
-                    }
+                        board->removeFigure(posShift);
                 }
             }
         }
@@ -240,7 +237,7 @@ namespace ChessNS
                 board->at(row, BoardColumn::cA).figure.nbrOfMovements() <= 0 &&
                 board->at(row, BoardColumn::cA).figure.getType() == FigureType::rook &&
                 board->at(row, BoardColumn::cA).figure.getColor() == _color &&
-                !board->isFieldUnderAttack(board->at(row, BoardColumn::cF), oppColor) &&
+                !board->isFieldUnderAttack(board->at(row, BoardColumn::cE), oppColor) &&
                 !board->isFieldUnderAttack(board->at(row, BoardColumn::cD), oppColor) &&
                 !board->isFieldUnderAttack(board->at(row, BoardColumn::cC), oppColor))
             {
@@ -295,7 +292,7 @@ namespace ChessNS
             result.addFlag(EventFlag::capture);
         }
 
-        if (execute)
+        if (execute && result.isValid())
             executeMove(destination, board);
 
         return result;
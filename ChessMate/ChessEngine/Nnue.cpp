@@ -0,0 +1,293 @@
+/*!
+* \brief:  Implements the efficiently updatable neural network
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "Nnue.h"
+#include <algorithm>
+#include <fstream>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CHESSMATE_X86_KERNELS
+#include <immintrin.h>
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define CHESSMATE_X86_KERNELS
+#include <immintrin.h>
+#include <intrin.h>
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+namespace ChessNS
+{
+    // The sums of the dense layers must stay in the range of int32, the kernels only differ in the order of the adds
+    static int32_t dotScalar(const int16_t* a, const int16_t* b, size_t size)
+    {
+        int32_t sum = 0;
+        for (size_t i = 0; i < size; i++)
+            sum += static_cast<int32_t>(a[i]) * b[i];
+        return sum;
+    }
+
+#ifdef CHESSMATE_X86_KERNELS
+    TARGET_SSE41 static int32_t dotSse41(const int16_t* a, const int16_t* b, size_t size)
+    {
+        auto sum = _mm_setzero_si128();
+        for (size_t i = 0; i < size; i += 8)
+        {
+            const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const auto y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            sum          = _mm_add_epi32(sum, _mm_madd_epi16(x, y));
+        }
+
+        sum = _mm_hadd_epi32(sum, sum);
+        sum = _mm_hadd_epi32(sum, sum);
+        return _mm_cvtsi128_si32(sum);
+    }
+
+    TARGET_AVX2 static int32_t dotAvx2(const int16_t* a, const int16_t* b, size_t size)
+    {
+        auto sum = _mm256_setzero_si256();
+        for (size_t i = 0; i < size; i += 16)
+        {
+            const auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const auto y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            sum          = _mm256_add_epi32(sum, _mm256_madd_epi16(x, y));
+        }
+
+        auto half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        half      = _mm_hadd_epi32(half, half);
+        half      = _mm_hadd_epi32(half, half);
+        return _mm_cvtsi128_si32(half);
+    }
+#endif
+
+    static bool supported(Nnue::Kernel kernel)
+    {
+        if (kernel == Nnue::Kernel::scalar)
+            return true;
+
+#if defined(CHESSMATE_X86_KERNELS) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        if (kernel == Nnue::Kernel::sse41)
+            return (info[2] & (1 << 19)) != 0;
+
+        // AVX2 also needs the operating system to save the ymm registers
+        const auto osxsave = (info[2] & (1 << 27)) != 0;
+        const auto avx     = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#elif defined(CHESSMATE_X86_KERNELS)
+        __builtin_cpu_init();
+        if (kernel == Nnue::Kernel::sse41)
+            return __builtin_cpu_supports("sse4.1") != 0;
+        return __builtin_cpu_supports("avx2") != 0;
+#else
+        return false;
+#endif
+    }
+
+    template <typename T>
+    static bool readValues(std::istream& in, std::vector<T>& values)
+    {
+        // the file is little endian like every supported platform
+        in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+        return static_cast<bool>(in);
+    }
+
+    template <typename T>
+    static void writeValues(std::ostream& out, const std::vector<T>& values)
+    {
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    static const char     magic[4] = {'C', 'M', 'N', 'N'};
+    static const uint32_t version  = 1;
+
+    // the kernels take 16 values at once and evaluate keeps both accumulators on the stack
+    static size_t validSize(size_t accumulatorSize)
+    {
+        if (accumulatorSize == 0)
+            return 16;
+        return accumulatorSize < Nnue::maxAccumulatorSize ? (accumulatorSize + 15) / 16 * 16 : Nnue::maxAccumulatorSize;
+    }
+
+    Nnue::Nnue(size_t accumulatorSize)
+        : featureWeights(featureCount * validSize(accumulatorSize)),
+          featureBiases(validSize(accumulatorSize)),
+          hiddenWeights(hiddenSize * 2 * validSize(accumulatorSize)),
+          hiddenBiases(hiddenSize),
+          outputWeights(hiddenSize),
+          _accumulatorSize(validSize(accumulatorSize)),
+          _kernel(Kernel::scalar),
+          _dot(dotScalar)
+    {
+        setKernel(detectKernel());
+    }
+
+    bool Nnue::load(std::istream& in)
+    {
+        char     header[4];
+        uint32_t fileVersion = 0;
+        uint32_t size        = 0;
+
+        in.read(header, sizeof(header));
+        in.read(reinterpret_cast<char*>(&fileVersion), sizeof(fileVersion));
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        if (!in || !std::equal(header, header + 4, magic) || fileVersion != version || size == 0 || size % 16 != 0
+            || size > maxAccumulatorSize)
+            return false;
+
+        Nnue network(size);
+        if (!readValues(in, network.featureWeights) || !readValues(in, network.featureBiases)
+            || !readValues(in, network.hiddenWeights) || !readValues(in, network.hiddenBiases)
+            || !readValues(in, network.outputWeights))
+            return false;
+
+        in.read(reinterpret_cast<char*>(&network.outputBias), sizeof(network.outputBias));
+        if (!in)
+            return false;
+
+        network.setKernel(_kernel);
+        *this = std::move(network);
+        return true;
+    }
+
+    bool Nnue::load(const std::string& filename)
+    {
+        std::ifstream in(filename, std::ios::binary);
+        if (!in)
+            return false;
+
+        return load(in);
+    }
+
+    void Nnue::save(std::ostream& out) const
+    {
+        const auto size = static_cast<uint32_t>(_accumulatorSize);
+
+        out.write(magic, sizeof(magic));
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        writeValues(out, featureWeights);
+        writeValues(out, featureBiases);
+        writeValues(out, hiddenWeights);
+        writeValues(out, hiddenBiases);
+        writeValues(out, outputWeights);
+        out.write(reinterpret_cast<const char*>(&outputBias), sizeof(outputBias));
+    }
+
+    size_t Nnue::accumulatorSize() const
+    {
+        return _accumulatorSize;
+    }
+
+    Nnue::Kernel Nnue::detectKernel()
+    {
+        static const auto best = supported(Kernel::avx2) ? Kernel::avx2 : supported(Kernel::sse41) ? Kernel::sse41 : Kernel::scalar;
+        return best;
+    }
+
+    void Nnue::setKernel(Kernel kernel)
+    {
+        _kernel = supported(kernel) ? kernel : Kernel::scalar;
+
+#ifdef CHESSMATE_X86_KERNELS
+        if (_kernel == Kernel::avx2)
+        {
+            _dot = dotAvx2;
+            return;
+        }
+        if (_kernel == Kernel::sse41)
+        {
+            _dot = dotSse41;
+            return;
+        }
+#endif
+        _dot = dotScalar;
+    }
+
+    Nnue::Kernel Nnue::kernel() const
+    {
+        return _kernel;
+    }
+
+    size_t Nnue::feature(Color perspective, int kingSquare, Color color, FigureType type, int square)
+    {
+        // black sees the board mirrored, so both perspectives share the weights
+        if (perspective == Color::black)
+        {
+            kingSquare ^= 56;
+            square ^= 56;
+        }
+
+        const auto figure = (static_cast<size_t>(type) - 2) * 2 + (color == perspective ? 0 : 1);
+        return (static_cast<size_t>(kingSquare) * 10 + figure) * 64 + static_cast<size_t>(square);
+    }
+
+    void Nnue::addFeature(size_t feature, int16_t* accumulator) const
+    {
+        const auto* weights = &featureWeights[feature * _accumulatorSize];
+        for (size_t i = 0; i < _accumulatorSize; i++)
+            accumulator[i] = static_cast<int16_t>(accumulator[i] + weights[i]);
+    }
+
+    void Nnue::removeFeature(size_t feature, int16_t* accumulator) const
+    {
+        const auto* weights = &featureWeights[feature * _accumulatorSize];
+        for (size_t i = 0; i < _accumulatorSize; i++)
+            accumulator[i] = static_cast<int16_t>(accumulator[i] - weights[i]);
+    }
+
+    void Nnue::resetAccumulator(int16_t* accumulator) const
+    {
+        std::copy(featureBiases.begin(), featureBiases.end(), accumulator);
+    }
+
+    int Nnue::evaluate(const int16_t* own, const int16_t* other) const
+    {
+        int16_t input[2 * maxAccumulatorSize];
+        int16_t hidden[hiddenSize];
+
+        for (size_t i = 0; i < _accumulatorSize; i++)
+        {
+            input[i]                    = std::max<int16_t>(0, std::min<int16_t>(own[i], 127));
+            input[_accumulatorSize + i] = std::max<int16_t>(0, std::min<int16_t>(other[i], 127));
+        }
+
+        for (size_t i = 0; i < hiddenSize; i++)
+        {
+            const auto sum = hiddenBiases[i] + _dot(input, &hiddenWeights[i * 2 * _accumulatorSize], 2 * _accumulatorSize);
+            hidden[i]      = static_cast<int16_t>(std::max(0, std::min(sum / hiddenDivisor, 127)));
+        }
+
+        return (outputBias + dotScalar(hidden, outputWeights.data(), hiddenSize)) / outputDivisor;
+    }
+}
@@ -0,0 +1,225 @@
+/*!
+* \brief:  Declares the efficiently updatable neural network
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   Nnue
+     *
+     * \brief   An efficiently updatable neural network for the evaluation. The input are HalfKP features, every
+     *          figure except the kings combined with the square of the king of a perspective. Each perspective
+     *          has an int16 accumulator of the first layer, which the board updates with every placed or removed
+     *          figure. A hidden layer of 32 neurons and the output neuron follow, their dot products run on the
+     *          best kernel of the CPU.
+     */
+    class Nnue
+    {
+    public:
+
+        /*! \brief   The number of input features, 64 king squares times 10 figures times 64 squares */
+        static constexpr size_t featureCount = 64 * 10 * 64;
+
+        /*! \brief   The number of neurons of the hidden layer */
+        static constexpr size_t hiddenSize = 32;
+
+        /*! \brief   The maximum size of an accumulator */
+        static constexpr size_t maxAccumulatorSize = 1024;
+
+        /*! \brief   The hidden layer sums are divided by this before they are clipped */
+        static constexpr int hiddenDivisor = 64;
+
+        /*! \brief   The output is divided by this to get centipawns */
+        static constexpr int outputDivisor = 16;
+
+        /*!
+         * \enum    Kernel
+         *
+         * \brief   Values that represent the implementations of the dense layers
+         */
+        enum class Kernel { scalar, sse41, avx2 };
+
+        /*!
+         * \fn  explicit Nnue::Nnue(size_t accumulatorSize = 256);
+         *
+         * \brief   Constructor, all weights are 0 and the kernel is the best one of the CPU
+         *
+         * \param   accumulatorSize (Optional) The size of an accumulator, it is rounded up to a multiple of 16 and
+         *                          limited to maxAccumulatorSize.
+         */
+        explicit Nnue(size_t accumulatorSize = 256);
+
+        /*!
+         * \fn  bool Nnue::load(std::istream& in);
+         *
+         * \brief   Loads the network in the format written by save: the magic "CMNN", the version 1 and the size of
+         *          the accumulator as little endian uint32, followed by the weights and biases of the layers.
+         *
+         * \param [in,out]  in  The binary stream to read.
+         *
+         * \returns True if it succeeds, false if the stream is not a network of this format.
+         */
+        bool load(std::istream& in);
+
+        /*!
+         * \fn  bool Nnue::load(const std::string& filename);
+         *
+         * \brief   Loads the network from a file
+         *
+         * \param   filename    The filename.
+         *
+         * \returns True if it succeeds, false if the file can not be read or is not a network.
+         */
+        bool load(const std::string& filename);
+
+        /*!
+         * \fn  void Nnue::save(std::ostream& out) const;
+         *
+         * \brief   Writes the network in the format read by load
+         *
+         * \param [in,out]  out The binary stream to write.
+         */
+        void save(std::ostream& out) const;
+
+        /*!
+         * \fn  size_t Nnue::accumulatorSize() const;
+         *
+         * \brief   Gets the size of an accumulator
+         *
+         * \returns The size.
+         */
+        size_t accumulatorSize() const;
+
+        /*!
+         * \fn  static Kernel Nnue::detectKernel();
+         *
+         * \brief   Detects the best kernel the CPU supports
+         *
+         * \returns The kernel.
+         */
+        static Kernel detectKernel();
+
+        /*!
+         * \fn  void Nnue::setKernel(Kernel kernel);
+         *
+         * \brief   Changes the kernel, a kernel the CPU does not support is replaced by the scalar one
+         *
+         * \param   kernel  The kernel.
+         */
+        void setKernel(Kernel kernel);
+
+        /*!
+         * \fn  Kernel Nnue::kernel() const;
+         *
+         * \brief   Gets the kernel in use
+         *
+         * \returns The kernel.
+         */
+        Kernel kernel() const;
+
+        /*!
+         * \fn  static size_t Nnue::feature(Color perspective, int kingSquare, Color color, FigureType type, int square);
+         *
+         * \brief   Gets the feature of a figure, the squares are mirrored for the black perspective
+         *
+         * \param   perspective The color whose king the feature belongs to.
+         * \param   kingSquare  The square of the king of the perspective.
+         * \param   color       The color of the figure.
+         * \param   type        The type of the figure, not the king.
+         * \param   square      The square of the figure.
+         *
+         * \returns The feature index.
+         */
+        static size_t feature(Color perspective, int kingSquare, Color color, FigureType type, int square);
+
+        /*!
+         * \fn  void Nnue::addFeature(size_t feature, int16_t* accumulator) const;
+         *
+         * \brief   Adds the weights of a feature to an accumulator
+         *
+         * \param           feature     The feature index.
+         * \param [in,out]  accumulator The accumulator.
+         */
+        void addFeature(size_t feature, int16_t* accumulator) const;
+
+        /*!
+         * \fn  void Nnue::removeFeature(size_t feature, int16_t* accumulator) const;
+         *
+         * \brief   Subtracts the weights of a feature from an accumulator
+         *
+         * \param           feature     The feature index.
+         * \param [in,out]  accumulator The accumulator.
+         */
+        void removeFeature(size_t feature, int16_t* accumulator) const;
+
+        /*!
+         * \fn  void Nnue::resetAccumulator(int16_t* accumulator) const;
+         *
+         * \brief   Sets an accumulator to the biases, the state without any features
+         *
+         * \param [out] accumulator The accumulator.
+         */
+        void resetAccumulator(int16_t* accumulator) const;
+
+        /*!
+         * \fn  int Nnue::evaluate(const int16_t* own, const int16_t* other) const;
+         *
+         * \brief   Runs the layers after the accumulators
+         *
+         * \param   own     The accumulator of the perspective of the color on turn.
+         * \param   other   The accumulator of the other perspective.
+         *
+         * \returns The score in centipawns from the view of the color on turn.
+         */
+        int evaluate(const int16_t* own, const int16_t* other) const;
+
+        /*! \brief   The weights of the first layer, featureCount rows of accumulatorSize */
+        std::vector<int16_t> featureWeights;
+        /*! \brief   The biases of the first layer */
+        std::vector<int16_t> featureBiases;
+        /*! \brief   The weights of the hidden layer, hiddenSize rows of both clipped accumulators */
+        std::vector<int16_t> hiddenWeights;
+        /*! \brief   The biases of the hidden layer */
+        std::vector<int32_t> hiddenBiases;
+        /*! \brief   The weights of the output neuron */
+        std::vector<int16_t> outputWeights;
+        /*! \brief   The bias of the output neuron */
+        int32_t outputBias{};
+
+    private:
+
+        size_t _accumulatorSize;
+        Kernel _kernel;
+        int32_t (*_dot)(const int16_t*, const int16_t*, size_t);
+    };
+}
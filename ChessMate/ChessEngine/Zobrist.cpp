@@ -0,0 +1,85 @@
+/*!
+* \brief:  Implements the Zobrist keys
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "Zobrist.h"
+
+namespace ChessNS
+{
+    struct Keys
+    {
+        Keys()
+        {
+            // a fixed seed, so the keys are the same in every run
+            uint64_t state = 0x9E3779B97F4A7C15ull;
+            for (auto& color : figures)
+                for (auto& type : color)
+                    for (auto& key : type)
+                        key = next(state);
+
+            side = next(state);
+            for (auto& key : castling)
+                key = next(state);
+            for (auto& key : enPassant)
+                key = next(state);
+        }
+
+        static uint64_t next(uint64_t& state)
+        {
+            // splitmix64
+            auto result = (state += 0x9E3779B97F4A7C15ull);
+            result      = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+            result      = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+            return result ^ (result >> 31);
+        }
+
+        uint64_t figures[2][7][64]{};
+        uint64_t side{};
+        uint64_t castling[4]{};
+        uint64_t enPassant[8]{};
+    };
+
+    static const Keys keys;
+
+    uint64_t Zobrist::figure(Color color, FigureType type, int square)
+    {
+        return keys.figures[color == Color::white ? 0 : 1][static_cast<size_t>(type)][square];
+    }
+
+    uint64_t Zobrist::side()
+    {
+        return keys.side;
+    }
+
+    uint64_t Zobrist::castling(Color color, bool kingSide)
+    {
+        return keys.castling[(color == Color::white ? 0 : 2) + (kingSide ? 0 : 1)];
+    }
+
+    uint64_t Zobrist::enPassant(int column)
+    {
+        return keys.enPassant[column];
+    }
+}
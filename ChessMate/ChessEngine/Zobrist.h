@@ -0,0 +1,87 @@
+/*!
+* \brief:  Declares the Zobrist keys
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include "ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   Zobrist
+     *
+     * \brief   Random keys which are combined by xor to a hash of a position.
+     */
+    class Zobrist
+    {
+    public:
+
+        /*!
+         * \fn  static uint64_t Zobrist::figure(Color color, FigureType type, int square);
+         *
+         * \brief   Gets the key of a figure on a square
+         *
+         * \param   color   The color of the figure.
+         * \param   type    The type of the figure.
+         * \param   square  The square index (0 to 63).
+         *
+         * \returns The key.
+         */
+        static uint64_t figure(Color color, FigureType type, int square);
+
+        /*!
+         * \fn  static uint64_t Zobrist::side();
+         *
+         * \brief   Gets the key which is added if black is on turn
+         *
+         * \returns The key.
+         */
+        static uint64_t side();
+
+        /*!
+         * \fn  static uint64_t Zobrist::castling(Color color, bool kingSide);
+         *
+         * \brief   Gets the key of a castling right
+         *
+         * \param   color       The color which may castle.
+         * \param   kingSide    True for the king side, false for the queen side.
+         *
+         * \returns The key.
+         */
+        static uint64_t castling(Color color, bool kingSide);
+
+        /*!
+         * \fn  static uint64_t Zobrist::enPassant(int column);
+         *
+         * \brief   Gets the key of a possible en passant capture
+         *
+         * \param   column  The column of the pawn which can be captured.
+         *
+         * \returns The key.
+         */
+        static uint64_t enPassant(int column);
+    };
+}
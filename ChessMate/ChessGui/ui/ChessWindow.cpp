@@ -2,6 +2,7 @@
 #include "./ui_ChessWindow.h"
 #include "ChessField.h"
 #include "ChessEngine/ChessTypes.h"
+#include "ChessPlayer/PlayerSearchAi.h"
 #include <QDebug>
 
 #include "PromotionChose.h"
@@ -37,7 +38,8 @@ ChessWindow::ChessWindow(QWidget* parent)
     _ui->graphicsView->setScene(_boardScene);
 
     _player = ChessNS::IPlayer::createPlayer(ChessNS::PlayerType::human, ChessNS::Color::white, _board);
-    _ai     = ChessNS::IPlayer::createPlayer(ChessNS::PlayerType::simpleAi, ChessNS::Color::black, _board);
+    _ai     = ChessNS::IPlayer::createPlayer(ChessNS::PlayerType::searchAi, ChessNS::Color::black, _board);
+    static_cast<ChessNS::PlayerSearchAi*>(_ai.get())->setPondering(true);
     connect(this, SIGNAL(requestRedraw()), this, SLOT(redraw()));
     drawBoard();
 }
@@ -26,15 +26,39 @@
 
 #include "ChessMate.h"
 
-int main()
+int main(int argc, char* argv[])
 {
     auto                             board = std::make_shared<ChessNS::Board>();
     auto                             white = ChessNS::IPlayer::createPlayer(ChessNS::PlayerType::human, ChessNS::Color::white, board);
-    auto                             black = ChessNS::IPlayer::createPlayer(ChessNS::PlayerType::simpleAi, ChessNS::Color::black, board);
+    auto                             black = ChessNS::IPlayer::createPlayer(ChessNS::PlayerType::searchAi, ChessNS::Color::black, board);
     std::string                      input;
     std::array<ChessNS::Position, 2> positions;
     ChessNS::Movement                movement;
 
+    // optional files: --network <file> replaces the evaluation of the computer, --book <file> adds an opening book
+    auto computer = static_cast<ChessNS::PlayerSearchAi*>(black.get());
+    computer->setPondering(true);
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string option = argv[i];
+        if (option == "--network")
+        {
+            auto network = std::make_shared<ChessNS::Nnue>();
+            if (network->load(argv[i + 1]))
+                computer->searchConfig().network = network;
+            else
+                std::cout << "Can not load the network " << argv[i + 1] << ", using the classic evaluation" << std::endl;
+        }
+        else if (option == "--book")
+        {
+            auto book = ChessNS::OpeningBook::open(argv[i + 1]);
+            if (book)
+                computer->setOpeningBook(book);
+            else
+                std::cout << "Can not open the book " << argv[i + 1] << std::endl;
+        }
+    }
+
     while (!board->hasEnded())
     {
         do
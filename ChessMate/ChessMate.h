@@ -31,6 +31,7 @@
 #include "ChessEngine/Board.h"
 #include "ChessEngine/Figure.h"
 #include "ChessPlayer/IPlayer.h"
+#include "ChessPlayer/PlayerSearchAi.h"
 #include "BasicUtils/StringHelper.h"
 
 int getRow(char r);
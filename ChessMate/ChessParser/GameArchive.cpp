@@ -0,0 +1,689 @@
+/*!
+* \brief:  Implements the game archive class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "GameArchive.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include "ChessEngine/Bitboard.h"
+#include "PgnParser.h"
+#include "PgnWriter.h"
+
+namespace ChessNS
+{
+    static const char     magic[4]  = {'C', 'M', 'G', 'A'};
+    static const uint32_t version   = 1;
+    static const size_t   blockSize = 1 << 16;
+
+    // magic, version and the number of games
+    static const size_t headerSize = 16;
+    // raw size, stored size and number of games of a block, its data follows
+    static const size_t blockHeaderSize = 12;
+    // the offset of the index and the number of blocks at the end of the file
+    static const size_t trailerSize = 16;
+    // the size of the pgn text of a part, which a thread converts at once
+    static const size_t partSize = 1 << 24;
+
+    namespace
+    {
+        void writeVarint(std::vector<unsigned char>& data, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                data.push_back(static_cast<unsigned char>(value | 0x80));
+                value >>= 7;
+            }
+            data.push_back(static_cast<unsigned char>(value));
+        }
+
+        bool readVarint(const unsigned char*& data, const unsigned char* end, uint64_t& value)
+        {
+            value = 0;
+            for (unsigned shift = 0; data != end && shift < 64; shift += 7)
+            {
+                const auto byte = *data++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        template <typename T>
+        void writeValue(std::vector<unsigned char>& data, T value)
+        {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        T readValue(const unsigned char* data)
+        {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        void writeLength(std::vector<unsigned char>& data, size_t length)
+        {
+            // a nibble which is full goes on in bytes until one is not full
+            for (length -= 15; length >= 255; length -= 255)
+                data.push_back(255);
+            data.push_back(static_cast<unsigned char>(length));
+        }
+
+        // A small LZ77 compression in the way of LZ4: a token with the number of literals and the length of the
+        // match, the literals and the distance of the match. The last sequence has literals only.
+        void compress(const unsigned char* input, size_t size, std::vector<unsigned char>& output)
+        {
+            const size_t minMatch = 4;
+            uint32_t     table[4096];
+            std::fill(std::begin(table), std::end(table), UINT32_MAX);
+
+            size_t literals = 0;
+            size_t position = 0;
+            auto   emit     = [&](size_t matchLength, size_t distance)
+            {
+                const auto literalCount = position - literals;
+                const auto matchCode    = matchLength >= minMatch ? matchLength - minMatch : 0;
+                output.push_back(static_cast<unsigned char>(std::min<size_t>(literalCount, 15) << 4 | std::min<size_t>(matchCode, 15)));
+                if (literalCount >= 15)
+                    writeLength(output, literalCount);
+                output.insert(output.end(), input + literals, input + position);
+                if (matchLength == 0)
+                    return;
+
+                output.push_back(static_cast<unsigned char>(distance));
+                output.push_back(static_cast<unsigned char>(distance >> 8));
+                if (matchCode >= 15)
+                    writeLength(output, matchCode);
+            };
+
+            while (position + minMatch <= size)
+            {
+                uint32_t sequence;
+                std::memcpy(&sequence, input + position, sizeof(sequence));
+                const auto slot      = (sequence * 2654435761u) >> 20;
+                const auto candidate = table[slot];
+                table[slot]          = static_cast<uint32_t>(position);
+
+                if (candidate == UINT32_MAX || position - candidate > 0xFFFF || std::memcmp(input + candidate, input + position, minMatch) != 0)
+                {
+                    position++;
+                    continue;
+                }
+
+                auto length = minMatch;
+                while (position + length < size && input[candidate + length] == input[position + length])
+                    length++;
+
+                emit(length, position - candidate);
+                position += length;
+                literals = position;
+            }
+
+            position = size;
+            emit(0, 0);
+        }
+
+        bool readLength(const unsigned char*& input, const unsigned char* end, size_t& length)
+        {
+            unsigned char byte;
+            do
+            {
+                if (input == end)
+                    return false;
+                byte = *input++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+        bool decompress(const unsigned char* input, size_t size, unsigned char* output, size_t outputSize)
+        {
+            const auto end      = input + size;
+            size_t     position = 0;
+            while (input != end)
+            {
+                const auto token        = *input++;
+                size_t     literalCount = token >> 4;
+                if ((literalCount == 15 && !readLength(input, end, literalCount))
+                    || static_cast<size_t>(end - input) < literalCount || outputSize - position < literalCount)
+                    return false;
+
+                std::memcpy(output + position, input, literalCount);
+                input += literalCount;
+                position += literalCount;
+                if (input == end)
+                    break;
+
+                if (end - input < 2)
+                    return false;
+                const size_t distance    = input[0] | input[1] << 8;
+                size_t       matchLength = token & 15;
+                input += 2;
+                if ((matchLength == 15 && !readLength(input, end, matchLength)) || distance == 0 || distance > position)
+                    return false;
+
+                // the match may overlap what it writes, so it is copied byte by byte
+                matchLength += 4;
+                if (outputSize - position < matchLength)
+                    return false;
+                for (size_t i = 0; i < matchLength; i++, position++)
+                    output[position] = output[position - distance];
+            }
+
+            return position == outputSize;
+        }
+
+        struct PackedBlock
+        {
+            std::vector<unsigned char> data;
+            uint64_t                   games;
+        };
+
+        void pack(std::vector<unsigned char>& raw, uint64_t games, std::vector<PackedBlock>& blocks)
+        {
+            PackedBlock block;
+            block.games = games;
+            writeValue(block.data, static_cast<uint32_t>(raw.size()));
+            writeValue(block.data, static_cast<uint32_t>(0));
+            writeValue(block.data, static_cast<uint32_t>(games));
+            compress(raw.data(), raw.size(), block.data);
+
+            // a block which does not get smaller is stored as it is
+            auto stored = block.data.size() - blockHeaderSize;
+            if (stored >= raw.size())
+            {
+                block.data.resize(blockHeaderSize);
+                block.data.insert(block.data.end(), raw.begin(), raw.end());
+                stored = raw.size();
+            }
+
+            const auto storedSize = static_cast<uint32_t>(stored);
+            std::memcpy(block.data.data() + 4, &storedSize, sizeof(storedSize));
+            blocks.push_back(std::move(block));
+            raw.clear();
+        }
+
+        bool isPromotion(Board& board, int from, int to)
+        {
+            return (to / 8 == 0 || to / 8 == 7) && board.at(BitboardHelper::position(from)).figure.getType() == FigureType::pawn;
+        }
+    }
+
+    bool GameArchive::encode(Board& board, Game& game, std::vector<unsigned char>& data)
+    {
+        const auto            start = data.size();
+        std::vector<uint16_t> legal;
+        size_t                made  = 0;
+        auto                  valid = true;
+
+        data.push_back(static_cast<unsigned char>(game.result));
+        writeVarint(data, game.header.size());
+        for (size_t i = 0; i < game.header.size(); i++)
+            for (auto text : {game.header.name(i), game.header.value(i)})
+            {
+                writeVarint(data, text.size());
+                data.insert(data.end(), text.begin(), text.end());
+            }
+
+        writeVarint(data, game.movements.size());
+        for (auto& parsed : game.movements)
+        {
+            auto resolved = parsed;
+            if (board.resolve(resolved) != ResolveResult::unique)
+            {
+                valid = false;
+                break;
+            }
+
+            const auto from   = BitboardHelper::square(resolved.origin());
+            const auto to     = BitboardHelper::square(resolved.destination());
+            const auto packed = static_cast<uint16_t>(from | to << 6);
+            board.getLegalMoves(legal);
+            const auto index = std::find(legal.begin(), legal.end(), packed) - legal.begin();
+            if (static_cast<size_t>(index) == legal.size())
+            {
+                valid = false;
+                break;
+            }
+
+            auto promotedTo = FigureType::none;
+            data.push_back(static_cast<unsigned char>(index));
+            if (isPromotion(board, from, to))
+            {
+                promotedTo = parsed.promotedTo() != FigureType::none ? parsed.promotedTo() : FigureType::queen;
+                data.push_back(static_cast<unsigned char>(promotedTo));
+            }
+
+            if (!board.makeMove(resolved.origin(), resolved.destination(), promotedTo).isValid())
+            {
+                valid = false;
+                break;
+            }
+            made++;
+        }
+
+        for (; made > 0; made--)
+            board.unmakeMove();
+
+        if (!valid)
+        {
+            data.resize(start);
+            return false;
+        }
+
+        // the length goes in front, so a reader can skip the record
+        std::vector<unsigned char> length;
+        writeVarint(length, data.size() - start);
+        data.insert(data.begin() + static_cast<std::ptrdiff_t>(start), length.begin(), length.end());
+        return true;
+    }
+
+    bool GameArchive::decode(Board& board, const unsigned char*& data, const unsigned char* end, Game& game)
+    {
+        game.movements.clear();
+        game.header.clear();
+
+        uint64_t length;
+        if (!readVarint(data, end, length) || static_cast<uint64_t>(end - data) < length || length == 0)
+            return false;
+
+        const auto            recordEnd = data + length;
+        std::vector<uint16_t> legal;
+        if (*data > static_cast<unsigned char>(GameResult::draw))
+            return false;
+        game.result = static_cast<GameResult>(*data++);
+
+        uint64_t tags;
+        if (!readVarint(data, recordEnd, tags))
+            return false;
+        for (uint64_t i = 0; i < tags; i++)
+        {
+            uint64_t nameSize;
+            uint64_t valueSize;
+            if (!readVarint(data, recordEnd, nameSize) || static_cast<uint64_t>(recordEnd - data) < nameSize)
+                return false;
+            const auto name = StringView(reinterpret_cast<const char*>(data), static_cast<size_t>(nameSize));
+            data += nameSize;
+            if (!readVarint(data, recordEnd, valueSize) || static_cast<uint64_t>(recordEnd - data) < valueSize)
+                return false;
+            game.header.add(name, StringView(reinterpret_cast<const char*>(data), static_cast<size_t>(valueSize)));
+            data += valueSize;
+        }
+
+        uint64_t plies;
+        auto     valid = readVarint(data, recordEnd, plies);
+        size_t   made  = 0;
+        for (uint64_t ply = 0; valid && ply < plies; ply++)
+        {
+            board.getLegalMoves(legal);
+            if (data == recordEnd || *data >= legal.size())
+            {
+                valid = false;
+                break;
+            }
+
+            const auto from       = legal[*data] & 63;
+            const auto to         = legal[*data++] >> 6;
+            auto       promotedTo = FigureType::none;
+            if (isPromotion(board, from, to))
+            {
+                if (data == recordEnd)
+                {
+                    valid = false;
+                    break;
+                }
+                promotedTo = static_cast<FigureType>(*data++);
+                if (promotedTo != FigureType::queen && promotedTo != FigureType::rook && promotedTo != FigureType::bishop
+                    && promotedTo != FigureType::knight)
+                {
+                    valid = false;
+                    break;
+                }
+            }
+
+            auto move = board.makeMove(BitboardHelper::position(from), BitboardHelper::position(to), promotedTo);
+            valid     = move.isValid();
+            if (valid)
+            {
+                game.movements.push_back(move);
+                made++;
+            }
+        }
+
+        for (; made > 0; made--)
+            board.unmakeMove();
+
+        valid = valid && data == recordEnd;
+        data  = recordEnd;
+        return valid;
+    }
+
+    bool GameArchive::fromPgn(const std::string& pgnFilename, const std::string& archiveFilename, unsigned threads, uint64_t* skipped)
+    {
+        MappedFile file;
+        if (!file.open(pgnFilename))
+            return false;
+
+        std::ofstream out(archiveFilename, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // every part becomes its own blocks, so the order of the games is kept. A round of parts is converted on the
+        // threads and written in order before the next one, which bounds the memory by the size of a round.
+        const auto            buffer = StringView(reinterpret_cast<const char*>(file.data()), file.size());
+        const size_t          round  = 4 * static_cast<size_t>(threads);
+        const auto            parts  = PgnParser::splitGames(buffer, std::max(round, file.size() / partSize + 1));
+        std::atomic<uint64_t> invalid{0};
+
+        std::vector<unsigned char> index;
+        uint64_t                   games  = 0;
+        uint64_t                   offset = headerSize;
+
+        // the number of games is known at the end
+        out.write(magic, sizeof(magic));
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&games), sizeof(games));
+
+        for (size_t first = 0; first < parts.size(); first += round)
+        {
+            const auto                            count = std::min(round, parts.size() - first);
+            std::vector<std::vector<PackedBlock>> blocks(count);
+            std::atomic<size_t>                   next{0};
+
+            auto work = [&]()
+            {
+                Board                      board;
+                PgnLexer                   lexer;
+                PgnParser                  parser;
+                Game                       game;
+                std::vector<unsigned char> raw;
+                for (auto part = next++; part < count; part = next++)
+                {
+                    uint64_t partGames = 0;
+                    lexer.reset(parts[first + part]);
+                    for (;;)
+                    {
+                        try
+                        {
+                            if (!parser.parseNextGame(lexer, game))
+                                break;
+                            if (!encode(board, game, raw))
+                            {
+                                invalid++;
+                                continue;
+                            }
+                        }
+                        catch (const std::out_of_range&)
+                        {
+                            invalid++;
+                            continue;
+                        }
+
+                        partGames++;
+                        if (raw.size() >= blockSize)
+                        {
+                            pack(raw, partGames, blocks[part]);
+                            partGames = 0;
+                        }
+                    }
+
+                    if (partGames > 0)
+                        pack(raw, partGames, blocks[part]);
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (unsigned i = 1; i < threads && i < count; i++)
+                workers.emplace_back(work);
+            work();
+            for (auto& worker : workers)
+                worker.join();
+
+            for (auto& part : blocks)
+                for (auto& block : part)
+                {
+                    writeValue(index, offset);
+                    writeValue(index, games);
+                    out.write(reinterpret_cast<const char*>(block.data.data()), static_cast<std::streamsize>(block.data.size()));
+                    offset += block.data.size();
+                    games += block.games;
+                }
+        }
+
+        if (skipped != nullptr)
+            *skipped = invalid;
+
+        const auto count = static_cast<uint64_t>(index.size() / sizeof(Block));
+        out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+        out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        out.seekp(sizeof(magic) + sizeof(version));
+        out.write(reinterpret_cast<const char*>(&games), sizeof(games));
+        return static_cast<bool>(out);
+    }
+
+    bool GameArchive::toPgn(const std::string& archiveFilename, const std::string& pgnFilename, unsigned threads)
+    {
+        GameArchive archive;
+        if (!archive.open(archiveFilename))
+            return false;
+
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // a round of blocks is formatted on the threads into one text per block, the texts are written in order
+        const size_t             round = 4 * static_cast<size_t>(threads);
+        std::vector<std::string> texts(round);
+        std::ofstream            out(pgnFilename, std::ios::binary | std::ios::trunc);
+        std::atomic<uint64_t>    games{0};
+        std::atomic<bool>        valid{true};
+
+        for (size_t first = 0; first < archive._blockCount && valid; first += round)
+        {
+            const auto          count = std::min(round, archive._blockCount - first);
+            std::atomic<size_t> next{0};
+
+            auto work = [&]()
+            {
+                Board                      board;
+                Game                       game;
+                std::vector<unsigned char> data;
+                std::string*               text = nullptr;
+                PgnWriter                  writer([&text](const char* part, size_t size)
+                                                  {
+                                                      text->append(part, size);
+                                                      return true;
+                                                  });
+
+                for (auto i = next++; i < count; i = next++)
+                {
+                    text = &texts[i];
+                    text->clear();
+                    if (!archive.unpack(first + i, data))
+                    {
+                        valid = false;
+                        continue;
+                    }
+
+                    const auto* current = data.data();
+                    const auto* end     = current + data.size();
+                    while (current != end)
+                    {
+                        if (!decode(board, current, end, game) || !writer.write(game))
+                        {
+                            valid = false;
+                            break;
+                        }
+                        games++;
+                    }
+                    writer.flush();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (unsigned i = 1; i < threads && i < count; i++)
+                workers.emplace_back(work);
+            work();
+            for (auto& worker : workers)
+                worker.join();
+
+            for (size_t i = 0; i < count; i++)
+                out.write(texts[i].data(), static_cast<std::streamsize>(texts[i].size()));
+        }
+
+        return valid && games == archive.size() && static_cast<bool>(out);
+    }
+
+    bool GameArchive::open(const std::string& filename)
+    {
+        _blocks      = nullptr;
+        _blockCount  = 0;
+        _games       = 0;
+        _cachedBlock = SIZE_MAX;
+        if (!_file.open(filename) || _file.size() < headerSize + trailerSize)
+            return false;
+
+        const auto* data        = _file.data();
+        const auto  size        = _file.size();
+        const auto  indexOffset = readValue<uint64_t>(data + size - trailerSize);
+        const auto  count       = readValue<uint64_t>(data + size - trailerSize + 8);
+        if (!std::equal(magic, magic + 4, reinterpret_cast<const char*>(data)) || readValue<uint32_t>(data + 4) != version
+            || indexOffset < headerSize || indexOffset + count * sizeof(Block) + trailerSize != size)
+        {
+            _file.close();
+            return false;
+        }
+
+        _blocks     = reinterpret_cast<const Block*>(data + indexOffset);
+        _blockCount = static_cast<size_t>(count);
+        _games      = readValue<uint64_t>(data + 8);
+        return true;
+    }
+
+    uint64_t GameArchive::size() const
+    {
+        return _games;
+    }
+
+    bool GameArchive::read(uint64_t index, Game& game)
+    {
+        if (index >= _games)
+            return false;
+
+        // the last block which starts before the game
+        const auto found = std::upper_bound(_blocks, _blocks + _blockCount, index,
+                                            [](uint64_t game, const Block& block) { return game < block.firstGame; });
+        const auto block = static_cast<size_t>(found - _blocks - 1);
+        if (block != _cachedBlock)
+        {
+            _cachedBlock = SIZE_MAX;
+            if (!unpack(block, _block))
+                return false;
+            _cachedBlock = block;
+        }
+
+        const auto* data = _block.data();
+        const auto* end  = data + _block.size();
+        for (auto skip = index - _blocks[block].firstGame; skip > 0; skip--)
+        {
+            uint64_t length;
+            if (!readVarint(data, end, length) || static_cast<uint64_t>(end - data) < length)
+                return false;
+            data += length;
+        }
+
+        return decode(_board, data, end, game);
+    }
+
+    uint64_t GameArchive::forEach(const std::function<void(uint64_t, Game&)>& callback, unsigned threads) const
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::atomic<size_t>   next{0};
+        std::atomic<uint64_t> games{0};
+        auto                  work = [&]()
+        {
+            Board                      board;
+            Game                       game;
+            std::vector<unsigned char> data;
+            for (auto block = next++; block < _blockCount; block = next++)
+            {
+                if (!unpack(block, data))
+                    continue;
+
+                const auto* current = data.data();
+                const auto* end     = current + data.size();
+                for (auto index = _blocks[block].firstGame; current != end && decode(board, current, end, game); index++)
+                {
+                    callback(index, game);
+                    games++;
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads && i < _blockCount; i++)
+            workers.emplace_back(work);
+        work();
+        for (auto& worker : workers)
+            worker.join();
+
+        return games;
+    }
+
+    bool GameArchive::unpack(size_t block, std::vector<unsigned char>& data) const
+    {
+        const auto  end    = block + 1 < _blockCount ? _blocks[block + 1].offset : static_cast<uint64_t>(reinterpret_cast<const unsigned char*>(_blocks) - _file.data());
+        const auto* header = _file.data() + _blocks[block].offset;
+        if (_blocks[block].offset + blockHeaderSize > end)
+            return false;
+
+        const auto rawSize    = readValue<uint32_t>(header);
+        const auto storedSize = readValue<uint32_t>(header + 4);
+        if (_blocks[block].offset + blockHeaderSize + storedSize != end)
+            return false;
+
+        data.resize(rawSize);
+        if (storedSize == rawSize)
+        {
+            std::copy(header + blockHeaderSize, header + blockHeaderSize + rawSize, data.begin());
+            return true;
+        }
+
+        return decompress(header + blockHeaderSize, storedSize, data.data(), rawSize);
+    }
+}
@@ -0,0 +1,172 @@
+/*!
+* \brief:  Declares the game archive class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "BasicUtils/MappedFile.h"
+#include "ChessEngine/Board.h"
+#include "ChessEngine/ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   GameArchive
+     *
+     * \brief   A compact binary file of games. A move is stored as its index in the list of legal moves of its
+     *          position, which is one byte and a second one for the figure of a promotion. The games are packed
+     *          with their tags into blocks of about 64 KiB which are compressed on their own, an index of the blocks
+     *          at the end of the file leads to any game.
+     */
+    class GameArchive
+    {
+    public:
+
+        /*!
+         * \fn  static bool GameArchive::fromPgn(const std::string& pgnFilename, const std::string& archiveFilename, unsigned threads = 0, uint64_t* skipped = nullptr);
+         *
+         * \brief   Converts a pgn file, its parts are read, replayed and compressed on a number of threads and
+         *          written a round of parts at a time
+         *
+         * \param           pgnFilename     The pgn filename.
+         * \param           archiveFilename The archive filename.
+         * \param           threads         (Optional) The number of threads, 0 for one per core.
+         * \param [out]     skipped         (Optional) The number of games which were skipped as they have invalid or
+         *                                  illegal moves.
+         *
+         * \returns True if it succeeds, false if the pgn file can not be read or the archive not be written.
+         */
+        static bool fromPgn(const std::string& pgnFilename, const std::string& archiveFilename, unsigned threads = 0, uint64_t* skipped = nullptr);
+
+        /*!
+         * \fn  static bool GameArchive::toPgn(const std::string& archiveFilename, const std::string& pgnFilename, unsigned threads = 0);
+         *
+         * \brief   Writes all games of an archive in order as pgn, the blocks are decoded and formatted on a number of
+         *          threads
+         *
+         * \param   archiveFilename The archive filename.
+         * \param   pgnFilename     The pgn filename.
+         * \param   threads         (Optional) The number of threads, 0 for one per core.
+         *
+         * \returns True if it succeeds, false if the archive is broken or the pgn file can not be written.
+         */
+        static bool toPgn(const std::string& archiveFilename, const std::string& pgnFilename, unsigned threads = 0);
+
+        /*!
+         * \fn  static bool GameArchive::encode(Board& board, Game& game, std::vector<unsigned char>& data);
+         *
+         * \brief   Appends the record of a game
+         *
+         * \param [in,out]  board   A board in the start position, it is in the start position again afterwards.
+         * \param [in,out]  game    The game as it was parsed.
+         * \param [in,out]  data    The data to append to.
+         *
+         * \returns True if it succeeds, false if a move is not legal. Nothing is appended then.
+         */
+        static bool encode(Board& board, Game& game, std::vector<unsigned char>& data);
+
+        /*!
+         * \fn  static bool GameArchive::decode(Board& board, const unsigned char*& data, const unsigned char* end, Game& game);
+         *
+         * \brief   Reads the record of a game
+         *
+         * \param [in,out]  board   A board in the start position, it is in the start position again afterwards.
+         * \param [in,out]  data    The data of the record, it is moved behind the record.
+         * \param           end     The end of the data.
+         * \param [out]     game    The game, its movements are the moves made on the board.
+         *
+         * \returns True if it succeeds, false if the record is broken.
+         */
+        static bool decode(Board& board, const unsigned char*& data, const unsigned char* end, Game& game);
+
+        /*!
+         * \fn  bool GameArchive::open(const std::string& filename);
+         *
+         * \brief   Maps an archive
+         *
+         * \param   filename    The filename.
+         *
+         * \returns True if it succeeds, false if the file is missing or broken.
+         */
+        bool open(const std::string& filename);
+
+        /*!
+         * \fn  uint64_t GameArchive::size() const;
+         *
+         * \brief   Gets the number of games
+         *
+         * \returns The number of games.
+         */
+        uint64_t size() const;
+
+        /*!
+         * \fn  bool GameArchive::read(uint64_t index, Game& game);
+         *
+         * \brief   Reads a game, the block of the last game read is kept
+         *
+         * \param           index   Zero-based index of the game.
+         * \param [out]     game    The game.
+         *
+         * \returns True if it succeeds, false if there is no such game or its block is broken.
+         */
+        bool read(uint64_t index, Game& game);
+
+        /*!
+         * \fn  uint64_t GameArchive::forEach(const std::function<void(uint64_t, Game&)>& callback, unsigned threads = 0) const;
+         *
+         * \brief   Reads all games on a number of threads, every thread takes the next block
+         *
+         * \param   callback    Called with the index of the game and the game, from several threads at once and not
+         *                      in order.
+         * \param   threads     (Optional) The number of threads, 0 for one per core.
+         *
+         * \returns The number of games read.
+         */
+        uint64_t forEach(const std::function<void(uint64_t, Game&)>& callback, unsigned threads = 0) const;
+
+    private:
+
+        struct Block
+        {
+            uint64_t offset;
+            uint64_t firstGame;
+        };
+
+        bool unpack(size_t block, std::vector<unsigned char>& data) const;
+
+        MappedFile                 _file;
+        const Block*               _blocks{};
+        size_t                     _blockCount{};
+        uint64_t                   _games{};
+        std::vector<unsigned char> _block;
+        size_t                     _cachedBlock{SIZE_MAX};
+        Board                      _board;
+    };
+}
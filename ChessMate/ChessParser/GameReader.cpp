@@ -0,0 +1,125 @@
+/*!
+* \brief:  Implements the game reader class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "GameReader.h"
+#include <stdexcept>
+
+namespace ChessNS
+{
+    GameReader::GameReader(StringView buffer)
+        : _lexer(buffer) { }
+
+    bool GameReader::open(const std::string& filename)
+    {
+        _games        = 0;
+        _invalidGames = 0;
+        _index        = PgnIndex();
+        _lexer.reset(StringView());
+        if (!_file.open(filename))
+            return false;
+
+        _lexer.reset(StringView(reinterpret_cast<const char*>(_file.data()), _file.size()));
+        return true;
+    }
+
+    bool GameReader::openIndexed(const std::string& filename, unsigned threads)
+    {
+        if (!open(filename))
+            return false;
+
+        const auto indexFilename = PgnIndex::filename(filename);
+        const auto pgn           = StringView(reinterpret_cast<const char*>(_file.data()), _file.size());
+        if (_index.open(indexFilename, pgn))
+            return true;
+
+        return PgnIndex::build(filename, indexFilename, threads) && _index.open(indexFilename, pgn);
+    }
+
+    const PgnIndex& GameReader::index() const
+    {
+        return _index;
+    }
+
+    bool GameReader::seek(size_t game)
+    {
+        if (game >= _index.size())
+            return false;
+
+        const auto offset = static_cast<size_t>(_index[game].offset);
+        _lexer.reset(StringView(reinterpret_cast<const char*>(_file.data()) + offset, _file.size() - offset));
+        _games = game;
+        return true;
+    }
+
+    void GameReader::setHeadersOnly(bool headersOnly)
+    {
+        _headersOnly = headersOnly;
+    }
+
+    bool GameReader::next()
+    {
+        if (_headersOnly)
+        {
+            _game.movements.clear();
+            if (!_parser.parseNextHeader(_lexer, _game.header))
+                return false;
+            _game.result = _game.header.result();
+            _games++;
+            return true;
+        }
+
+        for (;;)
+        {
+            try
+            {
+                if (!_parser.parseNextGame(_lexer, _game))
+                    return false;
+                _games++;
+                return true;
+            }
+            catch (const std::out_of_range&)
+            {
+                _invalidGames++;
+            }
+        }
+    }
+
+    const Game& GameReader::game() const
+    {
+        return _game;
+    }
+
+    uint64_t GameReader::games() const
+    {
+        return _games;
+    }
+
+    uint64_t GameReader::invalidGames() const
+    {
+        return _invalidGames;
+    }
+}
@@ -0,0 +1,165 @@
+/*!
+* \brief:  Declares the game reader class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include "BasicUtils/MappedFile.h"
+#include "BasicUtils/StringView.h"
+#include "ChessEngine/ChessTypes.h"
+#include "PgnLexer.h"
+#include "PgnIndex.h"
+#include "PgnParser.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   GameReader
+     *
+     * \brief   Reads the games of a pgn file or buffer one after another, so a whole database never has to be in
+     *          memory. The same game is reused for every game, games with an invalid move are skipped and counted.
+     */
+    class GameReader
+    {
+    public:
+
+        GameReader() = default;
+
+        /*!
+         * \fn  explicit GameReader::GameReader(StringView buffer);
+         *
+         * \brief   Constructor for a buffer which has to live longer than the reader
+         *
+         * \param   buffer  The buffer.
+         */
+        explicit GameReader(StringView buffer);
+
+        GameReader(const GameReader&) = delete;
+
+        GameReader& operator=(const GameReader&) = delete;
+
+        /*!
+         * \fn  bool GameReader::open(const std::string& filename);
+         *
+         * \brief   Maps a file and starts with its first game
+         *
+         * \param   filename    The filename.
+         *
+         * \returns True if it succeeds, false if the file can not be mapped.
+         */
+        bool open(const std::string& filename);
+
+        /*!
+         * \fn  bool GameReader::openIndexed(const std::string& filename, unsigned threads = 0);
+         *
+         * \brief   Maps a file and its index, an index which is missing or outdated is built first
+         *
+         * \param   filename    The filename of the pgn file.
+         * \param   threads     (Optional) The number of threads to build the index, 0 for one per core.
+         *
+         * \returns True if it succeeds, false if the file can not be mapped or the index not be built.
+         */
+        bool openIndexed(const std::string& filename, unsigned threads = 0);
+
+        /*!
+         * \fn  const PgnIndex& GameReader::index() const;
+         *
+         * \brief   Gets the index opened by openIndexed
+         *
+         * \returns The index, empty without openIndexed.
+         */
+        const PgnIndex& index() const;
+
+        /*!
+         * \fn  bool GameReader::seek(size_t game);
+         *
+         * \brief   Goes straight to a game of the index, the next call of next reads it
+         *
+         * \param   game    Zero-based index of the game.
+         *
+         * \returns True if it succeeds, false if there is no such game in the index.
+         */
+        bool seek(size_t game);
+
+        /*!
+         * \fn  void GameReader::setHeadersOnly(bool headersOnly);
+         *
+         * \brief   Reads only the headers of the games and skips their moves, the games have no movements and the
+         *          result of their Result tag
+         *
+         * \param   headersOnly True to read only the headers.
+         */
+        void setHeadersOnly(bool headersOnly);
+
+        /*!
+         * \fn  bool GameReader::next();
+         *
+         * \brief   Reads the next game, unfinished games are returned as well
+         *
+         * \returns True if a game was read, false at the end.
+         */
+        bool next();
+
+        /*!
+         * \fn  const Game& GameReader::game() const;
+         *
+         * \brief   Gets the last game read, it is overwritten by the next call of next
+         *
+         * \returns The game.
+         */
+        const Game& game() const;
+
+        /*!
+         * \fn  uint64_t GameReader::games() const;
+         *
+         * \brief   Gets the number of games read
+         *
+         * \returns The number of games.
+         */
+        uint64_t games() const;
+
+        /*!
+         * \fn  uint64_t GameReader::invalidGames() const;
+         *
+         * \brief   Gets the number of games skipped because of an invalid move
+         *
+         * \returns The number of invalid games.
+         */
+        uint64_t invalidGames() const;
+
+    private:
+
+        MappedFile _file;
+        PgnIndex   _index;
+        PgnLexer   _lexer;
+        PgnParser  _parser;
+        Game       _game;
+        uint64_t   _games{};
+        uint64_t   _invalidGames{};
+        bool       _headersOnly{};
+    };
+}
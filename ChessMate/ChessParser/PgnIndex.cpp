@@ -0,0 +1,177 @@
+/*!
+* \brief:  Implements the pgn index class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "PgnIndex.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "PgnParser.h"
+
+namespace ChessNS
+{
+    static const char     magic[4] = {'C', 'M', 'P', 'I'};
+    static const uint32_t version  = 2;
+
+    // magic, version, the size and the fingerprint of the pgn file and the number of games, the entries follow
+    // aligned to 8 bytes
+    static const size_t headerSize = 32;
+
+    // the bytes at each end of the pgn file which go into the fingerprint
+    static const size_t fingerprintSize = 4096;
+
+    // The hashes of the head and the tail of a pgn file, an edit which keeps the size of the file most likely
+    // changes one of them, like a result or a tag fixed at the end of a database
+    static uint64_t fingerprint(StringView pgn)
+    {
+        const auto length = std::min(pgn.size(), fingerprintSize);
+        return (static_cast<uint64_t>(PgnIndex::hash(pgn.substr(0, length))) << 32) | PgnIndex::hash(pgn.substr(pgn.size() - length));
+    }
+
+    static_assert(sizeof(PgnIndexEntry) == 32, "the entries are written as they are");
+
+    bool PgnIndex::build(const std::string& pgnFilename, const std::string& indexFilename, unsigned threads)
+    {
+        MappedFile file;
+        if (!file.open(pgnFilename))
+            return false;
+
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        const auto                              buffer = StringView(reinterpret_cast<const char*>(file.data()), file.size());
+        const auto                              parts  = PgnParser::splitGames(buffer, 4 * threads);
+        std::vector<std::vector<PgnIndexEntry>> entries(parts.size());
+        std::atomic<size_t>                     next{0};
+
+        auto work = [&]()
+        {
+            PgnLexer   lexer;
+            PgnParser  parser;
+            GameHeader header;
+            for (auto part = next++; part < parts.size(); part = next++)
+            {
+                lexer.reset(parts[part]);
+                for (auto token = lexer.peek(); token.type != PgnTokenType::end; token = lexer.peek())
+                {
+                    if (!parser.parseNextHeader(lexer, header))
+                        break;
+
+                    // a game ends where the next one starts
+                    PgnIndexEntry entry{};
+                    entry.offset   = static_cast<uint64_t>(token.text.data() - buffer.data());
+                    entry.length   = static_cast<uint32_t>(parts[part].data() + lexer.offset() - token.text.data());
+                    entry.white    = hash(header.white());
+                    entry.black    = hash(header.black());
+                    entry.event    = hash(header.event());
+                    entry.whiteElo = static_cast<uint16_t>(std::min(header.whiteElo(), 65535u));
+                    entry.blackElo = static_cast<uint16_t>(std::min(header.blackElo(), 65535u));
+                    entry.result   = static_cast<uint8_t>(header.result());
+                    entries[part].push_back(entry);
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads && i < parts.size(); i++)
+            workers.emplace_back(work);
+        work();
+        for (auto& worker : workers)
+            worker.join();
+
+        uint64_t count = 0;
+        for (auto& part : entries)
+            count += part.size();
+
+        const uint64_t size  = file.size();
+        const uint64_t print = fingerprint(buffer);
+        std::ofstream  out(indexFilename, std::ios::binary | std::ios::trunc);
+        out.write(magic, sizeof(magic));
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        out.write(reinterpret_cast<const char*>(&print), sizeof(print));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        for (auto& part : entries)
+            out.write(reinterpret_cast<const char*>(part.data()), static_cast<std::streamsize>(part.size() * sizeof(PgnIndexEntry)));
+        return static_cast<bool>(out);
+    }
+
+    bool PgnIndex::open(const std::string& indexFilename, StringView pgn)
+    {
+        _entries = nullptr;
+        _size    = 0;
+        if (!_file.open(indexFilename) || _file.size() < headerSize)
+            return false;
+
+        const auto* data = _file.data();
+        uint32_t    fileVersion;
+        uint64_t    size;
+        uint64_t    print;
+        uint64_t    count;
+        std::copy(data + 4, data + 8, reinterpret_cast<unsigned char*>(&fileVersion));
+        std::copy(data + 8, data + 16, reinterpret_cast<unsigned char*>(&size));
+        std::copy(data + 16, data + 24, reinterpret_cast<unsigned char*>(&print));
+        std::copy(data + 24, data + 32, reinterpret_cast<unsigned char*>(&count));
+        if (!std::equal(magic, magic + 4, reinterpret_cast<const char*>(data)) || fileVersion != version || size != pgn.size()
+            || print != fingerprint(pgn) || _file.size() != headerSize + count * sizeof(PgnIndexEntry))
+        {
+            _file.close();
+            return false;
+        }
+
+        _entries = reinterpret_cast<const PgnIndexEntry*>(data + headerSize);
+        _size    = static_cast<size_t>(count);
+        return true;
+    }
+
+    size_t PgnIndex::size() const
+    {
+        return _size;
+    }
+
+    const PgnIndexEntry& PgnIndex::operator[](size_t game) const
+    {
+        return _entries[game];
+    }
+
+    uint32_t PgnIndex::hash(StringView text)
+    {
+        uint32_t result = 2166136261u;
+        for (const auto c : text)
+        {
+            result ^= static_cast<unsigned char>(c);
+            result *= 16777619u;
+        }
+        return result;
+    }
+
+    std::string PgnIndex::filename(const std::string& pgnFilename)
+    {
+        return pgnFilename + ".cmpi";
+    }
+}
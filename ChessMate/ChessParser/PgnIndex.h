@@ -0,0 +1,150 @@
+/*!
+* \brief:  Declares the pgn index class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "BasicUtils/MappedFile.h"
+#include "BasicUtils/StringView.h"
+#include "ChessEngine/ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \struct  PgnIndexEntry
+     *
+     * \brief   The place and the most wanted tags of a game in a pgn file, as it is stored in an index file
+     */
+    struct PgnIndexEntry
+    {
+        /*! \brief   The byte offset of the game in the pgn file */
+        uint64_t offset;
+        /*! \brief   The length of the game in bytes, up to the next game */
+        uint32_t length;
+        /*! \brief   The hash of the White tag, see PgnIndex::hash */
+        uint32_t white;
+        /*! \brief   The hash of the Black tag */
+        uint32_t black;
+        /*! \brief   The hash of the Event tag */
+        uint32_t event;
+        /*! \brief   The WhiteElo tag */
+        uint16_t whiteElo;
+        /*! \brief   The BlackElo tag */
+        uint16_t blackElo;
+        /*! \brief   The GameResult of the Result tag */
+        uint8_t result;
+        /*! \brief   Unused, keeps the size */
+        uint8_t reserved[3];
+    };
+
+    /*!
+     * \class   PgnIndex
+     *
+     * \brief   An index file next to a pgn file with an entry for every game, so any game can be read without
+     *          parsing the games before it. The index is mapped, opening it takes no time beyond that.
+     */
+    class PgnIndex
+    {
+    public:
+
+        /*!
+         * \fn  static bool PgnIndex::build(const std::string& pgnFilename, const std::string& indexFilename, unsigned threads = 0);
+         *
+         * \brief   Builds the index of a pgn file. The file is split into parts which are read on a number of
+         *          threads, only the tags are parsed and the movetext is skipped. The games have to start with a tag.
+         *
+         * \param   pgnFilename     The pgn filename.
+         * \param   indexFilename   The index filename.
+         * \param   threads         (Optional) The number of threads, 0 for one per core.
+         *
+         * \returns True if it succeeds, false if the pgn file can not be read or the index not be written.
+         */
+        static bool build(const std::string& pgnFilename, const std::string& indexFilename, unsigned threads = 0);
+
+        /*!
+         * \fn  bool PgnIndex::open(const std::string& indexFilename, StringView pgn);
+         *
+         * \brief   Maps an index file
+         *
+         * \param   indexFilename   The index filename.
+         * \param   pgn             The text of the pgn file, an index of a file with another size or another hash
+         *                          of the head and the tail is outdated.
+         *
+         * \returns True if it succeeds, false if the file is missing, broken or outdated.
+         */
+        bool open(const std::string& indexFilename, StringView pgn);
+
+        /*!
+         * \fn  size_t PgnIndex::size() const;
+         *
+         * \brief   Gets the number of games
+         *
+         * \returns The number of games.
+         */
+        size_t size() const;
+
+        /*!
+         * \fn  const PgnIndexEntry& PgnIndex::operator[](size_t game) const;
+         *
+         * \brief   Gets the entry of a game
+         *
+         * \param   game    Zero-based index of the game.
+         *
+         * \returns The entry.
+         */
+        const PgnIndexEntry& operator[](size_t game) const;
+
+        /*!
+         * \fn  static uint32_t PgnIndex::hash(StringView text);
+         *
+         * \brief   Hashes a tag value like the index does it, so entries can be compared without reading the game
+         *
+         * \param   text    The text.
+         *
+         * \returns The hash, FNV-1a with 32 bits.
+         */
+        static uint32_t hash(StringView text);
+
+        /*!
+         * \fn  static std::string PgnIndex::filename(const std::string& pgnFilename);
+         *
+         * \brief   Gets the name of the index file of a pgn file
+         *
+         * \param   pgnFilename The pgn filename.
+         *
+         * \returns The pgn filename with the extension .cmpi appended.
+         */
+        static std::string filename(const std::string& pgnFilename);
+
+    private:
+
+        MappedFile           _file;
+        const PgnIndexEntry* _entries{};
+        size_t               _size{};
+    };
+}
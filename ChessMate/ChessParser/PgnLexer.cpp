@@ -0,0 +1,278 @@
+/*!
+* \brief:  Implements the pgn lexer class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "PgnLexer.h"
+#include <cstring>
+
+namespace ChessNS
+{
+    namespace
+    {
+        enum CharClass : unsigned char { other, space, newline, symbolStart, symbolContinue };
+
+        // the character classes by a table, so the hot loops have no branches on ranges
+        struct CharClasses
+        {
+            CharClass classes[256]{};
+
+            CharClasses()
+            {
+                for (auto c : {' ', '\t', '\r', '\v', '\f'})
+                    classes[static_cast<unsigned char>(c)] = space;
+                classes[static_cast<unsigned char>('\n')] = newline;
+
+                for (int c = 0; c < 256; c++)
+                    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+                        classes[c] = symbolStart;
+
+                for (auto c : {'_', '+', '#', '=', ':', '-', '/'})
+                    classes[static_cast<unsigned char>(c)] = symbolContinue;
+            }
+        };
+
+        const CharClasses charClasses;
+
+        CharClass classOf(char c)
+        {
+            return charClasses.classes[static_cast<unsigned char>(c)];
+        }
+    }
+
+    PgnLexer::PgnLexer(StringView buffer)
+    {
+        reset(buffer);
+    }
+
+    bool PgnLexer::open(const std::string& filename)
+    {
+        MappedFile file;
+        if (!file.open(filename))
+            return false;
+
+        reset(StringView(reinterpret_cast<const char*>(file.data()), file.size()));
+        _file = std::move(file);
+        return true;
+    }
+
+    void PgnLexer::reset(StringView buffer)
+    {
+        _file.close();
+        _begin   = buffer.data();
+        _current = _begin;
+        _end     = _begin + buffer.size();
+        _line    = 1;
+
+        // a byte order mark is no token
+        if (buffer.startsWith("\xEF\xBB\xBF"))
+            _current += 3;
+
+        if (_current != _end && *_current == '%')
+        {
+            const auto newline = static_cast<const char*>(std::memchr(_current, '\n', static_cast<size_t>(_end - _current)));
+            _current           = newline ? newline : _end;
+        }
+    }
+
+    PgnToken PgnLexer::next()
+    {
+        skipWhitespace();
+
+        PgnToken token;
+        token.line = _line;
+        if (_current == _end)
+        {
+            token.text = StringView(_current, 0);
+            return token;
+        }
+
+        const auto start = _current;
+        const auto c     = *_current++;
+        switch (c)
+        {
+            case '.': token.type = PgnTokenType::period;
+                break;
+            case '*': token.type = PgnTokenType::asterisk;
+                break;
+            case '[': token.type = PgnTokenType::leftBracket;
+                break;
+            case ']': token.type = PgnTokenType::rightBracket;
+                break;
+            case '(': token.type = PgnTokenType::leftParenthesis;
+                break;
+            case ')': token.type = PgnTokenType::rightParenthesis;
+                break;
+            case '"':
+            {
+                // up to the next quote which is not escaped
+                while (_current != _end && *_current != '"' && *_current != '\n')
+                    _current += *_current == '\\' && _current + 1 != _end ? 2 : 1;
+
+                token.type = PgnTokenType::string;
+                token.text = StringView(start + 1, static_cast<size_t>(_current - start - 1));
+                if (_current != _end && *_current == '"')
+                    ++_current;
+                return token;
+            }
+            case '{':
+            {
+                const auto close = static_cast<const char*>(std::memchr(_current, '}', static_cast<size_t>(_end - _current)));
+                const auto stop  = close ? close : _end;
+                for (auto it = _current; it != stop; ++it)
+                    _line += *it == '\n';
+
+                token.type = PgnTokenType::comment;
+                token.text = StringView(_current, static_cast<size_t>(stop - _current));
+                _current   = close ? close + 1 : _end;
+                return token;
+            }
+            case ';':
+            {
+                const auto newline = static_cast<const char*>(std::memchr(_current, '\n', static_cast<size_t>(_end - _current)));
+                const auto stop    = newline ? newline : _end;
+
+                token.type = PgnTokenType::comment;
+                token.text = StringView(_current, static_cast<size_t>(stop - _current));
+                _current   = stop;
+                return token;
+            }
+            case '$':
+            {
+                while (_current != _end && *_current >= '0' && *_current <= '9')
+                    ++_current;
+
+                token.type = PgnTokenType::nag;
+                token.text = StringView(start + 1, static_cast<size_t>(_current - start - 1));
+                return token;
+            }
+            default:
+            {
+                if (classOf(c) != symbolStart)
+                {
+                    token.type = PgnTokenType::invalid;
+                    break;
+                }
+
+                auto digits = c >= '0' && c <= '9';
+                while (_current != _end && classOf(*_current) >= symbolStart)
+                {
+                    digits = digits && *_current >= '0' && *_current <= '9';
+                    ++_current;
+                }
+
+                token.type = digits ? PgnTokenType::integer : PgnTokenType::symbol;
+                break;
+            }
+        }
+
+        token.text = StringView(start, static_cast<size_t>(_current - start));
+        return token;
+    }
+
+    PgnToken PgnLexer::peek()
+    {
+        const auto current = _current;
+        const auto line    = _line;
+        const auto token   = next();
+        _current           = current;
+        _line              = line;
+        return token;
+    }
+
+    void PgnLexer::rewind(const PgnToken& token)
+    {
+        _current = token.text.data();
+        _line    = token.line;
+    }
+
+    StringView PgnLexer::buffer() const
+    {
+        return StringView(_begin, static_cast<size_t>(_end - _begin));
+    }
+
+    size_t PgnLexer::offset() const
+    {
+        return static_cast<size_t>(_current - _begin);
+    }
+
+    size_t PgnLexer::line() const
+    {
+        return _line;
+    }
+
+    void PgnLexer::skipMovetext()
+    {
+        // only lines and braces matter, so the text is searched instead of read character by character
+        while (_current != _end)
+        {
+            const auto size    = static_cast<size_t>(_end - _current);
+            const auto newline = static_cast<const char*>(std::memchr(_current, '\n', size));
+            const auto lineEnd = newline ? newline : _end;
+            const auto brace   = static_cast<const char*>(std::memchr(_current, '{', static_cast<size_t>(lineEnd - _current)));
+            if (brace)
+            {
+                const auto close = static_cast<const char*>(std::memchr(brace, '}', static_cast<size_t>(_end - brace)));
+                _current         = close ? close + 1 : _end;
+                for (auto c = brace; c != _current; ++c)
+                    _line += *c == '\n' ? 1 : 0;
+                continue;
+            }
+
+            _current = lineEnd;
+            if (_current == _end)
+                break;
+
+            ++_current;
+            ++_line;
+            if (_current != _end && *_current == '[')
+                break;
+        }
+    }
+
+    void PgnLexer::skipWhitespace()
+    {
+        while (_current != _end)
+        {
+            const auto type = classOf(*_current);
+            if (type == space)
+                ++_current;
+            else if (type == newline)
+            {
+                ++_current;
+                ++_line;
+
+                // an escape line is ignored completely
+                if (_current != _end && *_current == '%')
+                {
+                    const auto newline = static_cast<const char*>(std::memchr(_current, '\n', static_cast<size_t>(_end - _current)));
+                    _current           = newline ? newline : _end;
+                }
+            }
+            else
+                break;
+        }
+    }
+}
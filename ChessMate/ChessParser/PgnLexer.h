@@ -0,0 +1,192 @@
+/*!
+* \brief:  Declares the pgn lexer class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include "BasicUtils/MappedFile.h"
+#include "BasicUtils/StringView.h"
+
+namespace ChessNS
+{
+    /*!
+     * \enum    PgnTokenType
+     *
+     * \brief   The tokens of the pgn standard, section 7.
+     */
+    enum class PgnTokenType
+    {
+        end,
+        symbol,
+        string,
+        integer,
+        period,
+        asterisk,
+        leftBracket,
+        rightBracket,
+        leftParenthesis,
+        rightParenthesis,
+        nag,
+        comment,
+        invalid
+    };
+
+    /*!
+     * \struct  PgnToken
+     *
+     * \brief   A token, the text points into the buffer of the lexer.
+     */
+    struct PgnToken
+    {
+        /*! \brief   The type */
+        PgnTokenType type{PgnTokenType::end};
+        /*! \brief   The text, without the quotes of a string, the braces of a comment and the dollar of a nag */
+        StringView text{};
+        /*! \brief   The line of the first character, starting with 1 */
+        size_t line{};
+    };
+
+    /*!
+     * \class   PgnLexer
+     *
+     * \brief   Splits pgn text into tokens without copying or allocating, the text of a token is a view into a
+     *          mapped file or a buffer of the caller. Escape lines starting with a percent sign are skipped, the
+     *          escaped quotes and backslashes of a string are left in its text.
+     */
+    class PgnLexer
+    {
+    public:
+
+        PgnLexer() = default;
+
+        /*!
+         * \fn  explicit PgnLexer::PgnLexer(StringView buffer);
+         *
+         * \brief   Constructor for a buffer which has to live longer than the lexer and its tokens
+         *
+         * \param   buffer  The buffer.
+         */
+        explicit PgnLexer(StringView buffer);
+
+        PgnLexer(const PgnLexer&) = delete;
+
+        PgnLexer& operator=(const PgnLexer&) = delete;
+
+        /*!
+         * \fn  bool PgnLexer::open(const std::string& filename);
+         *
+         * \brief   Maps a file and starts at its beginning, the tokens live as long as the lexer
+         *
+         * \param   filename    The filename.
+         *
+         * \returns True if it succeeds, false if the file can not be mapped.
+         */
+        bool open(const std::string& filename);
+
+        /*!
+         * \fn  void PgnLexer::reset(StringView buffer);
+         *
+         * \brief   Starts again with another buffer, a mapped file is closed
+         *
+         * \param   buffer  The buffer.
+         */
+        void reset(StringView buffer);
+
+        /*!
+         * \fn  PgnToken PgnLexer::next();
+         *
+         * \brief   Reads the next token
+         *
+         * \returns The PgnToken, PgnTokenType::end at the end of the buffer.
+         */
+        PgnToken next();
+
+        /*!
+         * \fn  PgnToken PgnLexer::peek();
+         *
+         * \brief   Gets the next token without consuming it
+         *
+         * \returns The PgnToken.
+         */
+        PgnToken peek();
+
+        /*!
+         * \fn  void PgnLexer::rewind(const PgnToken& token);
+         *
+         * \brief   Goes back to a token, so it is read again. Strings, comments and nags can not be rewound as
+         *          their text does not start at their first character.
+         *
+         * \param   token   The token, it has to be from this lexer.
+         */
+        void rewind(const PgnToken& token);
+
+        /*!
+         * \fn  void PgnLexer::skipMovetext();
+         *
+         * \brief   Skips to the next line starting with a tag without reading tokens, brace comments are skipped as a
+         *          whole. Games without tags can not be told apart this way.
+         */
+        void skipMovetext();
+
+        /*!
+         * \fn  StringView PgnLexer::buffer() const;
+         *
+         * \brief   Gets the whole buffer
+         *
+         * \returns The buffer.
+         */
+        StringView buffer() const;
+
+        /*!
+         * \fn  size_t PgnLexer::offset() const;
+         *
+         * \brief   Gets the offset of the next character in the buffer
+         *
+         * \returns The offset.
+         */
+        size_t offset() const;
+
+        /*!
+         * \fn  size_t PgnLexer::line() const;
+         *
+         * \brief   Gets the line of the next character
+         *
+         * \returns The line, starting with 1.
+         */
+        size_t line() const;
+
+    private:
+
+        void skipWhitespace();
+
+        MappedFile  _file;
+        const char* _begin{};
+        const char* _current{};
+        const char* _end{};
+        size_t      _line{1};
+    };
+}
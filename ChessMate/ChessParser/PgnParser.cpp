@@ -26,7 +26,13 @@
 
 #include "PgnParser.h"
 #include "BasicUtils/StringHelper.h"
+#include "SanDecoder.h"
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <iterator>
+#include <thread>
+#include <stdexcept>
 #include <string>
 
 namespace ChessNS
@@ -44,9 +50,26 @@ namespace ChessNS
         {
             if (!foundStart)
             {
-                if (line.substr(0, 2) != "1.")
+                // a byte order mark is not part of the first tag
+                if (line.compare(0, 3, "\xEF\xBB\xBF") == 0)
+                    line.erase(0, 3);
+
+                const auto first = line.find_first_not_of(" \t\r");
+                if (first == std::string::npos || line[first] == '%')
                     continue;
 
+                if (line[first] == '[')
+                {
+                    PgnLexer   lexer(line);
+                    const auto bracket = lexer.next();
+                    const auto name    = lexer.next();
+                    const auto value   = lexer.next();
+                    if (bracket.type == PgnTokenType::leftBracket && name.type == PgnTokenType::symbol
+                        && value.type == PgnTokenType::string)
+                        result.header.add(name.text, value.text);
+                    continue;
+                }
+
                 foundStart = true;
             }
 
@@ -75,8 +98,8 @@ namespace ChessNS
                     continue;
                 }
 
-                // round Counter
-                const auto point = it->find(".");
+                // round Counter, black moves may follow three periods
+                const auto point = it->rfind('.');
                 if (point != std::string::npos)
                 {
                     if (it->length() == point + 1)
@@ -85,7 +108,17 @@ namespace ChessNS
                     *it = it->substr(point + 1);
                 }
 
-                result.movements.emplace_back(parseMovement(*it, moveCounter / 2 + 1, moveCounter, moveCounter % 2 == 0 ? Color::black : Color::white));
+                try
+                {
+                    result.movements.emplace_back(parseMovement(*it, moveCounter / 2 + 1, moveCounter, moveCounter % 2 == 0 ? Color::black : Color::white));
+                }
+                catch (const std::out_of_range&)
+                {
+                    // the rest of a broken game must not be taken for the next game
+                    if (std::none_of(std::next(it), splittedLine.end(), [this](const std::string& token) { return _possibleResults.count(token) != 0; }))
+                        skipGame(in);
+                    throw;
+                }
                 moveCounter++;
             }
         }
@@ -93,6 +126,15 @@ namespace ChessNS
         return result;
     }
 
+    void PgnParser::skipGame(std::istream& in) const
+    {
+        std::string line;
+        while (in.peek() != '[' && std::getline(in, line))
+            for (const auto& token : StringHelper::split(line, ' '))
+                if (_possibleResults.count(token) != 0)
+                    return;
+    }
+
     Game PgnParser::parseSingleGame(const std::string& filename)
     {
         std::ifstream in(filename);
@@ -115,98 +157,328 @@ namespace ChessNS
         return result;
     }
 
-    Movement PgnParser::parseMovement(std::string& move, unsigned roundCounter, unsigned moveCounter, Color color)
+    namespace
     {
-        Movement movement;
-        movement.moveResult() = MoveResult::valid;
-        movement.color()      = color;
-        movement.round()      = roundCounter;
-
-        // Castling
-        if (move == "O-O")
+        // collects the moves and the result into a game
+        class GameCollector : public PgnVisitor
         {
-            movement.figureType()  = FigureType::king;
-            movement.destination() = color == Color::white ? Position(BoardRow::r1, BoardColumn::cG) : Position(BoardRow::r8, BoardColumn::cG);
-            movement.addFlag(EventFlag::castling);
-            if (move.length() == 3)
-                return movement;
+        public:
+            explicit GameCollector(Game& game)
+                : _game(game) { }
 
-            move = move.substr(3);
-        }
+            void onGameStart() override
+            {
+                _game.result = GameResult::none;
+                _game.movements.clear();
+                _game.header.clear();
+            }
 
-        else if (move == "O-O-O")
-        {
-            movement.figureType()  = FigureType::king;
-            movement.destination() = color == Color::white ? Position(BoardRow::r1, BoardColumn::cC) : Position(BoardRow::r8, BoardColumn::cC);
-            movement.addFlag(EventFlag::castling);
-            if (move.length() == 5)
-                return movement;
-            move = move.substr(5);
-        }
+            void onTag(StringView name, StringView value) override
+            {
+                _game.header.add(name, value);
+            }
+
+            void onMove(const Movement& movement) override
+            {
+                _game.movements.push_back(movement);
+            }
+
+            void onResult(GameResult result) override
+            {
+                _game.result = result;
+            }
 
-        else
+        private:
+            Game& _game;
+        };
+    }
+
+    bool PgnParser::visitNextGame(PgnLexer& lexer, PgnVisitor& visitor)
+    {
+        unsigned moveCounter = 1;
+        unsigned variations  = 0;
+        auto     found       = false;
+
+        for (auto token = lexer.next(); token.type != PgnTokenType::end; token = lexer.next())
         {
-            // type
-            if (_figureTypes.find(move[0]) != _figureTypes.end())
+            if (!found)
             {
-                movement.figureType() = _figureTypes.at(move[0]);
-                move                  = move.substr(1);
+                visitor.onGameStart();
+                found = true;
+            }
+
+            switch (token.type)
+            {
+                case PgnTokenType::leftParenthesis: ++variations;
+                    break;
+                case PgnTokenType::rightParenthesis: variations -= variations > 0 ? 1 : 0;
+                    break;
+                case PgnTokenType::leftBracket:
+                {
+                    // a tag pair, the tags of the next game end a game without a result
+                    if (moveCounter > 1)
+                    {
+                        lexer.rewind(token);
+                        visitor.onResult(GameResult::none);
+                        return true;
+                    }
+
+                    const auto name  = lexer.next();
+                    const auto value = name.type == PgnTokenType::symbol ? lexer.next() : name;
+                    if (value.type == PgnTokenType::string)
+                        visitor.onTag(name.text, value.text);
+
+                    for (token = value; token.type != PgnTokenType::end && token.type != PgnTokenType::rightBracket;)
+                        token = lexer.next();
+                    break;
+                }
+                case PgnTokenType::asterisk:
+                    if (variations == 0)
+                    {
+                        visitor.onResult(GameResult::none);
+                        return true;
+                    }
+                    break;
+                case PgnTokenType::symbol:
+                {
+                    if (variations != 0)
+                        break;
+
+                    const auto result = _possibleResults.find(token.text);
+                    if (result != _possibleResults.end())
+                    {
+                        visitor.onResult(result->second);
+                        return true;
+                    }
+
+                    try
+                    {
+                        visitor.onMove(parseMovement(token.text, moveCounter / 2 + 1, moveCounter,
+                                                     moveCounter % 2 == 0 ? Color::black : Color::white));
+                        moveCounter++;
+                    }
+                    catch (const std::out_of_range&)
+                    {
+                        // the rest of the game is useless without this move, it ends at its result or at the
+                        // tags of the next game
+                        for (auto skip = lexer.next(); skip.type != PgnTokenType::end; skip = lexer.next())
+                        {
+                            if (skip.type == PgnTokenType::leftBracket)
+                            {
+                                lexer.rewind(skip);
+                                break;
+                            }
+                            if (skip.type == PgnTokenType::asterisk
+                                || (skip.type == PgnTokenType::symbol && _possibleResults.count(skip.text) != 0))
+                                break;
+                        }
+                        throw;
+                    }
+                    break;
+                }
+                default:
+                    break;
             }
-            else
-                movement.figureType() = FigureType::pawn;
         }
 
-        // capture
-        const auto x = move.find('x');
-        if (x != std::string::npos)
-            movement.addFlag(EventFlag::capture);
+        if (found)
+            visitor.onResult(GameResult::none);
+        return found;
+    }
 
-        // check is not interesting for movements here
-        if (move.back() == '+')
+    size_t PgnParser::visitGames(PgnLexer& lexer, PgnVisitor& visitor)
+    {
+        size_t games = 0;
+        for (;;)
         {
-            movement.addFlag(EventFlag::check);
-            move = move.substr(0, move.length() - 1);
+            try
+            {
+                if (!visitNextGame(lexer, visitor))
+                    break;
+            }
+            catch (const std::out_of_range&)
+            {
+                visitor.onResult(GameResult::none);
+            }
+            games++;
         }
+        return games;
+    }
+
+    bool PgnParser::parseNextGame(PgnLexer& lexer, Game& game)
+    {
+        GameCollector collector(game);
+        if (visitNextGame(lexer, collector))
+            return true;
+
+        collector.onGameStart();
+        return false;
+    }
+
+    bool PgnParser::parseNextHeader(PgnLexer& lexer, GameHeader& header)
+    {
+        header.clear();
+        auto token = lexer.next();
+        if (token.type == PgnTokenType::end)
+            return false;
 
-        // Checkmate is also
-        if (move.back() == '#')
+        while (token.type == PgnTokenType::leftBracket)
         {
-            movement.addFlag(EventFlag::checkmate);
-            move = move.substr(0, move.length() - 1);
+            const auto name  = lexer.next();
+            const auto value = name.type == PgnTokenType::symbol ? lexer.next() : name;
+            if (value.type == PgnTokenType::string)
+                header.add(name.text, value.text);
+
+            for (token = value; token.type != PgnTokenType::end && token.type != PgnTokenType::rightBracket;)
+                token = lexer.next();
+            token = lexer.next();
         }
 
-        // promotion
-        if (movement.figureType() == FigureType::pawn && _figureTypes.find(move.back()) != _figureTypes.end())
+        if (token.type != PgnTokenType::end)
+            lexer.skipMovetext();
+        return true;
+    }
+
+    std::vector<Game> PgnParser::parseFile(const std::string& filename)
+    {
+        std::vector<Game> result;
+        PgnLexer          lexer;
+        if (!lexer.open(filename))
+            return result;
+
+        Game game;
+        for (;;)
         {
-            movement.addFlag(EventFlag::promotion);
-            movement.promotedTo() = _figureTypes.at(move.back());
-            move                  = move.substr(0, move.length() - 2);
+            try
+            {
+                if (!parseNextGame(lexer, game))
+                    break;
+                if (game.result != GameResult::none)
+                    result.emplace_back(std::move(game));
+            }
+            catch (const std::out_of_range&) { }
         }
 
-        // Last two both letters are the destination now
-        if (!movement.hasFlag(EventFlag::castling))
-        {
-            movement.destination().set(_rowsByLetter.at(move.at(move.length() - 1)),
-                                       _columnsByLetter.at(move.at(move.length() - 2)));
+        return result;
+    }
+
+    std::vector<Game> PgnParser::parseFileParallel(const std::string& filename, unsigned threads)
+    {
+        std::vector<Game> result;
+        MappedFile        file;
+        if (!file.open(filename))
+            return result;
+
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // more parts than threads even out parts with slow games, each part collects its own games
+        const auto                     buffer = StringView(reinterpret_cast<const char*>(file.data()), file.size());
+        const auto                     parts  = splitGames(buffer, 4 * threads);
+        std::vector<std::vector<Game>> games(parts.size());
+
+        parseParts(parts, threads, [&games](size_t part, Game& game) { games[part].emplace_back(std::move(game)); });
+
+        size_t count = 0;
+        for (auto& part : games)
+            count += part.size();
 
-            move = move.substr(0, move.length() - 2);
+        result.reserve(count);
+        for (auto& part : games)
+            std::move(part.begin(), part.end(), std::back_inserter(result));
+        return result;
+    }
+
+    bool PgnParser::parseFileParallel(const std::string& filename, const std::function<void(Game&)>& callback, unsigned threads)
+    {
+        MappedFile file;
+        if (!file.open(filename))
+            return false;
 
-            if (x != std::string::npos)
-                move = move.substr(0, move.length() - 1);
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
 
-            // If something is left, it's a origin clarification
-            if (move.length() == 2)
-                movement.origin().set(_rowsByLetter.at(move[0]), _columnsByLetter.at(move[1]));
+        const auto buffer = StringView(reinterpret_cast<const char*>(file.data()), file.size());
+        parseParts(splitGames(buffer, 4 * threads), threads, [&callback](size_t, Game& game) { callback(game); });
+        return true;
+    }
+
+    std::vector<StringView> PgnParser::splitGames(StringView buffer, size_t parts)
+    {
+        std::vector<StringView> result;
+        const auto              target = buffer.size() / std::max<size_t>(1, parts) + 1;
 
-            else if (move.length() == 1)
+        size_t start = 0;
+        while (start < buffer.size())
+        {
+            auto split = buffer.size();
+            if (buffer.size() - start > target)
             {
-                if (_rowsByLetter.find(move[0]) != _rowsByLetter.end())
-                    movement.origin().set(_rowsByLetter.at(move[0]), -1);
-                else
-                    movement.origin().set(-1, _columnsByLetter.at(move[0]));
+                // the next game start behind the wanted size, an Event tag is the safest one
+                const auto rest  = buffer.substr(start + target);
+                auto       found = StringView::npos;
+                for (auto newline = rest.find('\n'); newline != StringView::npos && found == StringView::npos; newline = rest.find('\n', newline + 1))
+                {
+                    const auto line = rest.substr(newline + 1);
+                    const auto empty = (newline > 0 && rest[newline - 1] == '\n')
+                        || (newline > 1 && rest[newline - 1] == '\r' && rest[newline - 2] == '\n');
+                    if (line.startsWith("[Event ") || (line.startsWith("[") && empty))
+                        found = newline + 1;
+                }
+
+                if (found != StringView::npos)
+                    split = start + target + found;
             }
+
+            result.push_back(buffer.substr(start, split - start));
+            start = split;
         }
 
-        return movement;
+        return result;
+    }
+
+    void PgnParser::parseParts(const std::vector<StringView>& parts, unsigned threads, const std::function<void(size_t, Game&)>& callback)
+    {
+        std::atomic<size_t> next{0};
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, parts.size())));
+
+        auto work = [&]()
+        {
+            PgnLexer lexer;
+            Game     game;
+            for (auto part = next++; part < parts.size(); part = next++)
+            {
+                lexer.reset(parts[part]);
+                for (;;)
+                {
+                    try
+                    {
+                        if (!parseNextGame(lexer, game))
+                            break;
+                        if (game.result != GameResult::none)
+                            callback(part, game);
+                    }
+                    catch (const std::out_of_range&) { }
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; i++)
+            workers.emplace_back(work);
+        work();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    Movement PgnParser::parseMovement(StringView move, unsigned roundCounter, unsigned, Color color)
+    {
+        SanMove decoded;
+        if (!SanDecoder::decode(move, decoded))
+            throw std::out_of_range("invalid movement");
+
+        return decoded.toMovement(color, roundCounter);
     }
 }
@@ -25,11 +25,15 @@
  */
 
 #pragma once
+#include <functional>
 #include <iostream>
 #include <map>
 #include <vector>
 
+#include "BasicUtils/StringView.h"
 #include "ChessEngine/ChessTypes.h"
+#include "PgnLexer.h"
+#include "PgnVisitor.h"
 
 namespace ChessNS
 {
@@ -45,7 +49,9 @@ namespace ChessNS
         /*!
          * \fn  Game PgnParser::parseSingleGame(std::istream& in);
          *
-         * \brief   Parse single game from file
+         * \brief   Parse single game from file, the movetext starts at the first line which is not a tag. If a move
+         *          can not be parsed, the rest of the game up to its result or the next tag section is skipped
+         *          before std::out_of_range is thrown, so the next call starts with the next game.
          *
          * \param [in,out]  in  The in.
          *
@@ -75,56 +81,149 @@ namespace ChessNS
          */
         std::vector<Game> parseMultipleGames(std::istream& in);
 
+        /*!
+         * \fn  bool PgnParser::visitNextGame(PgnLexer& lexer, PgnVisitor& visitor);
+         *
+         * \brief   Parses the next game of a lexer and passes its tags, moves and result to a visitor. Comments,
+         *          nags and variations are skipped. An invalid move throws std::out_of_range after the rest of the
+         *          game has been skipped, so parsing can continue with the next game.
+         *
+         * \param [in,out]  lexer   The lexer.
+         * \param [in,out]  visitor The visitor.
+         *
+         * \returns True if a game was found, false at the end of the lexer.
+         */
+        bool visitNextGame(PgnLexer& lexer, PgnVisitor& visitor);
+
+        /*!
+         * \fn  size_t PgnParser::visitGames(PgnLexer& lexer, PgnVisitor& visitor);
+         *
+         * \brief   Passes all games of a lexer to a visitor, games with an invalid move end without a result
+         *
+         * \param [in,out]  lexer   The lexer.
+         * \param [in,out]  visitor The visitor.
+         *
+         * \returns The number of games.
+         */
+        size_t visitGames(PgnLexer& lexer, PgnVisitor& visitor);
+
+        /*!
+         * \fn  bool PgnParser::parseNextGame(PgnLexer& lexer, Game& game);
+         *
+         * \brief   Parses the next game of a lexer like visitNextGame, the tags go into its header
+         *
+         * \param [in,out]  lexer   The lexer.
+         * \param [out]     game    The game, its result is GameResult::none for an unfinished game. The memory of
+         *                          its movements and header is reused.
+         *
+         * \returns True if a game was found, false at the end of the lexer.
+         */
+        bool parseNextGame(PgnLexer& lexer, Game& game);
+
+        /*!
+         * \fn  bool PgnParser::parseNextHeader(PgnLexer& lexer, GameHeader& header);
+         *
+         * \brief   Parses only the tags of the next game, its movetext is skipped by PgnLexer::skipMovetext. This
+         *          is much faster than parsing the moves, so a large database can be filtered first.
+         *
+         * \param [in,out]  lexer   The lexer.
+         * \param [out]     header  The header.
+         *
+         * \returns True if a game was found, false at the end of the lexer.
+         */
+        bool parseNextHeader(PgnLexer& lexer, GameHeader& header);
+
+        /*!
+         * \fn  std::vector<Game> PgnParser::parseFile(const std::string& filename);
+         *
+         * \brief   Parses all finished games of a mapped file, games with invalid moves are skipped
+         *
+         * \param   filename    Filename of the file.
+         *
+         * \returns A std::vector<Game>, empty if the file can not be opened.
+         */
+        std::vector<Game> parseFile(const std::string& filename);
+
+        /*!
+         * \fn  std::vector<Game> PgnParser::parseFileParallel(const std::string& filename, unsigned threads = 0);
+         *
+         * \brief   Parses all finished games of a mapped file with several threads, see splitGames
+         *
+         * \param   filename    Filename of the file.
+         * \param   threads     (Optional) The number of threads, 0 for one per core.
+         *
+         * \returns The games in the order of the file, empty if the file can not be opened.
+         */
+        std::vector<Game> parseFileParallel(const std::string& filename, unsigned threads = 0);
+
+        /*!
+         * \fn  bool PgnParser::parseFileParallel(const std::string& filename, const std::function<void(Game&)>& callback, unsigned threads = 0);
+         *
+         * \brief   Parses all finished games of a mapped file with several threads and hands every game to the
+         *          callback as soon as it is parsed, so the games are not collected
+         *
+         * \param   filename    Filename of the file.
+         * \param   callback    The callback, it is called by all threads at the same time and in no order.
+         * \param   threads     (Optional) The number of threads, 0 for one per core.
+         *
+         * \returns True if it succeeds, false if the file can not be opened.
+         */
+        bool parseFileParallel(const std::string& filename, const std::function<void(Game&)>& callback, unsigned threads = 0);
+
+        /*!
+         * \fn  static std::vector<StringView> PgnParser::splitGames(StringView buffer, size_t parts);
+         *
+         * \brief   Splits pgn text into parts of about the same size which start with a game. A part starts at a
+         *          line with an Event tag or otherwise at a tag line after an empty line, which follows the result of
+         *          the previous game.
+         *
+         * \param   buffer  The buffer.
+         * \param   parts   The wanted number of parts, there are less if the games are too few.
+         *
+         * \returns The parts, together they are the buffer.
+         */
+        static std::vector<StringView> splitGames(StringView buffer, size_t parts);
+
     private:
 
         /*!
-         * \fn  Movement PgnParser::parseMovement(std::string& move, unsigned roundCounter, unsigned moveCounter, Color color);
+         * \fn  void PgnParser::parseParts(const std::vector<StringView>& parts, unsigned threads, const std::function<void(size_t, Game&)>& callback);
+         *
+         * \brief   Parses parts of pgn text on a number of threads, every thread takes the next part
+         *
+         * \param   parts       The parts.
+         * \param   threads     The number of threads, 0 for one per core.
+         * \param   callback    Called with the index of the part and every finished game.
+         */
+        void parseParts(const std::vector<StringView>& parts, unsigned threads, const std::function<void(size_t, Game&)>& callback);
+
+        /*!
+         * \fn  Movement PgnParser::parseMovement(StringView move, unsigned roundCounter, unsigned moveCounter, Color color);
          *
          * \brief   Parse a single movement
          *
-         * \param [in,out]  move            The move.
+         * \param           move            The move.
          * \param           roundCounter    The round counter.
          * \param           moveCounter     The move counter.
          * \param           color           The color.
          *
          * \returns A Movement.
          */
-        Movement parseMovement(std::string& move, unsigned roundCounter, unsigned moveCounter, Color color);
+        Movement parseMovement(StringView move, unsigned roundCounter, unsigned moveCounter, Color color);
 
-        const std::map<std::string, GameResult> _possibleResults = {
+        /*!
+         * \fn  void PgnParser::skipGame(std::istream& in) const;
+         *
+         * \brief   Skips the lines of a game up to its result or the start of the next tag section
+         *
+         * \param [in,out]  in  The in.
+         */
+        void skipGame(std::istream& in) const;
+
+        const std::map<StringView, GameResult> _possibleResults = {
             {"1/2-1/2", GameResult::draw},
             {"1-0", GameResult::victoryWhite},
             {"0-1", GameResult::victoryBlack}
         };
-
-        const std::map<char, FigureType> _figureTypes = {
-            {'K', FigureType::king},
-            {'Q', FigureType::queen},
-            {'B', FigureType::bishop},
-            {'N', FigureType::knight},
-            {'R', FigureType::rook}
-        };
-
-        const std::map<char, int> _columnsByLetter = {
-            {'a', 0},
-            {'b', 1},
-            {'c', 2},
-            {'d', 3},
-            {'e', 4},
-            {'f', 5},
-            {'g', 6},
-            {'h', 7},
-        };
-
-        const std::map<char, int> _rowsByLetter = {
-            {'1', 0},
-            {'2', 1},
-            {'3', 2},
-            {'4', 3},
-            {'5', 4},
-            {'6', 5},
-            {'7', 6},
-            {'8', 7},
-        };
     };
 }
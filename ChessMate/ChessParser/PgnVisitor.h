@@ -0,0 +1,81 @@
+/*!
+* \brief:  Declares the pgn visitor interface
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include "BasicUtils/StringView.h"
+#include "ChessEngine/ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   PgnVisitor
+     *
+     * \brief   Receives the parts of the games while the parser reads them, so nothing has to be collected. The
+     *          views passed to it point into the buffer of the lexer and are only valid as long as it is.
+     */
+    class PgnVisitor
+    {
+    public:
+
+        virtual ~PgnVisitor() = default;
+
+        /*!
+         * \fn  virtual void PgnVisitor::onGameStart();
+         *
+         * \brief   Called before the first tag or move of a game
+         */
+        virtual void onGameStart() { }
+
+        /*!
+         * \fn  virtual void PgnVisitor::onTag(StringView name, StringView value);
+         *
+         * \brief   Called for every tag pair of a game
+         *
+         * \param   name    The name.
+         * \param   value   The value, escaped quotes and backslashes are kept.
+         */
+        virtual void onTag(StringView, StringView) { }
+
+        /*!
+         * \fn  virtual void PgnVisitor::onMove(const Movement& movement);
+         *
+         * \brief   Called for every move of the main line
+         *
+         * \param   movement    The movement as it is written, the origin is only known if it is given.
+         */
+        virtual void onMove(const Movement&) { }
+
+        /*!
+         * \fn  virtual void PgnVisitor::onResult(GameResult result);
+         *
+         * \brief   Called at the end of a game
+         *
+         * \param   result  The result, GameResult::none for an unfinished game.
+         */
+        virtual void onResult(GameResult) { }
+    };
+}
@@ -0,0 +1,285 @@
+/*!
+* \brief:  Implements the pgn writer class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "PgnWriter.h"
+#include <cstdlib>
+#include <utility>
+
+namespace ChessNS
+{
+    // the export format keeps lines below 80 characters
+    static const size_t maxLineLength = 79;
+
+    namespace
+    {
+        char figureLetter(FigureType type)
+        {
+            switch (type)
+            {
+            case FigureType::king:
+                return 'K';
+            case FigureType::queen:
+                return 'Q';
+            case FigureType::rook:
+                return 'R';
+            case FigureType::bishop:
+                return 'B';
+            case FigureType::knight:
+                return 'N';
+            default:
+                return 'P';
+            }
+        }
+
+        void appendSquare(std::string& text, Position position)
+        {
+            const auto cord = position.getCord();
+            text += static_cast<char>('a' + cord.second);
+            text += static_cast<char>('1' + cord.first);
+        }
+
+        const char* resultText(GameResult result)
+        {
+            switch (result)
+            {
+            case GameResult::victoryWhite:
+                return "1-0";
+            case GameResult::victoryBlack:
+                return "0-1";
+            case GameResult::draw:
+                return "1/2-1/2";
+            default:
+                return "*";
+            }
+        }
+
+        // which part of the origin makes a move of a figure unique, a row of -1 or a column of -1 is not needed
+        std::pair<int, int> disambiguation(Board& board, FigureType type, Position origin, Position destination)
+        {
+            const auto cord = origin.getCord();
+            Movement   other;
+            other.figureType()  = type;
+            other.destination() = destination;
+            if (board.resolve(other) == ResolveResult::unique)
+                return {-1, -1};
+
+            other.origin().set(-1, cord.second);
+            if (board.resolve(other) == ResolveResult::unique)
+                return {-1, cord.second};
+
+            other.origin().set(cord.first, -1);
+            if (board.resolve(other) == ResolveResult::unique)
+                return {cord.first, -1};
+
+            return cord;
+        }
+    }
+
+    PgnWriter::PgnWriter(Sink sink, size_t bufferSize)
+        : _sink(std::move(sink)),
+          _bufferSize(bufferSize)
+    {
+        _buffer.reserve(bufferSize);
+    }
+
+    PgnWriter::PgnWriter(std::ostream& out, size_t bufferSize)
+        : PgnWriter([&out](const char* data, size_t size)
+                    {
+                        out.write(data, static_cast<std::streamsize>(size));
+                        return static_cast<bool>(out);
+                    },
+                    bufferSize) {}
+
+    PgnWriter::~PgnWriter()
+    {
+        flush();
+    }
+
+    bool PgnWriter::write(Game& game)
+    {
+        return writeGame(game.movements, game.header, game.result);
+    }
+
+    bool PgnWriter::write(const Board& board, const GameHeader& header, GameResult result)
+    {
+        return writeGame(board.getAllMadeMoves(), header, result);
+    }
+
+    bool PgnWriter::flush()
+    {
+        if (_buffer.empty())
+            return true;
+
+        const auto written = _sink(_buffer.data(), _buffer.size());
+        _buffer.clear();
+        return written;
+    }
+
+    uint64_t PgnWriter::games() const
+    {
+        return _games;
+    }
+
+    bool PgnWriter::makeMove(Board& board, Movement& movement, std::string& san)
+    {
+        auto resolved = movement;
+        if (board.resolve(resolved) != ResolveResult::unique)
+            return false;
+
+        const auto origin      = resolved.origin();
+        const auto destination = resolved.destination();
+        const auto type        = board.at(origin).figure.getType();
+        const auto columns     = destination.getCord().second - origin.getCord().second;
+        const auto capture     = !board.at(destination).empty || (type == FigureType::pawn && columns != 0);
+        const auto size        = san.size();
+        auto       promotedTo  = FigureType::none;
+
+        if (type == FigureType::king && std::abs(columns) == 2)
+            san += columns > 0 ? "O-O" : "O-O-O";
+
+        else if (type == FigureType::pawn)
+        {
+            if (capture)
+            {
+                san += static_cast<char>('a' + origin.getCord().second);
+                san += 'x';
+            }
+            appendSquare(san, destination);
+
+            const auto row = destination.getCord().first;
+            if (row == 0 || row == 7)
+            {
+                promotedTo = movement.promotedTo() != FigureType::none ? movement.promotedTo() : FigureType::queen;
+                san += '=';
+                san += figureLetter(promotedTo);
+            }
+        }
+
+        else
+        {
+            san += figureLetter(type);
+            if (type != FigureType::king)
+            {
+                const auto part = disambiguation(board, type, origin, destination);
+                if (part.second >= 0)
+                    san += static_cast<char>('a' + part.second);
+                if (part.first >= 0)
+                    san += static_cast<char>('1' + part.first);
+            }
+            if (capture)
+                san += 'x';
+            appendSquare(san, destination);
+        }
+
+        auto made = board.makeMove(origin, destination, promotedTo);
+        if (!made.isValid())
+        {
+            san.resize(size);
+            return false;
+        }
+
+        if (made.hasFlag(EventFlag::check))
+            san += board.hasLegalMove() ? '+' : '#';
+
+        movement = made;
+        return true;
+    }
+
+    bool PgnWriter::writeGame(const std::vector<Movement>& movements, const GameHeader& header, GameResult result)
+    {
+        const auto start = _buffer.size();
+        auto       tag   = [this](StringView name, StringView value)
+        {
+            _buffer += '[';
+            _buffer.append(name.data(), name.size());
+            _buffer += " \"";
+            _buffer.append(value.data(), value.size());
+            _buffer += "\"]\n";
+        };
+
+        for (size_t i = 0; i < header.size(); i++)
+            tag(header.name(i), header.value(i));
+        if (!header.has("Result"))
+            tag("Result", resultText(result));
+        _buffer += '\n';
+
+        size_t made  = 0;
+        auto   valid = true;
+        _lineLength  = 0;
+        for (auto movement : movements)
+        {
+            // a number stays on the line of its move
+            _san.clear();
+            if (made % 2 == 0)
+            {
+                _san += std::to_string(made / 2 + 1);
+                _san += ". ";
+            }
+
+            if (!makeMove(_board, movement, _san))
+            {
+                valid = false;
+                break;
+            }
+            append(_san.data(), _san.size());
+            made++;
+        }
+
+        for (; made > 0; made--)
+            _board.unmakeMove();
+
+        if (!valid)
+        {
+            _buffer.resize(start);
+            return false;
+        }
+
+        const auto* text = resultText(result);
+        append(text, std::char_traits<char>::length(text));
+        _buffer += "\n\n";
+        _games++;
+
+        return _buffer.size() < _bufferSize || flush();
+    }
+
+    void PgnWriter::append(const char* token, size_t size)
+    {
+        if (_lineLength > 0 && _lineLength + 1 + size > maxLineLength)
+        {
+            _buffer += '\n';
+            _lineLength = 0;
+        }
+        else if (_lineLength > 0)
+        {
+            _buffer += ' ';
+            _lineLength++;
+        }
+
+        _buffer.append(token, size);
+        _lineLength += size;
+    }
+}
@@ -0,0 +1,158 @@
+/*!
+* \brief:  Declares the pgn writer class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ChessEngine/Board.h"
+#include "ChessEngine/ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   PgnWriter
+     *
+     * \brief   Writes games in the pgn export format. The moves are replayed on a board, so the standard algebraic
+     *          notation gets the disambiguation and the check and mate markers from the position and not from the
+     *          source. The text goes into one buffer which is reused and handed to the sink once it is full.
+     */
+    class PgnWriter
+    {
+    public:
+
+        /*! \brief   Takes a chunk of text, returns false if it could not be written */
+        using Sink = std::function<bool(const char* data, size_t size)>;
+
+        /*!
+         * \fn  explicit PgnWriter::PgnWriter(Sink sink, size_t bufferSize = 1 << 20);
+         *
+         * \brief   Constructor
+         *
+         * \param   sink        The sink.
+         * \param   bufferSize  (Optional) The size from which the buffer is handed to the sink.
+         */
+        explicit PgnWriter(Sink sink, size_t bufferSize = 1 << 20);
+
+        /*!
+         * \fn  explicit PgnWriter::PgnWriter(std::ostream& out, size_t bufferSize = 1 << 20);
+         *
+         * \brief   Constructor for a stream, the chunks are written unformatted
+         *
+         * \param [in,out]  out         The stream.
+         * \param           bufferSize  (Optional) The size from which the buffer is handed to the stream.
+         */
+        explicit PgnWriter(std::ostream& out, size_t bufferSize = 1 << 20);
+
+        PgnWriter(const PgnWriter&) = delete;
+
+        PgnWriter& operator=(const PgnWriter&) = delete;
+
+        /*!
+         * \fn  PgnWriter::~PgnWriter();
+         *
+         * \brief   Destructor, the rest of the buffer is flushed
+         */
+        ~PgnWriter();
+
+        /*!
+         * \fn  bool PgnWriter::write(Game& game);
+         *
+         * \brief   Writes a game which starts in the start position. The tags are written as they are kept, with
+         *          their escapes, the result tag is added if it is missing.
+         *
+         * \param [in,out]  game    The game, its movements may be parsed or made ones.
+         *
+         * \returns True if it succeeds, false if a move is not legal or the sink failed. Nothing of the game is
+         *          written then.
+         */
+        bool write(Game& game);
+
+        /*!
+         * \fn  bool PgnWriter::write(const Board& board, const GameHeader& header, GameResult result);
+         *
+         * \brief   Writes the moves made on a board
+         *
+         * \param   board   The board.
+         * \param   header  The tags.
+         * \param   result  The result.
+         *
+         * \returns True if it succeeds, false if a move is not legal or the sink failed.
+         */
+        bool write(const Board& board, const GameHeader& header, GameResult result);
+
+        /*!
+         * \fn  bool PgnWriter::flush();
+         *
+         * \brief   Hands the buffer to the sink
+         *
+         * \returns True if it succeeds, false if the sink failed.
+         */
+        bool flush();
+
+        /*!
+         * \fn  uint64_t PgnWriter::games() const;
+         *
+         * \brief   Gets the number of games written
+         *
+         * \returns The number of games.
+         */
+        uint64_t games() const;
+
+        /*!
+         * \fn  static bool PgnWriter::makeMove(Board& board, Movement& movement, std::string& san);
+         *
+         * \brief   Makes a move and appends its standard algebraic notation. A pawn reaching the last row without
+         *          a figure to promote to becomes a queen.
+         *
+         * \param [in,out]  board       The board.
+         * \param [in,out]  movement    The movement, its origin may be partial or missing. It is the made movement
+         *                              afterwards.
+         * \param [in,out]  san         The text to append to.
+         *
+         * \returns True if it succeeds, false if the move is not legal or ambiguous. Nothing is appended then.
+         */
+        static bool makeMove(Board& board, Movement& movement, std::string& san);
+
+    private:
+
+        bool writeGame(const std::vector<Movement>& movements, const GameHeader& header, GameResult result);
+
+        void append(const char* token, size_t size);
+
+        Sink        _sink;
+        size_t      _bufferSize;
+        std::string _buffer;
+        std::string _san;
+        size_t      _lineLength{};
+        uint64_t    _games{};
+        Board       _board;
+    };
+}
@@ -0,0 +1,224 @@
+/*!
+* \brief:  Implements the san decoder class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "SanDecoder.h"
+
+namespace ChessNS
+{
+    namespace
+    {
+        // the class of a character in the upper bits, its value in the lower bits
+        enum SanClass : uint8_t
+        {
+            invalid    = 0x00,
+            column     = 0x10,
+            row        = 0x20,
+            figure     = 0x30,
+            capture    = 0x40,
+            check      = 0x50,
+            checkmate  = 0x60,
+            equals     = 0x70,
+            castling   = 0x80,
+            dash       = 0x90,
+            annotation = 0xA0,
+            classMask  = 0xF0,
+            valueMask  = 0x0F
+        };
+
+        struct SanClasses
+        {
+            uint8_t classes[256];
+        };
+
+        constexpr SanClasses makeSanClasses()
+        {
+            SanClasses result{};
+            for (int c = 'a'; c <= 'h'; c++)
+                result.classes[c] = static_cast<uint8_t>(column | (c - 'a'));
+            for (int c = '1'; c <= '8'; c++)
+                result.classes[c] = static_cast<uint8_t>(row | (c - '1'));
+
+            result.classes['K'] = static_cast<uint8_t>(figure | static_cast<int>(FigureType::king));
+            result.classes['Q'] = static_cast<uint8_t>(figure | static_cast<int>(FigureType::queen));
+            result.classes['R'] = static_cast<uint8_t>(figure | static_cast<int>(FigureType::rook));
+            result.classes['N'] = static_cast<uint8_t>(figure | static_cast<int>(FigureType::knight));
+            result.classes['B'] = static_cast<uint8_t>(figure | static_cast<int>(FigureType::bishop));
+            result.classes['x'] = capture;
+            result.classes[':'] = capture;
+            result.classes['+'] = check;
+            result.classes['#'] = checkmate;
+            result.classes['='] = equals;
+            result.classes['O'] = castling;
+            result.classes['0'] = castling;
+            result.classes['-'] = dash;
+            result.classes['!'] = annotation;
+            result.classes['?'] = annotation;
+            return result;
+        }
+
+        constexpr SanClasses sanClasses = makeSanClasses();
+
+        constexpr uint8_t bit(EventFlag flag)
+        {
+            return static_cast<uint8_t>(1u << static_cast<unsigned>(flag));
+        }
+    }
+
+    Movement SanMove::toMovement(Color color, unsigned round) const
+    {
+        Movement movement;
+        movement.moveResult() = MoveResult::valid;
+        movement.color()      = color;
+        movement.round()      = round;
+        movement.figureType() = figureType();
+        movement.promotedTo() = static_cast<FigureType>(promotedTo);
+
+        const auto mirrored = color == Color::black && hasFlag(EventFlag::castling) ? 7 : 0;
+        movement.destination().set(toRow + mirrored, toColumn);
+        if (fromRow >= 0 || fromColumn >= 0)
+            movement.origin().set(fromRow, fromColumn);
+
+        for (auto flag : {EventFlag::capture, EventFlag::promotion, EventFlag::check, EventFlag::checkmate, EventFlag::castling})
+            if (hasFlag(flag))
+                movement.addFlag(flag);
+
+        return movement;
+    }
+
+    bool SanDecoder::decode(StringView text, SanMove& move)
+    {
+        move = SanMove();
+
+        auto       current = text.begin();
+        const auto end     = text.end();
+        if (current == end)
+            return false;
+
+        auto type = sanClasses.classes[static_cast<unsigned char>(*current)];
+        if ((type & classMask) == castling)
+        {
+            // O-O or O-O-O, the letters and dashes alternate
+            unsigned castles = 0;
+            while (current != end && (sanClasses.classes[static_cast<unsigned char>(*current)] & classMask) == castling)
+            {
+                castles++;
+                if (++current == end || (sanClasses.classes[static_cast<unsigned char>(*current)] & classMask) != dash)
+                    break;
+                ++current;
+            }
+            if (castles != 2 && castles != 3)
+                return false;
+
+            move.figure   = static_cast<uint8_t>(FigureType::king);
+            move.flags    = bit(EventFlag::castling);
+            move.toRow    = 0;
+            move.toColumn = castles == 2 ? 6 : 2;
+        }
+        else
+        {
+            move.figure = static_cast<uint8_t>(FigureType::pawn);
+            if ((type & classMask) == figure)
+            {
+                move.figure = static_cast<uint8_t>(type & valueMask);
+                ++current;
+            }
+
+            // up to four coordinates, the last two are the destination
+            int8_t   coordinates[4];
+            uint8_t  classes[4];
+            unsigned count = 0;
+            for (; current != end; ++current)
+            {
+                type = sanClasses.classes[static_cast<unsigned char>(*current)];
+                const auto kind = type & classMask;
+                if (kind == column || kind == row)
+                {
+                    if (count == 4)
+                        return false;
+                    coordinates[count] = static_cast<int8_t>(type & valueMask);
+                    classes[count++]   = static_cast<uint8_t>(kind);
+                }
+                else if (kind == capture)
+                    move.flags |= bit(EventFlag::capture);
+                else if (kind != dash)
+                    break;
+            }
+
+            if (count < 2 || classes[count - 2] != column || classes[count - 1] != row)
+                return false;
+
+            move.toColumn = coordinates[count - 2];
+            move.toRow    = coordinates[count - 1];
+            if (count == 4)
+            {
+                if (classes[0] != column || classes[1] != row)
+                    return false;
+                move.fromColumn = coordinates[0];
+                move.fromRow    = coordinates[1];
+            }
+            else if (count == 3)
+            {
+                if (classes[0] == column)
+                    move.fromColumn = coordinates[0];
+                else
+                    move.fromRow = coordinates[0];
+            }
+
+            // promotion, with or without the equal sign
+            if (current != end && (type & classMask) == equals)
+            {
+                if (++current == end)
+                    return false;
+                type = sanClasses.classes[static_cast<unsigned char>(*current)];
+                if ((type & classMask) != figure)
+                    return false;
+            }
+            if (current != end && (type & classMask) == figure)
+            {
+                if (move.figureType() != FigureType::pawn || (type & valueMask) == static_cast<uint8_t>(FigureType::king))
+                    return false;
+                move.promotedTo = static_cast<uint8_t>(type & valueMask);
+                move.flags |= bit(EventFlag::promotion);
+                ++current;
+            }
+        }
+
+        // check, checkmate and annotations
+        for (; current != end; ++current)
+        {
+            const auto kind = sanClasses.classes[static_cast<unsigned char>(*current)] & classMask;
+            if (kind == check)
+                move.flags |= bit(EventFlag::check);
+            else if (kind == checkmate)
+                move.flags |= bit(EventFlag::checkmate);
+            else if (kind != annotation)
+                return false;
+        }
+
+        return true;
+    }
+}
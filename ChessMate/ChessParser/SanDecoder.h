@@ -0,0 +1,102 @@
+/*!
+* \brief:  Declares the san decoder class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include "BasicUtils/StringView.h"
+#include "ChessEngine/ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \struct  SanMove
+     *
+     * \brief   A move in standard algebraic notation as it is written, in eight bytes. Rows and columns are
+     *          zero-based, -1 if they are not given.
+     */
+    struct SanMove
+    {
+        /*! \brief   The row of the destination */
+        int8_t toRow{-1};
+        /*! \brief   The column of the destination */
+        int8_t toColumn{-1};
+        /*! \brief   The row of the origin, only given to tell two figures apart */
+        int8_t fromRow{-1};
+        /*! \brief   The column of the origin, only given to tell two figures apart */
+        int8_t fromColumn{-1};
+        /*! \brief   The FigureType which moves */
+        uint8_t figure{};
+        /*! \brief   The FigureType of a promotion */
+        uint8_t promotedTo{};
+        /*! \brief   A bit for every EventFlag */
+        uint8_t flags{};
+        /*! \brief   Unused, keeps the size */
+        uint8_t reserved{};
+
+        /*! \brief   The figure type */
+        FigureType figureType() const { return static_cast<FigureType>(figure); }
+
+        /*! \brief   Query if an event flag is set */
+        bool hasFlag(EventFlag flag) const { return (flags & (1u << static_cast<unsigned>(flag))) != 0; }
+
+        /*!
+         * \fn  Movement SanMove::toMovement(Color color, unsigned round) const;
+         *
+         * \brief   Converts this object to a movement
+         *
+         * \param   color   The color of the player.
+         * \param   round   The round.
+         *
+         * \returns A valid Movement, its origin is only set as far as it is given.
+         */
+        Movement toMovement(Color color, unsigned round) const;
+    };
+
+    /*!
+     * \class   SanDecoder
+     *
+     * \brief   Decodes standard algebraic notation in a single pass over the characters, every character is looked
+     *          up once in a table of character classes. Castling may be written with letters or zeros, a promotion
+     *          with or without the equal sign, suffix annotations like !? are ignored.
+     */
+    class SanDecoder
+    {
+    public:
+
+        /*!
+         * \fn  static bool SanDecoder::decode(StringView text, SanMove& move);
+         *
+         * \brief   Decodes a move, a castling destination is on the first row and has to be mirrored for black
+         *
+         * \param           text    The text.
+         * \param [out]     move    The move.
+         *
+         * \returns True if it succeeds, false if the text is no move.
+         */
+        static bool decode(StringView text, SanMove& move);
+    };
+}
@@ -0,0 +1,296 @@
+/*!
+* \brief:  Implements the book builder class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "BookBuilder.h"
+#include <algorithm>
+#include <cstdio>
+#include "Polyglot.h"
+
+namespace ChessNS
+{
+    BookBuilder::BookBuilder(const std::string& filename, const BookBuildConfig& config)
+        : _config(config),
+          _filename(filename),
+          _runFilename(filename + ".runs")
+    {
+        if (_config.threads == 0)
+            _config.threads = std::max(1u, std::thread::hardware_concurrency());
+
+        _recordLimit = std::max<size_t>(1024, _config.memory * 1024 * 1024 / _config.threads / sizeof(Record));
+
+        _runFile.open(_runFilename, std::ios::binary | std::ios::trunc);
+        if (!_runFile)
+            _failed = true;
+
+        for (unsigned i = 0; i < _config.threads; i++)
+            _workers.emplace_back(&BookBuilder::work, this);
+    }
+
+    BookBuilder::~BookBuilder()
+    {
+        if (!_workers.empty())
+            finish();
+    }
+
+    void BookBuilder::add(std::vector<Game>&& games)
+    {
+        std::unique_lock<std::mutex> lock(_queueMutex);
+        _queueChanged.wait(lock, [this] { return _queue.size() < 2 * _workers.size(); });
+        _queue.emplace_back(std::move(games));
+        _queueChanged.notify_all();
+    }
+
+    bool BookBuilder::finish()
+    {
+        if (_workers.empty())
+            return !_failed;
+
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _closed = true;
+        }
+        _queueChanged.notify_all();
+
+        for (auto& worker : _workers)
+            worker.join();
+        _workers.clear();
+        _runFile.close();
+
+        std::ofstream out(_filename, std::ios::binary | std::ios::trunc);
+        std::ifstream in(_runFilename, std::ios::binary);
+        if (!out || !in)
+            _failed = true;
+
+        // each run is read through a buffer with its share of the memory
+        const auto bufferSize = std::max<size_t>(64, _config.memory * 1024 * 1024 / std::max<size_t>(1, _runs.size()) / sizeof(Record));
+        std::vector<std::vector<Record>> buffers(_runs.size());
+        std::vector<size_t>              next(_runs.size());
+        auto                             refill = [&](size_t run)
+        {
+            if (_runs[run].count == 0)
+                return false;
+
+            const auto count = static_cast<size_t>(std::min<uint64_t>(bufferSize, _runs[run].count));
+            buffers[run].resize(count);
+            next[run] = 0;
+            in.seekg(static_cast<std::streamoff>(_runs[run].offset));
+            in.read(reinterpret_cast<char*>(buffers[run].data()), static_cast<std::streamsize>(count * sizeof(Record)));
+            if (!in)
+                _failed = true;
+
+            _runs[run].offset += count * sizeof(Record);
+            _runs[run].count -= count;
+            return static_cast<bool>(in);
+        };
+
+        // the heap of the runs with the smallest key and move on top
+        auto later = [&](size_t lhs, size_t rhs)
+        {
+            const auto& left  = buffers[lhs][next[lhs]];
+            const auto& right = buffers[rhs][next[rhs]];
+            return right.key < left.key || (right.key == left.key && right.move < left.move);
+        };
+
+        std::vector<size_t> heap;
+        for (size_t run = 0; run < _runs.size(); run++)
+            if (refill(run))
+                heap.push_back(run);
+        std::make_heap(heap.begin(), heap.end(), later);
+
+        // the records of a position come one after another, the ones of the same move are combined
+        std::vector<Record> moves;
+        while (!heap.empty() && out)
+        {
+            std::pop_heap(heap.begin(), heap.end(), later);
+            const auto run    = heap.back();
+            const auto record = buffers[run][next[run]++];
+            if (next[run] < buffers[run].size() || refill(run))
+                std::push_heap(heap.begin(), heap.end(), later);
+            else
+                heap.pop_back();
+
+            if (!moves.empty() && moves.front().key != record.key)
+                write(out, moves);
+
+            if (!moves.empty() && moves.back().move == record.move)
+            {
+                moves.back().games += record.games;
+                moves.back().points += record.points;
+            }
+            else
+                moves.push_back(record);
+        }
+        write(out, moves);
+
+        in.close();
+        std::remove(_runFilename.c_str());
+        _runs.clear();
+        return !_failed && static_cast<bool>(out);
+    }
+
+    uint64_t BookBuilder::games() const
+    {
+        return _games;
+    }
+
+    uint64_t BookBuilder::entries() const
+    {
+        return _entries;
+    }
+
+    Movement BookBuilder::resolve(Board& board, Movement& movement)
+    {
+        auto resolved = movement;
+        if (board.resolve(resolved) != ResolveResult::unique)
+            return Movement::invalid();
+
+        auto result = board.makeMove(resolved.origin(), resolved.destination());
+        if (result.isValid())
+            board.unmakeMove();
+        return result;
+    }
+
+    void BookBuilder::work()
+    {
+        std::vector<Record> records;
+        records.reserve(_recordLimit);
+
+        while (true)
+        {
+            std::vector<Game> games;
+            {
+                std::unique_lock<std::mutex> lock(_queueMutex);
+                _queueChanged.wait(lock, [this] { return _closed || !_queue.empty(); });
+                if (_queue.empty())
+                    break;
+
+                games = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            _queueChanged.notify_all();
+
+            for (auto& game : games)
+            {
+                if (game.result == GameResult::none)
+                    continue;
+
+                replay(game, records);
+                _games++;
+                if (records.size() >= _recordLimit)
+                    spill(records);
+            }
+        }
+
+        spill(records);
+    }
+
+    void BookBuilder::replay(Game& game, std::vector<Record>& records)
+    {
+        Board board;
+        for (size_t ply = 0; ply < _config.plies && ply < game.movements.size(); ply++)
+        {
+            auto& parsed = game.movements[ply];
+            auto  move   = resolve(board, parsed);
+            if (!move.isValid())
+                break;
+
+            auto promotedTo = FigureType::none;
+            if (move.hasFlag(EventFlag::promotion))
+                promotedTo = parsed.promotedTo() != FigureType::none ? parsed.promotedTo() : FigureType::queen;
+
+            const auto color  = board.getCurrentColorTurn();
+            uint32_t   points = 1;
+            if (game.result != GameResult::draw)
+                points = (game.result == GameResult::victoryWhite) == (color == Color::white) ? 2 : 0;
+
+            records.push_back({Polyglot::key(board), Polyglot::encode(move.origin(), move.destination(), parsed.figureType(), promotedTo), 1, points});
+            board.makeMove(move.origin(), move.destination(), promotedTo);
+        }
+    }
+
+    void BookBuilder::spill(std::vector<Record>& records)
+    {
+        if (records.empty())
+            return;
+
+        std::sort(records.begin(), records.end(), [](const Record& lhs, const Record& rhs)
+        {
+            return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.move < rhs.move);
+        });
+
+        // combine the records of the same move before they are appended as a sorted run
+        size_t count = 0;
+        for (const auto& record : records)
+        {
+            if (count > 0 && records[count - 1].key == record.key && records[count - 1].move == record.move)
+            {
+                records[count - 1].games += record.games;
+                records[count - 1].points += record.points;
+            }
+            else
+                records[count++] = record;
+        }
+
+        std::lock_guard<std::mutex> lock(_runMutex);
+        const auto                  offset = _runs.empty() ? 0 : _runs.back().offset + _runs.back().count * sizeof(Record);
+        _runs.push_back({offset, count});
+        _runFile.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(count * sizeof(Record)));
+        if (!_runFile)
+            _failed = true;
+
+        records.clear();
+    }
+
+    void BookBuilder::write(std::ofstream& out, std::vector<Record>& moves)
+    {
+        moves.erase(std::remove_if(moves.begin(), moves.end(), [this](const Record& record)
+        {
+            return record.games < _config.minGames;
+        }), moves.end());
+
+        std::sort(moves.begin(), moves.end(), [](const Record& lhs, const Record& rhs)
+        {
+            return lhs.points > rhs.points;
+        });
+
+        // the weights are 16 bit, so a position with more points is scaled down
+        const uint64_t maximum = moves.empty() ? 0 : moves.front().points;
+        for (const auto& move : moves)
+        {
+            PolyglotEntry entry;
+            entry.key    = move.key;
+            entry.move   = move.move;
+            entry.weight = static_cast<uint16_t>(maximum > 0xFFFF ? move.points * 0xFFFFull / maximum : move.points);
+
+            unsigned char data[Polyglot::entrySize];
+            Polyglot::write(entry, data);
+            out.write(reinterpret_cast<const char*>(data), sizeof(data));
+            _entries++;
+        }
+
+        moves.clear();
+    }
+}
@@ -0,0 +1,178 @@
+/*!
+* \brief:  Declares the book builder class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ChessEngine/Board.h"
+
+namespace ChessNS
+{
+    /*!
+     * \struct  BookBuildConfig
+     *
+     * \brief   The configuration of a book builder.
+     */
+    struct BookBuildConfig
+    {
+        /*! \brief   The number of plies of each game which go into the book */
+        unsigned plies{20};
+        /*! \brief   The number of threads which replay the games, 0 for one per core */
+        unsigned threads{0};
+        /*! \brief   The memory for the move statistics in megabytes, more positions are written to a run file */
+        size_t memory{256};
+        /*! \brief   Moves played less often are left out */
+        unsigned minGames{1};
+    };
+
+    /*!
+     * \class   BookBuilder
+     *
+     * \brief   Builds a Polyglot opening book from games. Worker threads replay the games and count the games and
+     *          the points of each move per position. Whenever the counts exceed the memory they are sorted and
+     *          appended to a run file, so finish merges the runs with a buffer of each in the memory and writes the
+     *          book sorted by the key. The weight of a move is two for every won and one for every drawn game.
+     */
+    class BookBuilder
+    {
+    public:
+
+        /*!
+         * \fn  BookBuilder::BookBuilder(const std::string& filename, const BookBuildConfig& config = BookBuildConfig());
+         *
+         * \brief   Constructor, starts the worker threads
+         *
+         * \param   filename    The filename of the book, the run file is created next to it.
+         * \param   config      (Optional) The configuration.
+         */
+        explicit BookBuilder(const std::string& filename, const BookBuildConfig& config = BookBuildConfig());
+
+        BookBuilder(const BookBuilder&) = delete;
+
+        BookBuilder& operator=(const BookBuilder&) = delete;
+
+        ~BookBuilder();
+
+        /*!
+         * \fn  void BookBuilder::add(std::vector<Game>&& games);
+         *
+         * \brief   Hands games to the worker threads, waits while the workers are behind
+         *
+         * \param [in,out]  games   The games, games without a result are skipped.
+         */
+        void add(std::vector<Game>&& games);
+
+        /*!
+         * \fn  bool BookBuilder::finish();
+         *
+         * \brief   Waits for the workers, merges the runs into the book and removes the run file
+         *
+         * \returns True if it succeeds, false if a file could not be written.
+         */
+        bool finish();
+
+        /*!
+         * \fn  uint64_t BookBuilder::games() const;
+         *
+         * \brief   Gets the number of replayed games
+         *
+         * \returns The number of games.
+         */
+        uint64_t games() const;
+
+        /*!
+         * \fn  uint64_t BookBuilder::entries() const;
+         *
+         * \brief   Gets the number of entries written by finish
+         *
+         * \returns The number of entries.
+         */
+        uint64_t entries() const;
+
+        /*!
+         * \fn  static Movement BookBuilder::resolve(Board& board, Movement& movement);
+         *
+         * \brief   Finds the possible move of the color on turn which fits a parsed movement, i.e. the type of the
+         *          figure, the destination and the known part of the origin
+         *
+         * \param [in,out]  board       The board.
+         * \param [in,out]  movement    The parsed movement.
+         *
+         * \returns The move with a valid origin, invalid if there is none or more than one.
+         */
+        static Movement resolve(Board& board, Movement& movement);
+
+    private:
+
+        struct Record
+        {
+            uint64_t key;
+            uint16_t move;
+            uint32_t games;
+            uint32_t points;
+        };
+
+        struct Run
+        {
+            uint64_t offset;
+            uint64_t count;
+        };
+
+        void work();
+
+        void replay(Game& game, std::vector<Record>& records);
+
+        void spill(std::vector<Record>& records);
+
+        void write(std::ofstream& out, std::vector<Record>& moves);
+
+        BookBuildConfig          _config;
+        std::string              _filename;
+        std::string              _runFilename;
+        std::vector<std::thread> _workers;
+        size_t                   _recordLimit{};
+
+        std::mutex                    _queueMutex;
+        std::condition_variable       _queueChanged;
+        std::deque<std::vector<Game>> _queue;
+        bool                          _closed{false};
+
+        std::mutex       _runMutex;
+        std::ofstream    _runFile;
+        std::vector<Run> _runs;
+
+        std::atomic<bool>     _failed{false};
+        std::atomic<uint64_t> _games{0};
+        uint64_t              _entries{};
+    };
+}
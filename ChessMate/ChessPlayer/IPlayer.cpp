@@ -25,6 +25,8 @@
  */
 #include "IPlayer.h"
 #include "PlayerHuman.h"
+#include "PlayerMctsAi.h"
+#include "PlayerSearchAi.h"
 #include "PlayerSimpleAi.h"
 #include <memory>
 
@@ -39,6 +41,10 @@ namespace ChessNS
                 break;
             case PlayerType::simpleAi: result = std::make_unique<PlayerSimpleAi>();
                 break;
+            case PlayerType::searchAi: result = std::make_unique<PlayerSearchAi>();
+                break;
+            case PlayerType::mctsAi: result = std::make_unique<PlayerMctsAi>();
+                break;
             default: return nullptr;
         }
 
@@ -51,5 +57,7 @@ namespace ChessNS
 
     PlayerType IPlayer::getPlayerType() const { return _playerType; }
 
+    void IPlayer::setSeed(uint32_t) { }
+
     Color IPlayer::getColor() const { return _playerColor; }
 }
@@ -24,6 +24,7 @@
 * SOFTWARE.
  */
 #pragma once
+#include <cstdint>
 #include "ChessEngine/ChessTypes.h"
 #include "ChessEngine/Board.h"
 #include <memory>
@@ -35,7 +36,7 @@ namespace ChessNS
      *
      * \brief   Values that represent player types
      */
-    enum class PlayerType { human, simpleAi };
+    enum class PlayerType { human, simpleAi, searchAi, mctsAi };
 
     /*!
      * \class   IPlayer
@@ -46,6 +47,8 @@ namespace ChessNS
     {
     public:
 
+        virtual ~IPlayer() = default;
+
         /*!
          * \fn  static std::unique_ptr<IPlayer> IPlayer::createPlayer(PlayerType type, Color color, const std::shared_ptr<Board>& board);
          *
@@ -120,6 +123,16 @@ namespace ChessNS
          */
         virtual void setBoard(const std::shared_ptr<Board>& board) = 0;
 
+        /*!
+         * \fn  virtual void IPlayer::setSeed(uint32_t seed);
+         *
+         * \brief   Seeds the random choices of a computer player, so with one thread and a node or depth limit the
+         *          same moves are played again. Other players ignore it.
+         *
+         * \param   seed    The seed.
+         */
+        virtual void setSeed(uint32_t seed);
+
     protected:
         std::shared_ptr<Board> _board;
         PlayerType             _playerType{};
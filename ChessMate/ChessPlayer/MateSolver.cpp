@@ -0,0 +1,223 @@
+/*!
+* \brief:  Implements the mate solver class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "MateSolver.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace ChessNS
+{
+    // a promotion to a knight can be the only mate and one to a rook or a bishop the only way out of a stalemate
+    static std::vector<Movement> legalMoves(Board& board)
+    {
+        auto       moves = board.getAllPossibleMoves(board.getCurrentColorTurn());
+        const auto count = moves.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!moves[i].hasFlag(EventFlag::promotion))
+                continue;
+
+            for (auto type : {FigureType::rook, FigureType::bishop, FigureType::knight})
+            {
+                moves.push_back(moves[i]);
+                moves.back().promotedTo() = type;
+            }
+            moves[i].promotedTo() = FigureType::queen;
+        }
+        return moves;
+    }
+
+    static void makeMove(Board& board, Movement& movement)
+    {
+        board.makeMove(movement.origin(), movement.destination(), movement.promotedTo());
+    }
+
+    MateSolver::MateSolver(const MateConfig& config)
+        : _config(config) { }
+
+    MateResult MateSolver::solve(Board& board)
+    {
+        MateResult result;
+        _nodes = 0;
+        _refuted.clear();
+
+        // deepening one move at a time finds the shortest mate first
+        for (unsigned moves = 1; moves <= _config.maxMoves && !result.found; moves++)
+        {
+            if (!attack(board, moves))
+                continue;
+
+            result.found = true;
+            result.moves = moves;
+        }
+
+        // the attacker mates as fast as possible, the defender holds out as long as possible
+        for (auto moves = result.moves; moves != 0;)
+        {
+            for (auto& movement : attackerMoves(board, moves))
+            {
+                makeMove(board, movement);
+                if (defend(board, moves))
+                {
+                    result.line.push_back(movement);
+                    break;
+                }
+                board.unmakeMove();
+            }
+
+            Movement longest;
+            unsigned remaining = 0;
+            for (auto& movement : legalMoves(board))
+            {
+                makeMove(board, movement);
+                const auto distance = mateDistance(board, moves - 1);
+                board.unmakeMove();
+
+                if (distance > remaining)
+                {
+                    remaining = distance;
+                    longest   = movement;
+                }
+            }
+
+            if (remaining == 0)
+                break;
+
+            result.line.push_back(longest);
+            makeMove(board, longest);
+            moves = remaining;
+        }
+
+        for (size_t i = 0; i < result.line.size(); i++)
+            board.unmakeMove();
+
+        result.nodes = _nodes;
+        return result;
+    }
+
+    std::vector<MateResult> MateSolver::solveAll(std::vector<Board>& boards, const MateConfig& config)
+    {
+        std::vector<MateResult> results(boards.size());
+        std::atomic<size_t>     next{0};
+
+        auto threads = config.threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : config.threads;
+        threads      = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, boards.size())));
+
+        auto work = [&]()
+        {
+            MateSolver solver(config);
+            for (auto index = next++; index < boards.size(); index = next++)
+                results[index] = solver.solve(boards[index]);
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; i++)
+            workers.emplace_back(work);
+        work();
+        for (auto& worker : workers)
+            worker.join();
+
+        return results;
+    }
+
+    MateConfig& MateSolver::config()
+    {
+        return _config;
+    }
+
+    bool MateSolver::attack(Board& board, unsigned moves)
+    {
+        ++_nodes;
+        const auto key     = board.getHash();
+        const auto refuted = _refuted.find(key);
+        if (refuted != _refuted.end() && refuted->second >= moves)
+            return false;
+
+        for (auto& movement : attackerMoves(board, moves))
+        {
+            makeMove(board, movement);
+            const auto mate = defend(board, moves);
+            board.unmakeMove();
+
+            if (mate)
+                return true;
+        }
+
+        auto& entry = _refuted[key];
+        entry       = std::max(entry, moves);
+        return false;
+    }
+
+    bool MateSolver::defend(Board& board, unsigned moves)
+    {
+        ++_nodes;
+        auto replies = legalMoves(board);
+        if (replies.empty())
+            return board.isCheck(board.getCurrentColorTurn());
+
+        if (moves == 1)
+            return false;
+
+        // captures are the most likely refutations
+        std::stable_partition(replies.begin(), replies.end(), [](Movement& movement) { return movement.hasFlag(EventFlag::capture); });
+        for (auto& movement : replies)
+        {
+            makeMove(board, movement);
+            const auto mate = attack(board, moves - 1);
+            board.unmakeMove();
+
+            if (!mate)
+                return false;
+        }
+
+        return true;
+    }
+
+    unsigned MateSolver::mateDistance(Board& board, unsigned moves)
+    {
+        for (unsigned distance = 1; distance <= moves; distance++)
+            if (attack(board, distance))
+                return distance;
+
+        return 0;
+    }
+
+    std::vector<Movement> MateSolver::attackerMoves(Board& board, unsigned moves)
+    {
+        auto result = legalMoves(board);
+
+        // with the last move only a check can mate, a promotion is checked after the new figure is placed
+        const auto isCheck = [](Movement& movement) { return movement.hasFlag(EventFlag::check) || movement.hasFlag(EventFlag::promotion); };
+        if (moves == 1 || _config.checksOnly)
+            result.erase(std::remove_if(result.begin(), result.end(), [&isCheck](Movement& movement) { return !isCheck(movement); }), result.end());
+        else
+            std::stable_partition(result.begin(), result.end(), isCheck);
+
+        return result;
+    }
+}
@@ -0,0 +1,136 @@
+/*!
+* \brief:  Declares the mate solver class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "ChessEngine/Board.h"
+
+namespace ChessNS
+{
+    /*!
+     * \struct  MateConfig
+     *
+     * \brief   The configuration of a mate solver.
+     */
+    struct MateConfig
+    {
+        /*! \brief   The longest mate searched for, in moves of the attacking color */
+        unsigned maxMoves{3};
+        /*! \brief   Only checking moves are tried for the attacking color, which misses mates with quiet moves */
+        bool checksOnly{false};
+        /*! \brief   The number of threads of solveAll, 0 for one per core */
+        unsigned threads{0};
+    };
+
+    /*!
+     * \struct  MateResult
+     *
+     * \brief   The result of a mate solver.
+     */
+    struct MateResult
+    {
+        /*! \brief   True if the color on turn forces a mate within the maximum number of moves */
+        bool found{};
+        /*! \brief   The number of moves of the attacking color up to the mate */
+        unsigned moves{};
+        /*! \brief   The shortest mate against the longest defense, starting with the move of the color on turn */
+        std::vector<Movement> line{};
+        /*! \brief   The number of visited nodes */
+        uint64_t nodes{};
+    };
+
+    /*!
+     * \class   MateSolver
+     *
+     * \brief   Searches only for forced mates of the color on turn. The number of moves is deepened one by one, so
+     *          the first mate found is the shortest one. On every attacking ply the checks are tried first and on
+     *          the last one only checks can mate, the defending color has to refute with every move. The positions
+     *          which have been refuted for a number of moves are remembered, so transpositions are not searched
+     *          again.
+     */
+    class MateSolver
+    {
+    public:
+
+        /*!
+         * \fn  explicit MateSolver::MateSolver(const MateConfig& config = MateConfig());
+         *
+         * \brief   Constructor
+         *
+         * \param   config  (Optional) The configuration.
+         */
+        explicit MateSolver(const MateConfig& config = MateConfig());
+
+        /*!
+         * \fn  MateResult MateSolver::solve(Board& board);
+         *
+         * \brief   Searches a forced mate for the color on turn
+         *
+         * \param [in,out]  board   The board, it is the same again when the search returns.
+         *
+         * \returns The MateResult.
+         */
+        MateResult solve(Board& board);
+
+        /*!
+         * \fn  static std::vector<MateResult> MateSolver::solveAll(std::vector<Board>& boards, const MateConfig& config = MateConfig());
+         *
+         * \brief   Solves many positions in parallel, every thread takes the next unsolved board
+         *
+         * \param [in,out]  boards  The boards, they are the same again when the function returns.
+         * \param           config  (Optional) The configuration.
+         *
+         * \returns The results in the order of the boards.
+         */
+        static std::vector<MateResult> solveAll(std::vector<Board>& boards, const MateConfig& config = MateConfig());
+
+        /*!
+         * \fn  MateConfig& MateSolver::config();
+         *
+         * \brief   Gets the configuration
+         *
+         * \returns A reference to the MateConfig.
+         */
+        MateConfig& config();
+
+    private:
+
+        bool attack(Board& board, unsigned moves);
+
+        bool defend(Board& board, unsigned moves);
+
+        unsigned mateDistance(Board& board, unsigned moves);
+
+        std::vector<Movement> attackerMoves(Board& board, unsigned moves);
+
+        MateConfig                             _config;
+        uint64_t                               _nodes{};
+        std::unordered_map<uint64_t, unsigned> _refuted;
+    };
+}
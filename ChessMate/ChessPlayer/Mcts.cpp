@@ -0,0 +1,281 @@
+/*!
+* \brief:  Implements the monte carlo tree search class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "Mcts.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace ChessNS
+{
+    // the points of a playout from the view of the color on turn, a draw counts half
+    static const int winPoints  = 2;
+    static const int drawPoints = 1;
+
+    enum NodeState : uint8_t { unexpanded, expanding, expanded, full };
+
+    Mcts::Mcts(const MctsConfig& config)
+        : _config(config) { }
+
+    Mcts::~Mcts() = default;
+
+    MctsResult Mcts::run(Board& board)
+    {
+        MctsResult result;
+        const auto start = std::chrono::steady_clock::now();
+
+        if (!_arena || _capacity != std::max<size_t>(1, _config.nodes))
+        {
+            _capacity = std::max<size_t>(1, _config.nodes);
+            _arena    = std::make_unique<Node[]>(_capacity);
+        }
+
+        auto& root = _arena[0];
+        root.state.store(unexpanded);
+        root.count.store(0);
+        root.visits.store(0);
+        root.points.store(0);
+        _used.store(1);
+        _playouts.store(0);
+        _stop.store(false);
+
+        auto                  threads = _config.threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : _config.threads;
+        std::vector<uint16_t> moves;
+        if (!expand(board, root, moves) || root.count.load() == 0)
+            return result;
+
+        const auto seed = _config.seeded ? _config.seed : static_cast<uint32_t>(std::random_device{}());
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; i++)
+            workers.emplace_back(&Mcts::work, this, std::cref(board), seed + i);
+        work(board, seed);
+        for (auto& worker : workers)
+            worker.join();
+
+        // the most visited move is the most reliable one
+        const Node* best = nullptr;
+        for (uint32_t i = 0; i < root.count.load(); i++)
+        {
+            const auto& child = _arena[root.first.load() + i];
+            if (!best || child.visits.load() > best->visits.load())
+                best = &child;
+        }
+
+        // the move is made once to get its flags, a pawn is promoted to a queen
+        result.bestMove = board.makeMove(MoveHistory::origin(best->move), MoveHistory::destination(best->move), FigureType::queen);
+        if (result.bestMove.isValid())
+            board.unmakeMove();
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        result.visits            = static_cast<uint64_t>(best->visits.load());
+        result.score             = result.visits ? best->points.load() / static_cast<float>(winPoints * result.visits) : 0.f;
+        result.playouts          = _playouts.load();
+        result.nodes             = std::min(_used.load(), _capacity);
+        result.milliseconds      = static_cast<uint64_t>(elapsed.count());
+        result.playoutsPerSecond = result.playouts * 1000 / std::max<uint64_t>(1, result.milliseconds);
+        return result;
+    }
+
+    MctsConfig& Mcts::config()
+    {
+        return _config;
+    }
+
+    void Mcts::work(const Board& root, unsigned seed)
+    {
+        auto                  board = root;
+        std::mt19937          random(seed);
+        std::vector<Node*>    path;
+        std::vector<uint16_t> moves;
+        const auto         start    = std::chrono::steady_clock::now();
+        const auto         deadline = start + std::chrono::milliseconds(_config.milliseconds);
+
+        while (!_stop.load(std::memory_order_relaxed))
+        {
+            // descend by PUCT, the virtual loss makes the path less attractive for the other threads
+            path.clear();
+            auto node = &_arena[0];
+            node->visits.fetch_add(_config.virtualLoss, std::memory_order_relaxed);
+            path.push_back(node);
+
+            for (;;)
+            {
+                if (node->state.load(std::memory_order_acquire) == unexpanded && !expand(board, *node, moves))
+                    break;
+                if (node->state.load(std::memory_order_acquire) != expanded || node->count.load() == 0)
+                    break;
+
+                node = &_arena[select(*node)];
+                node->visits.fetch_add(_config.virtualLoss, std::memory_order_relaxed);
+                path.push_back(node);
+                board.makeMove(MoveHistory::origin(node->move), MoveHistory::destination(node->move), FigureType::queen);
+
+                // a new leaf is played out before it is expanded
+                if (node->visits.load(std::memory_order_relaxed) <= _config.virtualLoss)
+                    break;
+            }
+
+            // the leaf is scored from the view of the color which moved into it
+            backup(path, winPoints - playout(board, random, moves), _config.virtualLoss);
+            for (size_t i = 1; i < path.size(); i++)
+                board.unmakeMove();
+
+            const auto playouts = _playouts.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (playouts >= _config.playouts)
+                _stop.store(true);
+            else if (_config.milliseconds != 0 && (playouts & 63) == 0 && std::chrono::steady_clock::now() >= deadline)
+                _stop.store(true);
+        }
+    }
+
+    uint32_t Mcts::select(const Node& node) const
+    {
+        const auto first   = node.first.load(std::memory_order_relaxed);
+        const auto count   = node.count.load(std::memory_order_relaxed);
+        const auto explore = _config.exploration * std::sqrt(static_cast<float>(std::max(1, node.visits.load(std::memory_order_relaxed))));
+
+        auto best      = first;
+        auto bestValue = -1.f;
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            const auto& child  = _arena[i];
+            const auto  visits = child.visits.load(std::memory_order_relaxed);
+
+            // unvisited moves are assumed to be a draw
+            const auto quality = visits > 0 ? child.points.load(std::memory_order_relaxed) / static_cast<float>(winPoints * visits) : 0.5f;
+            const auto value   = quality + explore * child.prior / static_cast<float>(1 + visits);
+            if (value > bestValue)
+            {
+                bestValue = value;
+                best      = i;
+            }
+        }
+
+        return best;
+    }
+
+    bool Mcts::expand(Board& board, Node& node, std::vector<uint16_t>& moves)
+    {
+        uint8_t state = unexpanded;
+        if (!node.state.compare_exchange_strong(state, expanding, std::memory_order_acq_rel))
+            return state == expanded;
+
+        board.getLegalMoves(moves);
+
+        // reserve a contiguous block of the arena, a full arena leaves the node a leaf for good
+        auto used = _used.load();
+        do
+        {
+            if (used + moves.size() > _capacity)
+            {
+                node.state.store(full, std::memory_order_release);
+                return false;
+            }
+        }
+        while (!_used.compare_exchange_weak(used, used + moves.size()));
+
+        // good captures and promotions are tried first
+        std::vector<float> weights(moves.size(), 1.f);
+        auto               sum = 0.f;
+        for (size_t i = 0; i < moves.size(); i++)
+        {
+            const auto origin      = MoveHistory::origin(moves[i]);
+            const auto destination = MoveHistory::destination(moves[i]);
+            const auto pawn        = board.at(origin).figure.getType() == FigureType::pawn;
+            const auto row         = destination.getCord().first;
+            const auto capture     = !board.at(destination).empty || (pawn && destination.getCord().second != origin.getCord().second);
+
+            if (pawn && (row == 0 || row == 7))
+                weights[i] += 3.f;
+            else if (capture && board.see(origin, destination) >= 0)
+                weights[i] += 2.f;
+            sum += weights[i];
+        }
+
+        for (size_t i = 0; i < moves.size(); i++)
+        {
+            auto& child = _arena[used + i];
+            child.first.store(0, std::memory_order_relaxed);
+            child.count.store(0, std::memory_order_relaxed);
+            child.state.store(unexpanded, std::memory_order_relaxed);
+            child.visits.store(0, std::memory_order_relaxed);
+            child.points.store(0, std::memory_order_relaxed);
+            child.move  = moves[i];
+            child.prior = weights[i] / sum;
+        }
+
+        node.first.store(static_cast<uint32_t>(used), std::memory_order_relaxed);
+        node.count.store(static_cast<uint16_t>(moves.size()), std::memory_order_relaxed);
+        node.state.store(expanded, std::memory_order_release);
+        return true;
+    }
+
+    int Mcts::playout(Board& board, std::mt19937& random, std::vector<uint16_t>& moves) const
+    {
+        auto       points = drawPoints;
+        unsigned   plies  = 0;
+
+        for (;; plies++)
+        {
+            board.getLegalMoves(moves);
+            if (moves.empty())
+            {
+                // checkmate or stalemate
+                points = board.isCheck(board.getCurrentColorTurn()) ? 0 : drawPoints;
+                break;
+            }
+
+            if (plies == _config.playoutPlies)
+            {
+                const auto score = board.evaluate();
+                points = score >= _config.winMargin ? winPoints : score <= -_config.winMargin ? 0 : drawPoints;
+                break;
+            }
+
+            const auto move = moves[std::uniform_int_distribution<size_t>(0, moves.size() - 1)(random)];
+            board.makeMove(MoveHistory::origin(move), MoveHistory::destination(move), FigureType::queen);
+        }
+
+        for (unsigned i = 0; i < plies; i++)
+            board.unmakeMove();
+
+        return plies % 2 == 0 ? points : winPoints - points;
+    }
+
+    void Mcts::backup(const std::vector<Node*>& path, int points, int virtualLoss)
+    {
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+        {
+            (*it)->visits.fetch_add(1 - virtualLoss, std::memory_order_relaxed);
+            (*it)->points.fetch_add(points, std::memory_order_relaxed);
+            points = winPoints - points;
+        }
+    }
+}
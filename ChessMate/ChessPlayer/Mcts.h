@@ -0,0 +1,168 @@
+/*!
+* \brief:  Declares the monte carlo tree search class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "ChessEngine/Board.h"
+#include "MoveHistory.h"
+
+namespace ChessNS
+{
+    /*!
+     * \struct  MctsConfig
+     *
+     * \brief   The configuration of a monte carlo tree search.
+     */
+    struct MctsConfig
+    {
+        /*! \brief   The number of threads which descend the shared tree, 0 for one per core */
+        unsigned threads{0};
+        /*! \brief   The number of playouts of a search */
+        uint64_t playouts{20000};
+        /*! \brief   The time of a search in milliseconds, 0 to only stop after the playouts */
+        unsigned milliseconds{0};
+        /*! \brief   The number of nodes of the arena, the tree stops growing when it is full */
+        size_t nodes{1 << 20};
+        /*! \brief   The exploration constant of the PUCT formula */
+        float exploration{1.5f};
+        /*! \brief   The number of lost visits a thread adds on its way down, so the other threads spread out */
+        int virtualLoss{3};
+        /*! \brief   A playout which did not end before this ply is scored by the evaluation of the board */
+        unsigned playoutPlies{40};
+        /*! \brief   The evaluation in centipawns from which a stopped playout counts as a win */
+        int winMargin{200};
+        /*! \brief   Use seed for the playouts instead of a random seed, the threads add their index to it */
+        bool seeded{false};
+        /*! \brief   The seed of the playouts if seeded is set */
+        uint32_t seed{};
+    };
+
+    /*!
+     * \struct  MctsResult
+     *
+     * \brief   The result of a monte carlo tree search.
+     */
+    struct MctsResult
+    {
+        /*! \brief   The most visited move, invalid if there is no legal move */
+        Movement bestMove{};
+        /*! \brief   The share of the points of the best move from the view of the color on turn, in [0, 1] */
+        float score{};
+        /*! \brief   The number of visits of the best move */
+        uint64_t visits{};
+        /*! \brief   The number of playouts of all threads */
+        uint64_t playouts{};
+        /*! \brief   The number of used nodes of the arena */
+        size_t nodes{};
+        /*! \brief   The time of the search in milliseconds */
+        uint64_t milliseconds{};
+        /*! \brief   The playouts per second of all threads */
+        uint64_t playoutsPerSecond{};
+    };
+
+    /*!
+     * \class   Mcts
+     *
+     * \brief   A monte carlo tree search which selects by the PUCT formula. The nodes live in an arena which is
+     *          allocated once, the children of a node are a contiguous block of it. All threads descend the same
+     *          tree and add a virtual loss to the nodes on their path, which is replaced by the real result of the
+     *          random playout at the leaf. The priors prefer captures and promotions.
+     */
+    class Mcts
+    {
+    public:
+
+        /*!
+         * \fn  explicit Mcts::Mcts(const MctsConfig& config = MctsConfig());
+         *
+         * \brief   Constructor, allocates the arena
+         *
+         * \param   config  (Optional) The configuration.
+         */
+        explicit Mcts(const MctsConfig& config = MctsConfig());
+
+        Mcts(const Mcts&) = delete;
+
+        Mcts& operator=(const Mcts&) = delete;
+
+        ~Mcts();
+
+        /*!
+         * \fn  MctsResult Mcts::run(Board& board);
+         *
+         * \brief   Searches the best move for the color on turn, the tree of the previous search is dropped
+         *
+         * \param [in,out]  board   The board, every thread plays on its own copy of it.
+         *
+         * \returns The MctsResult.
+         */
+        MctsResult run(Board& board);
+
+        /*!
+         * \fn  MctsConfig& Mcts::config();
+         *
+         * \brief   Gets the configuration, a changed number of nodes takes effect with the next search
+         *
+         * \returns A reference to the MctsConfig.
+         */
+        MctsConfig& config();
+
+    private:
+
+        struct Node
+        {
+            std::atomic<uint32_t> first{};
+            std::atomic<uint16_t> count{};
+            std::atomic<uint8_t>  state{};
+            PackedMove            move{};
+            float                 prior{};
+            std::atomic<int32_t>  visits{};
+            std::atomic<int32_t>  points{};
+        };
+
+        void work(const Board& root, unsigned seed);
+
+        uint32_t select(const Node& node) const;
+
+        bool expand(Board& board, Node& node, std::vector<uint16_t>& moves);
+
+        int playout(Board& board, std::mt19937& random, std::vector<uint16_t>& moves) const;
+
+        static void backup(const std::vector<Node*>& path, int points, int virtualLoss);
+
+        MctsConfig              _config;
+        std::unique_ptr<Node[]> _arena;
+        size_t                  _capacity{};
+        std::atomic<size_t>     _used{};
+        std::atomic<uint64_t>   _playouts{};
+        std::atomic<bool>       _stop{};
+    };
+}
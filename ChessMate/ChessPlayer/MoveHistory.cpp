@@ -0,0 +1,93 @@
+/*!
+* \brief:  Implements the move history heuristics
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "MoveHistory.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "ChessEngine/Bitboard.h"
+
+namespace ChessNS
+{
+    PackedMove MoveHistory::pack(Movement& movement)
+    {
+        return static_cast<PackedMove>(BitboardHelper::square(movement.origin())
+            | BitboardHelper::square(movement.destination()) << 6);
+    }
+
+    Position MoveHistory::origin(PackedMove move)
+    {
+        return BitboardHelper::position(move & 63);
+    }
+
+    Position MoveHistory::destination(PackedMove move)
+    {
+        return BitboardHelper::position(move >> 6 & 63);
+    }
+
+    void MoveHistory::clear()
+    {
+        std::memset(_killers, 0, sizeof(_killers));
+        std::memset(_history, 0, sizeof(_history));
+        std::memset(_counterMoves, 0, sizeof(_counterMoves));
+    }
+
+    PackedMove MoveHistory::killer(int ply, int slot) const
+    {
+        return ply < maxPly ? _killers[ply][slot] : 0;
+    }
+
+    void MoveHistory::addKiller(int ply, PackedMove move)
+    {
+        if (ply >= maxPly || _killers[ply][0] == move)
+            return;
+
+        _killers[ply][1] = _killers[ply][0];
+        _killers[ply][0] = move;
+    }
+
+    int MoveHistory::history(Color color, PackedMove move) const
+    {
+        return _history[color == Color::white ? 0 : 1][move];
+    }
+
+    void MoveHistory::updateHistory(Color color, PackedMove move, int bonus)
+    {
+        auto& entry = _history[color == Color::white ? 0 : 1][move];
+        bonus       = std::max(-historyMax, std::min(bonus, historyMax));
+        entry += bonus - entry * std::abs(bonus) / historyMax;
+    }
+
+    PackedMove MoveHistory::counterMove(PackedMove previous) const
+    {
+        return _counterMoves[previous];
+    }
+
+    void MoveHistory::setCounterMove(PackedMove previous, PackedMove move)
+    {
+        _counterMoves[previous] = move;
+    }
+}
@@ -0,0 +1,170 @@
+/*!
+* \brief:  Declares the move history heuristics
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include "ChessEngine/ChessTypes.h"
+
+namespace ChessNS
+{
+    /*!
+     * \typedef uint16_t PackedMove
+     *
+     * \brief   A move packed into 16 bits, the origin square in the low and the destination square in the next
+     *          6 bits. 0 is no move.
+     */
+    typedef uint16_t PackedMove;
+
+    /*!
+     * \class   MoveHistory
+     *
+     * \brief   The killer moves, the butterfly history and the countermoves collected during a search. Every
+     *          search thread owns one, so no synchronization is needed.
+     */
+    class MoveHistory
+    {
+    public:
+
+        /*! \brief   The number of plies which have killer slots */
+        static constexpr int maxPly = 128;
+
+        /*! \brief   The limit of a history value, the gravity keeps all values in [-historyMax, historyMax] */
+        static constexpr int historyMax = 16384;
+
+        /*!
+         * \fn  static PackedMove MoveHistory::pack(Movement& movement);
+         *
+         * \brief   Packs the origin and the destination of a movement
+         *
+         * \param [in,out]  movement    The movement.
+         *
+         * \returns The PackedMove.
+         */
+        static PackedMove pack(Movement& movement);
+
+        /*!
+         * \fn  static Position MoveHistory::origin(PackedMove move);
+         *
+         * \brief   Gets the origin of a packed move
+         *
+         * \param   move    The packed move.
+         *
+         * \returns The origin.
+         */
+        static Position origin(PackedMove move);
+
+        /*!
+         * \fn  static Position MoveHistory::destination(PackedMove move);
+         *
+         * \brief   Gets the destination of a packed move
+         *
+         * \param   move    The packed move.
+         *
+         * \returns The destination.
+         */
+        static Position destination(PackedMove move);
+
+        /*!
+         * \fn  void MoveHistory::clear();
+         *
+         * \brief   Forgets everything
+         */
+        void clear();
+
+        /*!
+         * \fn  PackedMove MoveHistory::killer(int ply, int slot) const;
+         *
+         * \brief   Gets a quiet move which caused a cutoff on the same ply
+         *
+         * \param   ply     The distance to the root.
+         * \param   slot    The slot, 0 is the most recent one.
+         *
+         * \returns The killer move, 0 if there is none.
+         */
+        PackedMove killer(int ply, int slot) const;
+
+        /*!
+         * \fn  void MoveHistory::addKiller(int ply, PackedMove move);
+         *
+         * \brief   Stores a quiet move which caused a cutoff, the older killer is moved to the second slot
+         *
+         * \param   ply     The distance to the root.
+         * \param   move    The move.
+         */
+        void addKiller(int ply, PackedMove move);
+
+        /*!
+         * \fn  int MoveHistory::history(Color color, PackedMove move) const;
+         *
+         * \brief   Gets the butterfly history of a quiet move
+         *
+         * \param   color   The color making the move.
+         * \param   move    The move.
+         *
+         * \returns The history value.
+         */
+        int history(Color color, PackedMove move) const;
+
+        /*!
+         * \fn  void MoveHistory::updateHistory(Color color, PackedMove move, int bonus);
+         *
+         * \brief   Adds a bonus or a malus to the history of a quiet move. The gravity reduces the change the
+         *          closer the value already is to the limit.
+         *
+         * \param   color   The color making the move.
+         * \param   move    The move.
+         * \param   bonus   The bonus, negative for a malus.
+         */
+        void updateHistory(Color color, PackedMove move, int bonus);
+
+        /*!
+         * \fn  PackedMove MoveHistory::counterMove(PackedMove previous) const;
+         *
+         * \brief   Gets the quiet move which refuted the previous move the last time
+         *
+         * \param   previous    The move made by the opponent.
+         *
+         * \returns The countermove, 0 if there is none.
+         */
+        PackedMove counterMove(PackedMove previous) const;
+
+        /*!
+         * \fn  void MoveHistory::setCounterMove(PackedMove previous, PackedMove move);
+         *
+         * \brief   Stores a quiet move which refuted the previous move
+         *
+         * \param   previous    The move made by the opponent.
+         * \param   move        The refutation.
+         */
+        void setCounterMove(PackedMove previous, PackedMove move);
+
+    private:
+
+        PackedMove _killers[maxPly][2]{};
+        int        _history[2][4096]{};
+        PackedMove _counterMoves[4096]{};
+    };
+}
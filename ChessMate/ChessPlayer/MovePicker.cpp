@@ -0,0 +1,184 @@
+/*!
+* \brief:  Implements the staged move picker
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "MovePicker.h"
+#include <climits>
+
+namespace ChessNS
+{
+    MovePicker::MovePicker(Board& board, const MoveHistory& history, PackedMove ttMove, int ply, PackedMove previous)
+        : _board(board),
+          _history(history),
+          _color(board.getCurrentColorTurn()),
+          _ttMove(ttMove)
+    {
+        _refutations[0] = history.killer(ply, 0);
+        _refutations[1] = history.killer(ply, 1);
+        _refutations[2] = previous != 0 ? history.counterMove(previous) : 0;
+    }
+
+    bool MovePicker::next(Movement& movement)
+    {
+        switch (_stage)
+        {
+            case Stage::ttMove:
+                _stage = Stage::generateCaptures;
+                if (_ttMove != 0 && tryMove(_ttMove, movement))
+                    return true;
+                // fall through
+
+            case Stage::generateCaptures:
+                _moves = _board.getAllPossibleCaptures(_color);
+                _scores.resize(_moves.size());
+                for (size_t i = 0; i < _moves.size(); i++)
+                {
+                    // most valuable victim first, least valuable attacker breaks ties, en passant has an empty destination
+                    auto&       capture = _moves[i];
+                    const auto& victim  = _board.at(capture.destination());
+                    _scores[i]          = 10 * ChessTypes::getFigureValue(victim.empty ? FigureType::pawn : victim.figure.getType())
+                        - ChessTypes::getFigureValue(capture.figureType()) / 100;
+
+                    if (!capture.hasFlag(EventFlag::capture))
+                        _scores[i] = 10 * ChessTypes::getFigureValue(FigureType::queen);
+                }
+                _stage = Stage::goodCaptures;
+                // fall through
+
+            case Stage::goodCaptures:
+                while (_index < _moves.size())
+                {
+                    ++_index;
+                    auto& capture = _moves[pickNext()];
+                    if (MoveHistory::pack(capture) == _ttMove)
+                        continue;
+
+                    if (!capture.hasFlag(EventFlag::promotion) && _board.see(capture) < 0)
+                    {
+                        _badCaptures.emplace_back(capture);
+                        continue;
+                    }
+
+                    movement = capture;
+                    return true;
+                }
+                _index = 0;
+                _stage = Stage::refutations;
+                // fall through
+
+            case Stage::refutations:
+                while (_index < 3)
+                {
+                    const auto move = _refutations[_index++];
+                    if (move == 0 || move == _ttMove)
+                        continue;
+
+                    // the countermove may be one of the killers
+                    if (_index == 3 && (move == _refutations[0] || move == _refutations[1]))
+                        continue;
+
+                    if (tryMove(move, movement))
+                    {
+                        if (!movement.hasFlag(EventFlag::capture) && !movement.hasFlag(EventFlag::promotion))
+                            return true;
+                    }
+                }
+                _stage = Stage::generateQuiets;
+                // fall through
+
+            case Stage::generateQuiets:
+                _moves = _board.getAllPossibleQuietMoves(_color);
+                _scores.resize(_moves.size());
+                for (size_t i = 0; i < _moves.size(); i++)
+                    _scores[i] = _history.history(_color, MoveHistory::pack(_moves[i]));
+                _index = 0;
+                _stage = Stage::quiets;
+                // fall through
+
+            case Stage::quiets:
+                while (_index < _moves.size())
+                {
+                    ++_index;
+                    auto& quiet = _moves[pickNext()];
+                    if (!isSpecial(MoveHistory::pack(quiet)))
+                    {
+                        movement = quiet;
+                        return true;
+                    }
+                }
+                _index = 0;
+                _stage = Stage::badCaptures;
+                // fall through
+
+            case Stage::badCaptures:
+                if (_index < _badCaptures.size())
+                {
+                    movement = _badCaptures[_index++];
+                    return true;
+                }
+                _stage = Stage::done;
+                // fall through
+
+            default:
+                return false;
+        }
+    }
+
+    MovePicker::Stage MovePicker::stage() const
+    {
+        return _stage;
+    }
+
+    bool MovePicker::tryMove(PackedMove move, Movement& movement)
+    {
+        // a move from the table or the heuristics may come from a different position
+        auto result = _board.makeMove(MoveHistory::origin(move), MoveHistory::destination(move), FigureType::queen);
+        if (!result.isValid())
+            return false;
+
+        _board.unmakeMove();
+        if (result.color() != _color)
+            return false;
+
+        movement = result;
+        return true;
+    }
+
+    bool MovePicker::isSpecial(PackedMove move) const
+    {
+        return move == _ttMove || move == _refutations[0] || move == _refutations[1] || move == _refutations[2];
+    }
+
+    size_t MovePicker::pickNext()
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < _scores.size(); i++)
+            if (_scores[i] > _scores[best])
+                best = i;
+
+        _scores[best] = INT_MIN;
+        return best;
+    }
+}
@@ -0,0 +1,105 @@
+/*!
+* \brief:  Declares the staged move picker
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <vector>
+#include "ChessEngine/Board.h"
+#include "MoveHistory.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   MovePicker
+     *
+     * \brief   Yields the moves of a position in the order the search wants to try them: the move of the
+     *          transposition table, the captures which do not lose material, the killers and the countermove,
+     *          the quiet moves by history and finally the losing captures. The moves of a stage are only
+     *          generated when it is reached, so a cutoff on an early move saves the rest of the generation.
+     */
+    class MovePicker
+    {
+    public:
+
+        /*!
+         * \enum    Stage
+         *
+         * \brief   Values that represent the stages of the picker
+         */
+        enum class Stage { ttMove, generateCaptures, goodCaptures, refutations, generateQuiets, quiets, badCaptures, done };
+
+        /*!
+         * \fn  MovePicker::MovePicker(Board& board, const MoveHistory& history, PackedMove ttMove, int ply, PackedMove previous);
+         *
+         * \brief   Constructor
+         *
+         * \param [in,out]  board       The board, it must not be changed between the calls of next.
+         * \param           history     The heuristics of the search.
+         * \param           ttMove      The move of the transposition table, 0 if there is none.
+         * \param           ply         The distance to the root.
+         * \param           previous    The move made by the opponent, 0 if there is none.
+         */
+        MovePicker(Board& board, const MoveHistory& history, PackedMove ttMove, int ply, PackedMove previous);
+
+        /*!
+         * \fn  bool MovePicker::next(Movement& movement);
+         *
+         * \brief   Gets the next legal move
+         *
+         * \param [out] movement    The move with all its flags.
+         *
+         * \returns True if there was one, false if all moves were yielded.
+         */
+        bool next(Movement& movement);
+
+        /*!
+         * \fn  Stage MovePicker::stage() const;
+         *
+         * \brief   Gets the current stage
+         *
+         * \returns The stage.
+         */
+        Stage stage() const;
+
+    private:
+
+        bool tryMove(PackedMove move, Movement& movement);
+
+        bool isSpecial(PackedMove move) const;
+
+        size_t pickNext();
+
+        Board&                _board;
+        const MoveHistory&    _history;
+        Color                 _color;
+        Stage                 _stage{Stage::ttMove};
+        PackedMove            _ttMove;
+        PackedMove            _refutations[3]{};
+        size_t                _index{};
+        std::vector<Movement> _moves;
+        std::vector<int>      _scores;
+        std::vector<Movement> _badCaptures;
+    };
+}
@@ -0,0 +1,126 @@
+/*!
+* \brief:  Implements the opening book class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "OpeningBook.h"
+#include <map>
+#include <mutex>
+
+namespace ChessNS
+{
+    std::shared_ptr<const OpeningBook> OpeningBook::open(const std::string& filename)
+    {
+        static std::mutex                                              mutex;
+        static std::map<std::string, std::weak_ptr<const OpeningBook>> books;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto                        book = books[filename].lock();
+        if (book)
+            return book;
+
+        MappedFile file;
+        if (!file.open(filename) || file.size() % Polyglot::entrySize != 0)
+            return nullptr;
+
+        book            = std::shared_ptr<const OpeningBook>(new OpeningBook(std::move(file)));
+        books[filename] = book;
+        return book;
+    }
+
+    OpeningBook::OpeningBook(MappedFile&& file)
+        : _file(std::move(file)),
+          _size(_file.size() / Polyglot::entrySize)
+    {
+    }
+
+    size_t OpeningBook::size() const
+    {
+        return _size;
+    }
+
+    std::vector<PolyglotEntry> OpeningBook::find(uint64_t key) const
+    {
+        // the first entry which is not less than the key
+        size_t first = 0;
+        size_t count = _size;
+        while (count > 0)
+        {
+            const auto half = count / 2;
+            if (keyAt(first + half) < key)
+            {
+                first += half + 1;
+                count -= half + 1;
+            }
+            else
+                count = half;
+        }
+
+        std::vector<PolyglotEntry> result;
+        for (auto index = first; index < _size && keyAt(index) == key; index++)
+            result.push_back(Polyglot::read(_file.data() + index * Polyglot::entrySize));
+
+        return result;
+    }
+
+    Movement OpeningBook::probe(Board& board, std::mt19937& random) const
+    {
+        std::vector<Movement> movements;
+        std::vector<uint32_t> weights;
+        uint32_t              sum = 0;
+
+        for (const auto& entry : find(Polyglot::key(board)))
+        {
+            auto movement = Polyglot::decode(board, entry.move);
+            if (!movement.isValid() || entry.weight == 0)
+                continue;
+
+            movements.push_back(movement);
+            weights.push_back(entry.weight);
+            sum += entry.weight;
+        }
+
+        if (sum == 0)
+            return Movement::invalid();
+
+        auto choice = std::uniform_int_distribution<uint32_t>(0, sum - 1)(random);
+        for (size_t i = 0; i < movements.size(); i++)
+        {
+            if (choice < weights[i])
+                return movements[i];
+            choice -= weights[i];
+        }
+
+        return Movement::invalid();
+    }
+
+    uint64_t OpeningBook::keyAt(size_t index) const
+    {
+        const auto* data = _file.data() + index * Polyglot::entrySize;
+        uint64_t    key  = 0;
+        for (size_t i = 0; i < 8; i++)
+            key = key << 8 | data[i];
+        return key;
+    }
+}
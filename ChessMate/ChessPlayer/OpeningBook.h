@@ -0,0 +1,100 @@
+/*!
+* \brief:  Declares the opening book class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "BasicUtils/MappedFile.h"
+#include "Polyglot.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   OpeningBook
+     *
+     * \brief   A Polyglot opening book. The file is mapped into the memory and searched binary by the key, so
+     *          opening does not read or parse anything. A book is read only and can be shared by all players.
+     */
+    class OpeningBook
+    {
+    public:
+
+        /*!
+         * \fn  static std::shared_ptr<const OpeningBook> OpeningBook::open(const std::string& filename);
+         *
+         * \brief   Opens a book, a book which is already open in this process is shared
+         *
+         * \param   filename    The filename.
+         *
+         * \returns The book, nullptr if the file can not be mapped or its size is no multiple of the entry size.
+         */
+        static std::shared_ptr<const OpeningBook> open(const std::string& filename);
+
+        /*!
+         * \fn  size_t OpeningBook::size() const;
+         *
+         * \brief   Gets the number of entries
+         *
+         * \returns The number of entries.
+         */
+        size_t size() const;
+
+        /*!
+         * \fn  std::vector<PolyglotEntry> OpeningBook::find(uint64_t key) const;
+         *
+         * \brief   Finds the entries of a position
+         *
+         * \param   key The Polyglot key of the position.
+         *
+         * \returns The entries, empty if the position is not in the book.
+         */
+        std::vector<PolyglotEntry> find(uint64_t key) const;
+
+        /*!
+         * \fn  Movement OpeningBook::probe(Board& board, std::mt19937& random) const;
+         *
+         * \brief   Chooses a move for the color on turn, each one with the chance of its part of the weights
+         *
+         * \param [in,out]  board   The board.
+         * \param [in,out]  random  The random number generator.
+         *
+         * \returns The movement, invalid if the position is not in the book or has no possible move with a weight.
+         */
+        Movement probe(Board& board, std::mt19937& random) const;
+
+    private:
+
+        explicit OpeningBook(MappedFile&& file);
+
+        uint64_t keyAt(size_t index) const;
+
+        MappedFile _file;
+        size_t     _size{};
+    };
+}
@@ -0,0 +1,179 @@
+/*!
+* \brief:  Implements the pawn hash table
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "PawnHashTable.h"
+#include <algorithm>
+
+namespace ChessNS
+{
+    static const Bitboard columnA = 0x0101010101010101ull;
+
+    // the fields of the rows in front of a row, seen from a color
+    static Bitboard rowsInFront(Color color, int row)
+    {
+        if (color == Color::white)
+            return row < 7 ? ~Bitboard(0) << 8 * (row + 1) : 0;
+        return (Bitboard(1) << 8 * row) - 1;
+    }
+
+    PawnHashTable::PawnHashTable(size_t megabytes)
+    {
+        size_t count = 1;
+        while (count * 2 * sizeof(PawnEntry) <= megabytes * 1024 * 1024)
+            count *= 2;
+
+        _entries.resize(count);
+    }
+
+    const PawnEntry& PawnHashTable::probe(const Board& board)
+    {
+        // entries of other evaluation parameters never match
+        const auto key   = board.getPawnHash() ^ board.getEvalGeneration() * 0x9E3779B97F4A7C15ull;
+        auto&      entry = _entries[key & (_entries.size() - 1)];
+
+        ++_probes;
+        if (entry.filled && entry.key == key)
+        {
+            ++_hits;
+            return entry;
+        }
+
+        evaluate(board, entry);
+        entry.key    = key;
+        entry.filled = true;
+        return entry;
+    }
+
+    void PawnHashTable::clear()
+    {
+        std::fill(_entries.begin(), _entries.end(), PawnEntry());
+        _probes = 0;
+        _hits   = 0;
+    }
+
+    uint64_t PawnHashTable::probes() const
+    {
+        return _probes;
+    }
+
+    uint64_t PawnHashTable::hits() const
+    {
+        return _hits;
+    }
+
+    void PawnHashTable::evaluate(const Board& board, PawnEntry& entry)
+    {
+        const auto& params = board.getEvalParams();
+        entry.score[0]     = 0;
+        entry.score[1]     = 0;
+
+        for (auto color : {Color::white, Color::black})
+        {
+            const auto side  = color == Color::white ? 0 : 1;
+            const auto sign  = color == Color::white ? 1 : -1;
+            const auto own   = board.getFigures(color, FigureType::pawn);
+            const auto enemy = board.getFigures(ChessTypes::getOpponent(color), FigureType::pawn);
+            auto       pawns = own;
+
+            entry.passed[side] = 0;
+            while (pawns != 0)
+            {
+                const auto square     = BitboardHelper::popLsb(pawns);
+                const auto row        = square / 8;
+                const auto column     = square % 8;
+                const auto rank       = color == Color::white ? row : 7 - row;
+                const auto front      = rowsInFront(color, row);
+                const auto file       = columnA << column;
+                const auto neighbours = (column > 0 ? columnA << (column - 1) : 0) | (column < 7 ? columnA << (column + 1) : 0);
+
+                int terms[2] = {0, 0};
+                if ((enemy & (file | neighbours) & front) == 0)
+                {
+                    entry.passed[side] |= BitboardHelper::bit(square);
+                    terms[0] += params.passed[0][rank];
+                    terms[1] += params.passed[1][rank];
+                }
+
+                if ((own & file & front) != 0)
+                {
+                    terms[0] += params.doubled[0];
+                    terms[1] += params.doubled[1];
+                }
+
+                if ((own & neighbours) == 0)
+                {
+                    terms[0] += params.isolated[0];
+                    terms[1] += params.isolated[1];
+                }
+                else if ((own & neighbours & ~front) == 0 && rank < 7)
+                {
+                    // no pawn beside or behind can support it and the next field is guarded
+                    const auto stop = square + (color == Color::white ? 8 : -8);
+                    if ((AttackTables::pawnAttacks(color, stop) & enemy) != 0)
+                    {
+                        terms[0] += params.backward[0];
+                        terms[1] += params.backward[1];
+                    }
+                }
+
+                entry.score[0] += sign * terms[0];
+                entry.score[1] += sign * terms[1];
+            }
+        }
+    }
+
+    int PawnHashTable::shieldPawns(const Board& board)
+    {
+        auto result = 0;
+        for (auto color : {Color::white, Color::black})
+        {
+            const auto king = board.getFigures(color, FigureType::king);
+            if (king == 0)
+                continue;
+
+            const auto square    = BitboardHelper::lsb(king);
+            const auto row       = square / 8;
+            const auto column    = square % 8;
+            const auto direction = color == Color::white ? 1 : -1;
+
+            Bitboard shield = 0;
+            for (int step = 1; step <= 2; step++)
+            {
+                const auto shieldRow = row + direction * step;
+                if (shieldRow < 0 || shieldRow > 7)
+                    continue;
+
+                for (int c = std::max(0, column - 1); c <= std::min(7, column + 1); c++)
+                    shield |= BitboardHelper::bit(shieldRow * 8 + c);
+            }
+
+            const auto count = BitboardHelper::count(shield & board.getFigures(color, FigureType::pawn));
+            result += color == Color::white ? count : -count;
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,135 @@
+/*!
+* \brief:  Declares the pawn hash table
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "ChessEngine/Board.h"
+
+namespace ChessNS
+{
+    /*!
+     * \struct  PawnEntry
+     *
+     * \brief   The evaluated pawn structure of a position.
+     */
+    struct PawnEntry
+    {
+        /*! \brief   The pawn hash of the position mixed with the generation of the evaluation parameters */
+        uint64_t key{};
+        /*! \brief   True if the entry holds a pawn structure */
+        bool filled{};
+        /*! \brief   The score of passed, isolated, doubled and backward pawns per phase from the view of white */
+        int score[2]{};
+        /*! \brief   The passed pawns of white and black */
+        Bitboard passed[2]{};
+    };
+
+    /*!
+     * \class   PawnHashTable
+     *
+     * \brief   A cache of evaluated pawn structures. Sibling nodes of a search almost always share their pawns,
+     *          so nearly every probe is a hit. Every search thread owns one.
+     */
+    class PawnHashTable
+    {
+    public:
+
+        /*!
+         * \fn  explicit PawnHashTable::PawnHashTable(size_t megabytes);
+         *
+         * \brief   Constructor
+         *
+         * \param   megabytes   The size of the table in megabytes, rounded down to a power of two entries.
+         */
+        explicit PawnHashTable(size_t megabytes);
+
+        /*!
+         * \fn  const PawnEntry& PawnHashTable::probe(const Board& board);
+         *
+         * \brief   Gets the evaluated pawn structure of a position, it is evaluated and stored if not found. An
+         *          entry evaluated with other parameters of the board is not found.
+         *
+         * \param   board   The board.
+         *
+         * \returns The entry, valid until the next probe.
+         */
+        const PawnEntry& probe(const Board& board);
+
+        /*!
+         * \fn  void PawnHashTable::clear();
+         *
+         * \brief   Removes all entries and resets the statistics
+         */
+        void clear();
+
+        /*!
+         * \fn  uint64_t PawnHashTable::probes() const;
+         *
+         * \brief   Gets the number of probes
+         *
+         * \returns The number of probes.
+         */
+        uint64_t probes() const;
+
+        /*!
+         * \fn  uint64_t PawnHashTable::hits() const;
+         *
+         * \brief   Gets the number of probes which found the pawn structure
+         *
+         * \returns The number of hits.
+         */
+        uint64_t hits() const;
+
+        /*!
+         * \fn  static void PawnHashTable::evaluate(const Board& board, PawnEntry& entry);
+         *
+         * \brief   Evaluates the pawn structure without the table
+         *
+         * \param           board   The board.
+         * \param [out]     entry   The entry to fill.
+         */
+        static void evaluate(const Board& board, PawnEntry& entry);
+
+        /*!
+         * \fn  static int PawnHashTable::shieldPawns(const Board& board);
+         *
+         * \brief   Counts the own pawns on the two rows in front of the king and the columns around it. It depends
+         *          on the king, so it is not part of the cached entry.
+         *
+         * \param   board   The board.
+         *
+         * \returns The number of shield pawns of white minus the number of shield pawns of black.
+         */
+        static int shieldPawns(const Board& board);
+
+    private:
+
+        std::vector<PawnEntry> _entries;
+        uint64_t               _probes{};
+        uint64_t               _hits{};
+    };
+}
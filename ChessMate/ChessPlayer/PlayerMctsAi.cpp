@@ -0,0 +1,90 @@
+/*!
+* \brief:  Implements the player mcts ai class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "PlayerMctsAi.h"
+
+namespace ChessNS
+{
+    Movement PlayerMctsAi::move(const Movement&)
+    {
+        return autoMove();
+    }
+
+    Movement PlayerMctsAi::move(const Position&, const Position&)
+    {
+        return autoMove();
+    }
+
+    bool PlayerMctsAi::changePromotedPawn(FigureType toType)
+    {
+        if (!_board)
+            return false;
+
+        return _board->changeFigureType(_lastValidMovement.destination(), toType);
+    }
+
+    void PlayerMctsAi::setBoard(const std::shared_ptr<Board>& board)
+    {
+        _board = board;
+    }
+
+    void PlayerMctsAi::setSeed(uint32_t seed)
+    {
+        _mcts.config().seed   = seed;
+        _mcts.config().seeded = true;
+    }
+
+    MctsConfig& PlayerMctsAi::mctsConfig()
+    {
+        return _mcts.config();
+    }
+
+    const MctsResult& PlayerMctsAi::lastResult() const
+    {
+        return _lastResult;
+    }
+
+    Movement PlayerMctsAi::autoMove()
+    {
+        if (!_board || _board->hasEnded() || _board->getCurrentColorTurn() != _playerColor)
+            return Movement::invalid();
+
+        auto board    = *_board;
+        _lastResult   = _mcts.run(board);
+        auto movement = _lastResult.bestMove;
+        if (!movement.isValid())
+            return Movement::invalid();
+
+        auto res = _board->move(movement);
+        if (res.isValid())
+        {
+            _lastValidMovement = res;
+            if (_lastValidMovement.hasFlag(EventFlag::promotion))
+                changePromotedPawn(movement.promotedTo());
+        }
+        return res;
+    }
+}
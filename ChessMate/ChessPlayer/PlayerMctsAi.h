@@ -0,0 +1,86 @@
+/*!
+* \brief:  Declares the player mcts ai class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <memory>
+#include "IPlayer.h"
+#include "Mcts.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   PlayerMctsAi
+     *
+     * \brief   A player which searches its moves with a monte carlo tree search.
+     */
+    class PlayerMctsAi : public IPlayer
+    {
+    public:
+
+        Movement move(const Movement& move) override;
+
+        Movement move(const Position& origin, const Position& destination) override;
+
+        bool changePromotedPawn(FigureType toType) override;
+
+        void setBoard(const std::shared_ptr<Board>& board) override;
+
+        void setSeed(uint32_t seed) override;
+
+        /*!
+         * \fn  MctsConfig& PlayerMctsAi::mctsConfig();
+         *
+         * \brief   Gets the configuration of the search
+         *
+         * \returns A reference to the MctsConfig.
+         */
+        MctsConfig& mctsConfig();
+
+        /*!
+         * \fn  const MctsResult& PlayerMctsAi::lastResult() const;
+         *
+         * \brief   Gets the result of the last search, e.g. for the playouts per second
+         *
+         * \returns A reference to the MctsResult.
+         */
+        const MctsResult& lastResult() const;
+
+    private:
+
+        /*!
+         * \fn  Movement PlayerMctsAi::autoMove();
+         *
+         * \brief   Automatic determine move
+         *
+         * \returns A Movement.
+         */
+        Movement autoMove();
+
+        Movement   _lastValidMovement{};
+        Mcts       _mcts;
+        MctsResult _lastResult{};
+    };
+}
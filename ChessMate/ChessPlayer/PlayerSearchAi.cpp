@@ -0,0 +1,165 @@
+/*!
+* \brief:  Implements the player search ai class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "PlayerSearchAi.h"
+
+namespace ChessNS
+{
+    PlayerSearchAi::~PlayerSearchAi()
+    {
+        stopPondering(nullptr);
+    }
+
+    Movement PlayerSearchAi::move(const Movement&)
+    {
+        return autoMove();
+    }
+
+    Movement PlayerSearchAi::move(const Position&, const Position&)
+    {
+        return autoMove();
+    }
+
+    bool PlayerSearchAi::changePromotedPawn(FigureType toType)
+    {
+        if (!_board)
+            return false;
+
+        return _board->changeFigureType(_lastValidMovement.destination(), toType);
+    }
+
+    void PlayerSearchAi::setBoard(const std::shared_ptr<Board>& board)
+    {
+        stopPondering(nullptr);
+        _board = board;
+    }
+
+    void PlayerSearchAi::setSeed(uint32_t seed)
+    {
+        _random.seed(seed);
+    }
+
+    SearchConfig& PlayerSearchAi::searchConfig()
+    {
+        return _search.config();
+    }
+
+    void PlayerSearchAi::setOpeningBook(std::shared_ptr<const OpeningBook> book)
+    {
+        _book = std::move(book);
+    }
+
+    void PlayerSearchAi::setPondering(bool ponder)
+    {
+        _ponder = ponder;
+        if (!_ponder)
+            stopPondering(nullptr);
+    }
+
+    Movement PlayerSearchAi::ponderMove() const
+    {
+        return _ponderThread.joinable() ? _ponderMove : Movement::invalid();
+    }
+
+    unsigned PlayerSearchAi::ponderHits() const
+    {
+        return _ponderHits;
+    }
+
+    const SearchResult& PlayerSearchAi::lastResult() const
+    {
+        return _lastResult;
+    }
+
+    Movement PlayerSearchAi::autoMove()
+    {
+        if (!_board || _board->hasEnded() || _board->getCurrentColorTurn() != _playerColor)
+            return Movement::invalid();
+
+        auto board    = *_board;
+        auto movement = _book ? _book->probe(board, _random) : Movement::invalid();
+        // a book move needs no search, so the ponder search is stopped at once and not waited for. There is no
+        // principal variation to ponder on after it.
+        if (movement.isValid())
+            _lastResult = SearchResult();
+        if (stopPondering(movement.isValid() ? nullptr : &board))
+        {
+            _lastResult = _ponderResult;
+            movement    = _lastResult.bestMove;
+            ++_ponderHits;
+        }
+
+        if (!movement.isValid())
+        {
+            _lastResult = _search.run(board);
+            movement    = _lastResult.bestMove;
+        }
+        if (!movement.isValid())
+            return Movement::invalid();
+
+        auto res = _board->move(movement);
+        if (res.isValid())
+        {
+            _lastValidMovement = res;
+            if (_lastValidMovement.hasFlag(EventFlag::promotion))
+                changePromotedPawn(movement.promotedTo());
+            if (_ponder)
+                startPondering();
+        }
+        return res;
+    }
+
+    void PlayerSearchAi::startPondering()
+    {
+        // the second move of the principal variation is the expected reply
+        if (_board->hasEnded() || _lastResult.lines.empty() || _lastResult.lines.front().moves.size() < 2)
+            return;
+
+        _ponderMove  = _lastResult.lines.front().moves[1];
+        _ponderBoard = *_board;
+        if (!_ponderBoard.makeMove(_ponderMove.origin(), _ponderMove.destination(), _ponderMove.promotedTo()).isValid())
+            return;
+
+        _ponderHash   = _ponderBoard.getHash();
+        _ponderResult = SearchResult();
+        _ponderThread = std::thread([this] { _ponderResult = _search.run(_ponderBoard); });
+    }
+
+    bool PlayerSearchAi::stopPondering(Board* board)
+    {
+        if (!_ponderThread.joinable())
+            return false;
+
+        // on a hit the search continues until it is finished, otherwise it is stopped at once
+        const auto hit = board && board->getHash() == _ponderHash;
+        if (!hit)
+            _search.setStopped(true);
+
+        _ponderThread.join();
+        _search.setStopped(false);
+        return hit && _ponderResult.bestMove.isValid();
+    }
+}
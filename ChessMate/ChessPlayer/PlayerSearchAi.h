@@ -0,0 +1,142 @@
+/*!
+* \brief:  Declares the player search ai class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <memory>
+#include <random>
+#include <thread>
+#include "IPlayer.h"
+#include "OpeningBook.h"
+#include "Search.h"
+
+namespace ChessNS
+{
+    /*!
+     * \class   PlayerSearchAi
+     *
+     * \brief   A player which searches its moves with an alpha beta search. While pondering it searches the
+     *          position after the expected reply in the background until its next move is requested.
+     */
+    class PlayerSearchAi : public IPlayer
+    {
+    public:
+
+        ~PlayerSearchAi() override;
+
+        Movement move(const Movement& move) override;
+
+        Movement move(const Position& origin, const Position& destination) override;
+
+        bool changePromotedPawn(FigureType toType) override;
+
+        void setBoard(const std::shared_ptr<Board>& board) override;
+
+        void setSeed(uint32_t seed) override;
+
+        /*!
+         * \fn  SearchConfig& PlayerSearchAi::searchConfig();
+         *
+         * \brief   Gets the configuration of the search
+         *
+         * \returns A reference to the SearchConfig.
+         */
+        SearchConfig& searchConfig();
+
+        /*!
+         * \fn  void PlayerSearchAi::setOpeningBook(std::shared_ptr<const OpeningBook> book);
+         *
+         * \brief   Sets an opening book, its moves are played without a search as long as the position is in it
+         *
+         * \param   book    The book, nullptr to always search.
+         */
+        void setOpeningBook(std::shared_ptr<const OpeningBook> book);
+
+        /*!
+         * \fn  void PlayerSearchAi::setPondering(bool ponder);
+         *
+         * \brief   Searches the expected reply while the opponent thinks. If the opponent plays it the running
+         *          search is finished and answers, otherwise it is stopped and a new search starts.
+         *
+         * \param   ponder  True to ponder after every own move.
+         */
+        void setPondering(bool ponder);
+
+        /*!
+         * \fn  Movement PlayerSearchAi::ponderMove() const;
+         *
+         * \brief   Gets the expected reply of the opponent which is searched in the background
+         *
+         * \returns The Movement, invalid if there is no pondering search.
+         */
+        Movement ponderMove() const;
+
+        /*!
+         * \fn  unsigned PlayerSearchAi::ponderHits() const;
+         *
+         * \brief   Gets the number of moves which were answered by the pondering search
+         *
+         * \returns The number of hits.
+         */
+        unsigned ponderHits() const;
+
+        /*!
+         * \fn  const SearchResult& PlayerSearchAi::lastResult() const;
+         *
+         * \brief   Gets the result of the search of the last move
+         *
+         * \returns A reference to the SearchResult.
+         */
+        const SearchResult& lastResult() const;
+
+    private:
+
+        /*!
+         * \fn  Movement PlayerSearchAi::autoMove();
+         *
+         * \brief   Automatic determine move
+         *
+         * \returns A Movement.
+         */
+        Movement autoMove();
+
+        void startPondering();
+
+        bool stopPondering(Board* board);
+
+        Movement                           _lastValidMovement{};
+        Search                             _search;
+        std::shared_ptr<const OpeningBook> _book;
+        std::mt19937                       _random{std::random_device{}()};
+        SearchResult                       _lastResult{};
+        bool                               _ponder{false};
+        std::thread                        _ponderThread;
+        Board                              _ponderBoard;
+        Movement                           _ponderMove{};
+        uint64_t                           _ponderHash{};
+        SearchResult                       _ponderResult{};
+        unsigned                           _ponderHits{};
+    };
+}
@@ -58,6 +58,11 @@ namespace ChessNS
         _board = board;
     }
 
+    void PlayerSimpleAi::setSeed(uint32_t seed)
+    {
+        _gen.seed(seed);
+    }
+
     Movement PlayerSimpleAi::autoMove()
     {
         if (!_board)
@@ -49,6 +49,8 @@ namespace ChessNS
 
         void setBoard(const std::shared_ptr<Board>& board) override;
 
+        void setSeed(uint32_t seed) override;
+
     private:
 
         /*!
@@ -0,0 +1,122 @@
+/*!
+* \brief:  Declares the polyglot book format
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include "ChessEngine/Board.h"
+
+namespace ChessNS
+{
+    /*!
+     * \struct  PolyglotEntry
+     *
+     * \brief   A move of a position in a Polyglot opening book.
+     */
+    struct PolyglotEntry
+    {
+        /*! \brief   The Polyglot key of the position */
+        uint64_t key{};
+        /*! \brief   The move, from and to square and the promotion in 3 bit fields each */
+        uint16_t move{};
+        /*! \brief   The weight, the chance to play the move is its part of the sum of the position */
+        uint16_t weight{};
+        /*! \brief   Learning data, unused */
+        uint32_t learn{};
+    };
+
+    /*!
+     * \class   Polyglot
+     *
+     * \brief   The Polyglot opening book format. A book is a file of 16 byte big endian entries sorted by the key,
+     *          the key is a Zobrist hash with the 781 random numbers of the format, so books of other tools match.
+     */
+    class Polyglot
+    {
+    public:
+
+        /*! \brief   The size of an entry in the file */
+        static constexpr size_t entrySize = 16;
+
+        /*!
+         * \fn  static uint64_t Polyglot::key(Board& board);
+         *
+         * \brief   Calculates the Polyglot key of a position. An en passant capture only counts if a pawn of the
+         *          color on turn stands next to the pawn which made the double step.
+         *
+         * \param [in,out]  board   The board.
+         *
+         * \returns The key.
+         */
+        static uint64_t key(Board& board);
+
+        /*!
+         * \fn  static uint16_t Polyglot::encode(const Position& origin, const Position& destination, FigureType type, FigureType promotedTo);
+         *
+         * \brief   Encodes a move, castling is written as the king capturing its own rook
+         *
+         * \param   origin      The origin.
+         * \param   destination The destination.
+         * \param   type        The type of the moved figure.
+         * \param   promotedTo  The type a pawn is promoted to, none if it is no promotion.
+         *
+         * \returns The encoded move.
+         */
+        static uint16_t encode(const Position& origin, const Position& destination, FigureType type, FigureType promotedTo);
+
+        /*!
+         * \fn  static Movement Polyglot::decode(Board& board, uint16_t move);
+         *
+         * \brief   Decodes a move for a position and checks that it is possible
+         *
+         * \param [in,out]  board   The board.
+         * \param           move    The encoded move.
+         *
+         * \returns The movement with the type of a promotion set, invalid if it is not possible on the board.
+         */
+        static Movement decode(Board& board, uint16_t move);
+
+        /*!
+         * \fn  static PolyglotEntry Polyglot::read(const unsigned char* data);
+         *
+         * \brief   Reads an entry
+         *
+         * \param   data    The entrySize bytes of the entry.
+         *
+         * \returns The entry.
+         */
+        static PolyglotEntry read(const unsigned char* data);
+
+        /*!
+         * \fn  static void Polyglot::write(const PolyglotEntry& entry, unsigned char* data);
+         *
+         * \brief   Writes an entry
+         *
+         * \param           entry   The entry.
+         * \param [out]     data    The entrySize bytes to write to.
+         */
+        static void write(const PolyglotEntry& entry, unsigned char* data);
+    };
+}
@@ -0,0 +1,497 @@
+/*!
+* \brief:  Implements the search class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "Search.h"
+#include "MovePicker.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace ChessNS
+{
+    static const int goodCapture   = 1 << 20;
+    static const int losingCapture = 1 << 21;
+    static const int mateBound     = Search::mateScore - 1000;
+
+    // mate scores are stored as distance to the mate from the stored position, not from the root
+    static int toTable(int score, int ply)
+    {
+        return score > mateBound ? score + ply : score < -mateBound ? score - ply : score;
+    }
+
+    static int fromTable(int score, int ply)
+    {
+        return score > mateBound ? score - ply : score < -mateBound ? score + ply : score;
+    }
+
+    static int tablebaseScore(const TablebaseResult& result, int ply)
+    {
+        if (result.wdl == Wdl::draw)
+            return 0;
+
+        const auto score = Search::mateScore - ply - static_cast<int>(result.plies);
+        return result.wdl == Wdl::win ? score : -score;
+    }
+
+    Search::Search(const SearchConfig& config)
+        : _config(config),
+          _table(config.hashSize),
+          _pawnTable(config.pawnHashSize) { }
+
+    SearchResult Search::run(Board& board)
+    {
+        SearchResult result;
+        _nodes   = 0;
+        _limited = false;
+        _history.clear();
+
+        if (_table.megabytes() != _config.hashSize)
+            _table.resize(_config.hashSize);
+
+        auto moves = board.getAllPossibleMoves(board.getCurrentColorTurn());
+        if (_config.tablebase && runTablebase(board, moves, result))
+            return result;
+
+        const auto lineCount = std::max<size_t>(1, std::min<size_t>(_config.multiPv, moves.size()));
+        for (unsigned depth = 1; depth <= _config.depth; depth++)
+        {
+            auto scores = scoreMoves(board, moves);
+
+            // the lines of the previous iteration first, in their order
+            for (size_t i = 0; i < moves.size(); i++)
+                for (size_t line = 0; line < result.lines.size(); line++)
+                    if (MoveHistory::pack(moves[i]) == MoveHistory::pack(result.lines[line].moves.front()))
+                        scores[i] = INT_MAX - static_cast<int>(line);
+
+            // a move has to beat the worst of the best lines, so the other moves are cut off as with a single line
+            std::vector<std::pair<int, size_t>> best;
+            for (size_t i = 0; i < moves.size(); i++)
+            {
+                const auto index    = pickNext(scores);
+                auto&      movement = moves[index];
+                const auto move     = MoveHistory::pack(movement);
+                const auto alpha    = best.size() < lineCount ? -mateScore - 1 : best.back().first;
+
+                board.makeMove(movement.origin(), movement.destination(), FigureType::queen);
+                const auto score = -alphaBeta(board, static_cast<int>(depth) - 1, -mateScore - 1, -alpha, 1, true, move);
+                board.unmakeMove();
+
+                if (stopped())
+                    break;
+
+                if (score > alpha || best.size() < lineCount)
+                {
+                    if (best.size() == lineCount)
+                        best.pop_back();
+                    best.emplace(std::upper_bound(best.begin(), best.end(), std::make_pair(score, index),
+                        [](const std::pair<int, size_t>& a, const std::pair<int, size_t>& b) { return a.first > b.first; }),
+                        score, index);
+                }
+            }
+
+            // an interrupted iteration is incomplete, the previous one stays the result
+            if (best.empty() || stopped())
+                break;
+
+            _table.store(board.getHash(), MoveHistory::pack(moves[best.front().second]), best.front().first,
+                static_cast<int>(depth), Bound::exact);
+
+            result.lines.clear();
+            for (auto& line : best)
+                result.lines.push_back({principalVariation(board, moves[line.second], depth), line.first, depth});
+
+            result.bestMove = moves[best.front().second];
+            result.score    = best.front().first;
+            result.depth    = depth;
+            result.nodes    = _nodes;
+
+            if (_config.progress)
+                _config.progress(result);
+
+            // the node limit only cuts later iterations, so there is always a move
+            _limited = _config.nodes != 0;
+        }
+
+        if (result.bestMove.hasFlag(EventFlag::promotion))
+            result.bestMove.promotedTo() = FigureType::queen;
+
+        result.nodes = _nodes;
+        return result;
+    }
+
+    bool Search::runTablebase(Board& board, std::vector<Movement>& moves, SearchResult& result)
+    {
+        TablebaseResult root;
+        if (moves.empty() || !_config.tablebase->probe(board, root))
+            return false;
+
+        // the fastest win, the slowest loss or any draw
+        auto best = -mateScore - 1;
+        for (auto& movement : moves)
+        {
+            TablebaseResult next;
+            board.makeMove(movement.origin(), movement.destination(), FigureType::queen);
+            const auto found = _config.tablebase->probe(board, next);
+            board.unmakeMove();
+            if (!found)
+                return false;
+
+            const auto score = -tablebaseScore(next, 1);
+            if (score > best)
+            {
+                best            = score;
+                result.bestMove = movement;
+            }
+        }
+
+        if (result.bestMove.hasFlag(EventFlag::promotion))
+            result.bestMove.promotedTo() = FigureType::queen;
+
+        result.score = best;
+        result.nodes = moves.size();
+        result.lines.push_back({{result.bestMove}, best, 0});
+        return true;
+    }
+
+    std::vector<Movement> Search::principalVariation(Board& board, Movement first, unsigned depth)
+    {
+        std::vector<Movement> line{first};
+        board.makeMove(first.origin(), first.destination(), FigureType::queen);
+
+        // follow the best moves of the transposition table as long as they are legal
+        TranspositionEntry entry;
+        while (line.size() < depth && _table.probe(board.getHash(), entry) && entry.move != 0)
+        {
+            auto moves = board.getAllPossibleMoves(board.getCurrentColorTurn());
+            auto next  = std::find_if(moves.begin(), moves.end(), [&entry](Movement& movement) { return MoveHistory::pack(movement) == entry.move; });
+            if (next == moves.end())
+                break;
+
+            line.push_back(*next);
+            board.makeMove(next->origin(), next->destination(), FigureType::queen);
+        }
+
+        for (size_t i = 0; i < line.size(); i++)
+        {
+            board.unmakeMove();
+            if (line[i].hasFlag(EventFlag::promotion))
+                line[i].promotedTo() = FigureType::queen;
+        }
+
+        return line;
+    }
+
+    SearchConfig& Search::config()
+    {
+        return _config;
+    }
+
+    void Search::clear()
+    {
+        _table.clear();
+    }
+
+    void Search::setStopped(bool stopped)
+    {
+        _stopped.store(stopped);
+    }
+
+    bool Search::stopped() const
+    {
+        return _stopped.load(std::memory_order_relaxed) || (_limited && _nodes >= _config.nodes);
+    }
+
+    int Search::evaluate(Board& board)
+    {
+        if (_config.network)
+        {
+            if (board.getNetwork() != _config.network)
+                board.setNetwork(_config.network);
+            return board.evaluateNetwork();
+        }
+
+        const auto score = board.evaluate();
+        if (!_config.pawnStructure)
+            return score;
+
+        const auto& entry     = _pawnTable.probe(board);
+        const auto& params    = board.getEvalParams();
+        const auto  shield    = PawnHashTable::shieldPawns(board);
+        const auto  fullPhase = params.fullPhase();
+        const auto  phase     = board.getPhase();
+
+        const auto middlegame = entry.score[0] + shield * params.shield[0];
+        const auto endgame    = entry.score[1] + shield * params.shield[1];
+        const auto pawns      = fullPhase == 0 ? endgame : (middlegame * phase + endgame * (fullPhase - phase)) / fullPhase;
+
+        return board.getCurrentColorTurn() == Color::white ? score + pawns : score - pawns;
+    }
+
+    int Search::alphaBeta(Board& board, int depth, int alpha, int beta, int ply, bool nullAllowed, PackedMove previous)
+    {
+        if (stopped())
+            return alpha;
+
+        if (depth <= 0)
+        {
+            if (_config.quiescence)
+                return quiescence(board, alpha, beta, ply);
+
+            ++_nodes;
+            return evaluate(board);
+        }
+
+        ++_nodes;
+        const auto key    = board.getHash();
+        PackedMove ttMove = 0;
+
+        TablebaseResult tablebase;
+        if (_config.tablebase && _config.tablebase->probe(board, tablebase))
+            return std::max(alpha, std::min(tablebaseScore(tablebase, ply), beta));
+
+        TranspositionEntry entry;
+        if (_table.probe(key, entry))
+        {
+            ttMove = entry.move;
+            if (entry.depth >= depth)
+            {
+                const auto score = fromTable(entry.score, ply);
+                if (entry.bound == Bound::exact || (entry.bound == Bound::lower && score >= beta)
+                    || (entry.bound == Bound::upper && score <= alpha))
+                    return std::max(alpha, std::min(score, beta));
+            }
+        }
+
+        const auto color   = board.getCurrentColorTurn();
+        const auto inCheck = board.isCheck(color);
+        const auto eval    = evaluate(board);
+
+        if (!inCheck && std::abs(beta) < mateBound)
+        {
+            // so far below alpha that only a capture can help
+            if (_config.razoring && _config.quiescence && depth <= static_cast<int>(_config.razorDepth)
+                && eval + _config.razorMargin * depth <= alpha)
+            {
+                if (quiescence(board, alpha, beta, ply) <= alpha)
+                    return alpha;
+            }
+
+            // a zugzwang, where passing would be better than any move, is unlikely while figures are left
+            const auto figures = board.getFigures(color, FigureType::queen) | board.getFigures(color, FigureType::rook)
+                | board.getFigures(color, FigureType::bishop) | board.getFigures(color, FigureType::knight);
+
+            if (_config.nullMove && nullAllowed && figures != 0 && eval >= beta
+                && depth > static_cast<int>(_config.nullMoveReduction))
+            {
+                const auto reduced = depth - 1 - static_cast<int>(_config.nullMoveReduction);
+
+                board.makeNullMove();
+                auto score = -alphaBeta(board, reduced, -beta, -beta + 1, ply + 1, false, 0);
+                board.unmakeMove();
+
+                if (score >= beta && depth >= static_cast<int>(_config.nullMoveVerifyDepth))
+                    score = alphaBeta(board, reduced, beta - 1, beta, ply, false, previous);
+
+                if (score >= beta)
+                    return beta;
+            }
+        }
+
+        const auto futile = _config.futilityPruning && !inCheck && depth <= static_cast<int>(_config.futilityDepth)
+            && eval + _config.futilityMargin * depth <= alpha;
+
+        MovePicker picker(board, _history, ttMove, ply, previous);
+        Movement   movement;
+        PackedMove bestMove = 0;
+        PackedMove quiets[64];
+        size_t     nbrOfQuiets = 0;
+        size_t     count       = 0;
+
+        while (picker.next(movement))
+        {
+            const auto index = count++;
+            const auto move  = MoveHistory::pack(movement);
+            const auto quiet = !movement.hasFlag(EventFlag::capture) && !movement.hasFlag(EventFlag::promotion);
+            const auto calm  = quiet && !movement.hasFlag(EventFlag::check);
+
+            if (futile && calm)
+                continue;
+
+            const auto reduce = calm && !inCheck ? reduction(depth, index, _history.history(color, move)) : 0;
+
+            board.makeMove(movement.origin(), movement.destination(), FigureType::queen);
+            auto score = -alphaBeta(board, depth - 1 - reduce, reduce > 0 ? -alpha - 1 : -beta, -alpha, ply + 1, true, move);
+            if (reduce > 0 && score > alpha)
+                score = -alphaBeta(board, depth - 1, -beta, -alpha, ply + 1, true, move);
+            board.unmakeMove();
+
+            // the scores of a stopped search are meaningless and must not reach the table
+            if (stopped())
+                return alpha;
+
+            if (score >= beta)
+            {
+                // reward the refutation and punish the quiet moves which were tried before
+                if (quiet)
+                {
+                    _history.addKiller(ply, move);
+                    _history.updateHistory(color, move, depth * depth);
+                    for (size_t i = 0; i < nbrOfQuiets; i++)
+                        _history.updateHistory(color, quiets[i], -depth * depth);
+
+                    if (previous != 0)
+                        _history.setCounterMove(previous, move);
+                }
+
+                _table.store(key, move, toTable(beta, ply), depth, Bound::lower);
+                return beta;
+            }
+
+            if (quiet && nbrOfQuiets < 64)
+                quiets[nbrOfQuiets++] = move;
+
+            if (score > alpha)
+            {
+                alpha    = score;
+                bestMove = move;
+            }
+        }
+
+        if (count == 0)
+            return inCheck ? -mateScore + ply : 0;
+
+        _table.store(key, bestMove, toTable(alpha, ply), depth, bestMove != 0 ? Bound::exact : Bound::upper);
+        return alpha;
+    }
+
+    int Search::quiescence(Board& board, int alpha, int beta, int ply)
+    {
+        if (stopped())
+            return alpha;
+
+        ++_nodes;
+        const auto standPat = evaluate(board);
+        if (standPat >= beta)
+            return beta;
+
+        if (standPat > alpha)
+            alpha = standPat;
+
+        auto captures = board.getAllPossibleCaptures(board.getCurrentColorTurn());
+        auto scores   = scoreMoves(board, captures);
+
+        for (size_t i = 0; i < captures.size(); i++)
+        {
+            auto& movement = captures[pickNext(scores)];
+
+            // even winning the captured figure for free can not raise alpha
+            if (_config.deltaPruning && !movement.hasFlag(EventFlag::promotion))
+            {
+                const auto gain = ChessTypes::getFigureValue(capturedType(board, movement));
+                if (standPat + gain + _config.deltaMargin <= alpha)
+                    continue;
+            }
+
+            if (_config.seePruning && !movement.hasFlag(EventFlag::promotion) && board.see(movement) < 0)
+                continue;
+
+            board.makeMove(movement.origin(), movement.destination(), FigureType::queen);
+            const auto score = -quiescence(board, -beta, -alpha, ply + 1);
+            board.unmakeMove();
+
+            if (score >= beta)
+                return beta;
+
+            if (score > alpha)
+                alpha = score;
+        }
+
+        return alpha;
+    }
+
+    int Search::reduction(int depth, size_t moveIndex, int history) const
+    {
+        if (!_config.lateMoveReductions || depth < static_cast<int>(_config.lmrDepth) || moveIndex < _config.lmrMoveCount)
+            return 0;
+
+        auto result = static_cast<int>(_config.lmrReduction);
+        if (moveIndex >= 3 * _config.lmrMoveCount || history < -MoveHistory::historyMax / 2)
+            ++result;
+
+        if (history > MoveHistory::historyMax / 2)
+            --result;
+
+        // at least one full ply is left for the reduced search
+        return std::max(0, std::min(result, depth - 2));
+    }
+
+    std::vector<int> Search::scoreMoves(Board& board, std::vector<Movement>& moves)
+    {
+        std::vector<int> scores(moves.size());
+        for (size_t i = 0; i < moves.size(); i++)
+        {
+            auto& movement = moves[i];
+            if (movement.hasFlag(EventFlag::capture))
+            {
+                // most valuable victim first, least valuable attacker breaks ties, losing captures after the quiet moves
+                scores[i] = 10 * ChessTypes::getFigureValue(capturedType(board, movement))
+                    - ChessTypes::getFigureValue(movement.figureType()) / 100;
+
+                scores[i] += board.see(movement) < 0 ? -losingCapture : goodCapture;
+            }
+
+            if (movement.hasFlag(EventFlag::promotion))
+            {
+                scores[i] += 10 * (ChessTypes::getFigureValue(FigureType::queen) - ChessTypes::getFigureValue(FigureType::pawn));
+                if (!movement.hasFlag(EventFlag::capture))
+                    scores[i] += goodCapture;
+            }
+        }
+
+        return scores;
+    }
+
+    size_t Search::pickNext(std::vector<int>& scores)
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < scores.size(); i++)
+            if (scores[i] > scores[best])
+                best = i;
+
+        scores[best] = INT_MIN;
+        return best;
+    }
+
+    FigureType Search::capturedType(Board& board, Movement& movement)
+    {
+        if (!movement.hasFlag(EventFlag::capture))
+            return FigureType::none;
+
+        // an empty destination means en passant
+        const auto& field = board.at(movement.destination());
+        return field.empty ? FigureType::pawn : field.figure.getType();
+    }
+}
@@ -0,0 +1,238 @@
+/*!
+* \brief:  Declares the search class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "ChessEngine/Board.h"
+#include "MoveHistory.h"
+#include "PawnHashTable.h"
+#include "Tablebase.h"
+#include "TranspositionTable.h"
+
+namespace ChessNS
+{
+    struct SearchResult;
+
+    /*!
+     * \struct  SearchConfig
+     *
+     * \brief   The configuration of a search.
+     */
+    struct SearchConfig
+    {
+        /*! \brief   The depth of the full width search in plies, it is reached by iterative deepening */
+        unsigned depth{3};
+        /*! \brief   Stop after this number of nodes and return the last finished iteration, 0 for no limit */
+        uint64_t nodes{0};
+        /*! \brief   The number of best root moves which get an exact score and a principal variation */
+        unsigned multiPv{1};
+        /*! \brief   Called after every iteration of the iterative deepening with the lines found so far */
+        std::function<void(const SearchResult&)> progress{};
+        /*! \brief   The size of the transposition table in megabytes */
+        size_t hashSize{16};
+        /*! \brief   Evaluate with this neural network instead of the tables and the pawn structure, if it is set */
+        std::shared_ptr<const Nnue> network{};
+        /*! \brief   The endgame tables, positions in them are scored without a search and played perfectly */
+        std::shared_ptr<Tablebase> tablebase{};
+        /*! \brief   Add the pawn structure to the evaluation */
+        bool pawnStructure{true};
+        /*! \brief   The size of the pawn hash table in megabytes */
+        size_t pawnHashSize{1};
+        /*! \brief   Continue with captures and promotions at the leaves until the position is quiet */
+        bool quiescence{true};
+        /*! \brief   Skip captures in the quiescence search which can not raise alpha */
+        bool deltaPruning{true};
+        /*! \brief   The safety margin of the delta pruning in centipawns */
+        int deltaMargin{200};
+        /*! \brief   Skip captures in the quiescence search which lose material by the static exchange evaluation */
+        bool seePruning{true};
+        /*! \brief   Pass the turn and cut off if a reduced search still fails high */
+        bool nullMove{true};
+        /*! \brief   The depth reduction of the null move search in plies */
+        unsigned nullMoveReduction{2};
+        /*! \brief   From this depth on a null move cutoff is verified by a reduced search without passing */
+        unsigned nullMoveVerifyDepth{6};
+        /*! \brief   Search late quiet moves with a reduced depth first */
+        bool lateMoveReductions{true};
+        /*! \brief   The minimum depth for late move reductions */
+        unsigned lmrDepth{3};
+        /*! \brief   The number of moves searched with full depth before reducing */
+        unsigned lmrMoveCount{3};
+        /*! \brief   The reduction in plies, one more for very late moves and one less for moves with a good history */
+        unsigned lmrReduction{1};
+        /*! \brief   Skip quiet moves near the leaves if the static evaluation is far below alpha */
+        bool futilityPruning{true};
+        /*! \brief   The maximum remaining depth for futility pruning */
+        unsigned futilityDepth{2};
+        /*! \brief   The futility margin per remaining ply in centipawns */
+        int futilityMargin{150};
+        /*! \brief   Drop into the quiescence search near the leaves if the static evaluation is far below alpha */
+        bool razoring{true};
+        /*! \brief   The maximum remaining depth for razoring */
+        unsigned razorDepth{2};
+        /*! \brief   The razoring margin per remaining ply in centipawns */
+        int razorMargin{300};
+    };
+
+    /*!
+     * \struct  PrincipalVariation
+     *
+     * \brief   A root move with its score and the expected continuation.
+     */
+    struct PrincipalVariation
+    {
+        /*! \brief   The root move followed by the best moves of both colors as far as the transposition table knows them */
+        std::vector<Movement> moves{};
+        /*! \brief   The score in centipawns from the view of the color on turn */
+        int score{};
+        /*! \brief   The depth which was searched */
+        unsigned depth{};
+    };
+
+    /*!
+     * \struct  SearchResult
+     *
+     * \brief   The result of a search.
+     */
+    struct SearchResult
+    {
+        /*! \brief   The best move found, invalid if there is no legal move */
+        Movement bestMove{};
+        /*! \brief   The score of the best move in centipawns from the view of the color on turn */
+        int score{};
+        /*! \brief   The depth which was searched */
+        unsigned depth{};
+        /*! \brief   The number of visited nodes */
+        uint64_t nodes{};
+        /*! \brief   The best lines, the best first, at most multiPv of them */
+        std::vector<PrincipalVariation> lines{};
+    };
+
+    /*!
+     * \class   Search
+     *
+     * \brief   An alpha beta search with a quiescence search at the leaves. The transposition table and the move
+     *          history belong to the instance, so every search thread needs its own.
+     */
+    class Search
+    {
+    public:
+
+        /*! \brief   The score of a checkmate, reduced by the distance to the mate */
+        static constexpr int mateScore = 30000;
+
+        /*!
+         * \fn  explicit Search::Search(const SearchConfig& config = SearchConfig());
+         *
+         * \brief   Constructor
+         *
+         * \param   config  (Optional) The configuration.
+         */
+        explicit Search(const SearchConfig& config = SearchConfig());
+
+        /*!
+         * \fn  SearchResult Search::run(Board& board);
+         *
+         * \brief   Searches the best move for the color on turn
+         *
+         * \param [in,out]  board   The board, it is the same again when the search returns.
+         *
+         * \returns The SearchResult.
+         */
+        SearchResult run(Board& board);
+
+        /*!
+         * \fn  SearchConfig& Search::config();
+         *
+         * \brief   Gets the configuration
+         *
+         * \returns A reference to the SearchConfig.
+         */
+        SearchConfig& config();
+
+        /*!
+         * \fn  void Search::clear();
+         *
+         * \brief   Clears the transposition table, e.g. for a new game
+         */
+        void clear();
+
+        /*!
+         * \fn  void Search::setStopped(bool stopped);
+         *
+         * \brief   Stops a running search from another thread, it returns the result of the last finished iteration.
+         *          The flag stays set until it is cleared, so a search started later returns at once as well.
+         *
+         * \param   stopped True to stop, false to allow searching again.
+         */
+        void setStopped(bool stopped);
+
+        /*!
+         * \fn  int Search::evaluate(Board& board);
+         *
+         * \brief   Evaluates the position with the neural network of the configuration or otherwise with the
+         *          tapered material and piece square tables kept by the board and the pawn structure from the pawn
+         *          hash table
+         *
+         * \param [in,out]  board   The board.
+         *
+         * \returns The score in centipawns from the view of the color on turn.
+         */
+        int evaluate(Board& board);
+
+    private:
+
+        bool runTablebase(Board& board, std::vector<Movement>& moves, SearchResult& result);
+
+        std::vector<Movement> principalVariation(Board& board, Movement first, unsigned depth);
+
+        bool stopped() const;
+
+        int alphaBeta(Board& board, int depth, int alpha, int beta, int ply, bool nullAllowed, PackedMove previous);
+
+        int quiescence(Board& board, int alpha, int beta, int ply);
+
+        int reduction(int depth, size_t moveIndex, int history) const;
+
+        static std::vector<int> scoreMoves(Board& board, std::vector<Movement>& moves);
+
+        static size_t pickNext(std::vector<int>& scores);
+
+        static FigureType capturedType(Board& board, Movement& movement);
+
+        SearchConfig       _config;
+        uint64_t           _nodes{};
+        MoveHistory        _history;
+        TranspositionTable _table;
+        PawnHashTable      _pawnTable;
+        std::atomic<bool>  _stopped{false};
+        bool               _limited{false};
+    };
+}
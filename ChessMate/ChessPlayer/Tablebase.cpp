@@ -0,0 +1,846 @@
+/*!
+* \brief:  Implements the endgame tablebase class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "Tablebase.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <set>
+#include <thread>
+#include <vector>
+#include "BasicUtils/MappedFile.h"
+
+namespace ChessNS
+{
+    // A value is 0 for a draw or a position not known yet, 255 for an impossible position and otherwise the plies
+    // to the mate plus one. An odd number of plies wins for the color on turn, an even number loses.
+    static const uint8_t unknown    = 0;
+    static const uint8_t impossible = 255;
+
+    static const char       magic[4]       = {'C', 'M', 'T', 'B'};
+    static const uint32_t   version        = 1;
+    static const char       letters[7]     = "KQRBNP";
+    static const FigureType figureOrder[6] = {FigureType::king, FigureType::queen, FigureType::rook,
+                                              FigureType::bishop, FigureType::knight, FigureType::pawn};
+
+    struct Tablebase::Table
+    {
+        std::string          material;
+        Color                colors[maxFigures]{};
+        FigureType           types[maxFigures]{};
+        int                  count{};
+        bool                 pawns{};
+        size_t               size{};
+        std::vector<uint8_t> data;
+        MappedFile           file;
+        const uint8_t*       values[2]{};
+    };
+
+    struct Placement
+    {
+        int        count{};
+        Color      colors[Tablebase::maxFigures]{};
+        FigureType types[Tablebase::maxFigures]{};
+        int        squares[Tablebase::maxFigures]{};
+        Color      turn{Color::white};
+        // the square a pawn passed with a double step if the color on turn may capture it there, -1 if not
+        int enPassant{-1};
+    };
+
+    // The squares the white king is reduced to, a1-d1-d4 without pawns and the queen side with pawns
+    struct KingSquares
+    {
+        KingSquares()
+        {
+            for (int square = 0; square < 64; square++)
+                for (int pawns = 0; pawns < 2; pawns++)
+                {
+                    index[pawns][square] = -1;
+                    if (canonical(square, pawns != 0))
+                    {
+                        index[pawns][square]         = count[pawns];
+                        squares[pawns][count[pawns]] = square;
+                        count[pawns]++;
+                    }
+                }
+        }
+
+        static bool canonical(int square, bool pawns)
+        {
+            const auto column = square % 8;
+            const auto row    = square / 8;
+            return pawns ? column < 4 : column < 4 && row < 4 && row <= column;
+        }
+
+        int index[2][64]{};
+        int squares[2][32]{};
+        int count[2]{};
+    };
+
+    static const KingSquares kingSquares;
+
+    static int transform(int square, int symmetry)
+    {
+        auto column = square % 8;
+        auto row    = square / 8;
+        if (symmetry & 1)
+            column = 7 - column;
+        if (symmetry & 2)
+            row = 7 - row;
+        if (symmetry & 4)
+            std::swap(column, row);
+        return row * 8 + column;
+    }
+
+    static size_t letterIndex(char letter)
+    {
+        return static_cast<size_t>(std::find(letters, letters + 6, letter) - letters);
+    }
+
+    static std::string material(const Placement& placement)
+    {
+        std::string sides[2];
+        for (int i = 0; i < placement.count; i++)
+            sides[placement.colors[i] == Color::white ? 0 : 1] += letters[std::find(figureOrder, figureOrder + 6, placement.types[i]) - figureOrder];
+
+        for (auto& side : sides)
+            std::sort(side.begin(), side.end(), [](char lhs, char rhs) { return letterIndex(lhs) < letterIndex(rhs); });
+        return sides[0] + sides[1];
+    }
+
+    static std::string flipped(const std::string& material)
+    {
+        const auto black = material.find('K', 1);
+        return material.substr(black) + material.substr(0, black);
+    }
+
+    static bool parse(const std::string& material, Tablebase::Table& table)
+    {
+        const auto black = material.find('K', 1);
+        if (material.empty() || material[0] != 'K' || black == std::string::npos || material.find('K', black + 1) != std::string::npos
+            || material.size() > static_cast<size_t>(Tablebase::maxFigures))
+            return false;
+
+        Placement placement;
+        for (size_t i = 0; i < material.size(); i++)
+        {
+            const auto letter = letterIndex(material[i]);
+            if (letter >= 6)
+                return false;
+
+            placement.colors[i] = i < black ? Color::white : Color::black;
+            placement.types[i]  = figureOrder[letter];
+            placement.count++;
+        }
+
+        // the order of the slots is the sorted material
+        table.material = ChessNS::material(placement);
+        table.count    = placement.count;
+        table.pawns    = table.material.find('P') != std::string::npos;
+        table.size     = static_cast<size_t>(kingSquares.count[table.pawns ? 1 : 0]);
+        for (int i = 0; i < table.count; i++)
+        {
+            const auto blackKing = static_cast<int>(table.material.find('K', 1));
+            table.colors[i]      = i < blackKing ? Color::white : Color::black;
+            table.types[i]       = figureOrder[letterIndex(table.material[static_cast<size_t>(i)])];
+            if (i > 0)
+                table.size *= 64;
+        }
+
+        return true;
+    }
+
+    // Gets the squares of the figures in the order of the slots, black becomes white if the table is the other way round
+    static void slotSquares(const Tablebase::Table& table, const Placement& placement, bool flip, int* squares)
+    {
+        bool used[Tablebase::maxFigures]{};
+        for (int slot = 0; slot < table.count; slot++)
+            for (int i = 0; i < placement.count; i++)
+            {
+                const auto color = flip ? ChessTypes::getOpponent(placement.colors[i]) : placement.colors[i];
+                if (!used[i] && color == table.colors[slot] && placement.types[i] == table.types[slot])
+                {
+                    squares[slot] = flip ? placement.squares[i] ^ 56 : placement.squares[i];
+                    used[i]       = true;
+                    break;
+                }
+            }
+    }
+
+    static size_t index(const Tablebase::Table& table, const int* squares, int symmetry)
+    {
+        auto result = static_cast<size_t>(kingSquares.index[table.pawns ? 1 : 0][transform(squares[0], symmetry)]);
+        for (int slot = 1; slot < table.count; slot++)
+            result = result * 64 + static_cast<size_t>(transform(squares[slot], symmetry));
+        return result;
+    }
+
+    static size_t index(const Tablebase::Table& table, const Placement& placement, bool flip)
+    {
+        int squares[Tablebase::maxFigures];
+        slotSquares(table, placement, flip, squares);
+
+        int symmetry = 0;
+        while (!KingSquares::canonical(transform(squares[0], symmetry), table.pawns))
+            symmetry++;
+        return index(table, squares, symmetry);
+    }
+
+    // Calls the callback with every index of a position. A white king on the diagonal of a table without pawns leaves
+    // the other figures a choice of two halves, so such a position has two indices.
+    template <typename Callback>
+    static void forEachIndex(const Tablebase::Table& table, const Placement& placement, Callback&& callback)
+    {
+        int squares[Tablebase::maxFigures];
+        slotSquares(table, placement, false, squares);
+
+        size_t found[8];
+        int    count = 0;
+        for (int symmetry = 0; symmetry < (table.pawns ? 2 : 8); symmetry++)
+            if (KingSquares::canonical(transform(squares[0], symmetry), table.pawns))
+            {
+                const auto result = index(table, squares, symmetry);
+                if (std::find(found, found + count, result) == found + count)
+                {
+                    found[count++] = result;
+                    callback(result);
+                }
+            }
+    }
+
+    static uint8_t value(const Tablebase::Table& table, const Placement& placement, bool flip)
+    {
+        const auto white = (placement.turn == Color::white) != flip;
+        return table.values[white ? 0 : 1][index(table, placement, flip)];
+    }
+
+    static void decode(const Tablebase::Table& table, size_t index, Color turn, Placement& placement)
+    {
+        placement.count = table.count;
+        placement.turn  = turn;
+        for (int slot = table.count - 1; slot >= 0; slot--)
+        {
+            placement.colors[slot]  = table.colors[slot];
+            placement.types[slot]   = table.types[slot];
+            placement.squares[slot] = slot > 0 ? static_cast<int>(index % 64) : kingSquares.squares[table.pawns ? 1 : 0][index];
+            index /= 64;
+        }
+    }
+
+    static Bitboard occupied(const Placement& placement)
+    {
+        Bitboard result = 0;
+        for (int i = 0; i < placement.count; i++)
+            result |= BitboardHelper::bit(placement.squares[i]);
+        return result;
+    }
+
+    static bool attacked(const Placement& placement, int square, Color byColor)
+    {
+        const auto all = occupied(placement);
+        for (int i = 0; i < placement.count; i++)
+            if (placement.colors[i] == byColor
+                && (AttackTables::attacks(placement.types[i], byColor, placement.squares[i], all) & BitboardHelper::bit(square)) != 0)
+                return true;
+        return false;
+    }
+
+    static bool inCheck(const Placement& placement, Color color)
+    {
+        for (int i = 0; i < placement.count; i++)
+            if (placement.colors[i] == color && placement.types[i] == FigureType::king)
+                return attacked(placement, placement.squares[i], ChessTypes::getOpponent(color));
+        return false;
+    }
+
+    static bool possible(const Placement& placement)
+    {
+        Bitboard squares = 0;
+        for (int i = 0; i < placement.count; i++)
+        {
+            const auto bit = BitboardHelper::bit(placement.squares[i]);
+            const auto row = placement.squares[i] / 8;
+            if ((squares & bit) != 0 || (placement.types[i] == FigureType::pawn && (row == 0 || row == 7)))
+                return false;
+            squares |= bit;
+        }
+
+        return !inCheck(placement, ChessTypes::getOpponent(placement.turn));
+    }
+
+    // Calls the callback with every position after a legal move of the color on turn until it returns true, which
+    // is returned then
+    template <typename Callback>
+    static bool successors(const Placement& placement, Callback&& callback)
+    {
+        const auto turn     = placement.turn;
+        const auto all      = occupied(placement);
+        Bitboard   opponent = 0;
+        for (int i = 0; i < placement.count; i++)
+            if (placement.colors[i] != turn)
+                opponent |= BitboardHelper::bit(placement.squares[i]);
+
+        for (int i = 0; i < placement.count; i++)
+        {
+            if (placement.colors[i] != turn)
+                continue;
+
+            const auto square = placement.squares[i];
+            Bitboard   targets;
+            if (placement.types[i] == FigureType::pawn)
+            {
+                const auto step = turn == Color::white ? 8 : -8;
+                const auto row  = square / 8;
+                targets         = AttackTables::pawnAttacks(turn, square) & opponent;
+                if ((all & BitboardHelper::bit(square + step)) == 0)
+                {
+                    targets |= BitboardHelper::bit(square + step);
+                    if (row == (turn == Color::white ? 1 : 6) && (all & BitboardHelper::bit(square + 2 * step)) == 0)
+                        targets |= BitboardHelper::bit(square + 2 * step);
+                }
+            }
+            else
+                targets = AttackTables::attacks(placement.types[i], turn, square, all) & (~all | opponent);
+
+            while (targets != 0)
+            {
+                const auto target = BitboardHelper::popLsb(targets);
+                Placement  next;
+                next.turn = ChessTypes::getOpponent(turn);
+
+                for (int j = 0; j < placement.count; j++)
+                {
+                    if (placement.squares[j] == target)
+                        continue;
+
+                    next.colors[next.count]  = placement.colors[j];
+                    next.types[next.count]   = placement.types[j];
+                    next.squares[next.count] = j == i ? target : placement.squares[j];
+                    next.count++;
+                }
+
+                if (inCheck(next, turn))
+                    continue;
+
+                const auto row = target / 8;
+                if (placement.types[i] == FigureType::pawn && std::abs(target - square) == 16)
+                {
+                    // a pawn of the other color next to the target may take it en passant
+                    for (int j = 0; j < next.count; j++)
+                        if (next.colors[j] == next.turn && next.types[j] == FigureType::pawn && next.squares[j] / 8 == row
+                            && std::abs(next.squares[j] % 8 - target % 8) == 1)
+                            next.enPassant = (square + target) / 2;
+                }
+
+                if (placement.types[i] != FigureType::pawn || (row != 0 && row != 7))
+                {
+                    if (callback(next))
+                        return true;
+                    continue;
+                }
+
+                const auto moved = static_cast<int>(std::find(next.squares, next.squares + next.count, target) - next.squares);
+                for (auto type : {FigureType::queen, FigureType::rook, FigureType::bishop, FigureType::knight})
+                {
+                    next.types[moved] = type;
+                    if (callback(next))
+                        return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // Calls the callback with every position before a move of the color not on turn which did not capture or promote
+    template <typename Callback>
+    static void predecessors(const Placement& placement, Callback&& callback)
+    {
+        const auto mover = ChessTypes::getOpponent(placement.turn);
+        const auto all   = occupied(placement);
+        for (int i = 0; i < placement.count; i++)
+        {
+            if (placement.colors[i] != mover)
+                continue;
+
+            const auto square = placement.squares[i];
+            Bitboard   origins;
+            if (placement.types[i] == FigureType::pawn)
+            {
+                // a pawn came one row back or with a double step from its first row
+                const auto step = mover == Color::white ? 8 : -8;
+                const auto back = square - step;
+                origins         = 0;
+                if ((all & BitboardHelper::bit(back)) == 0 && back / 8 != (mover == Color::white ? 0 : 7))
+                {
+                    origins |= BitboardHelper::bit(back);
+                    if (square / 8 == (mover == Color::white ? 3 : 4) && (all & BitboardHelper::bit(back - step)) == 0)
+                        origins |= BitboardHelper::bit(back - step);
+                }
+            }
+            else
+                origins = AttackTables::attacks(placement.types[i], mover, square, all) & ~all;
+
+            while (origins != 0)
+            {
+                auto previous       = placement;
+                previous.turn       = mover;
+                previous.squares[i] = BitboardHelper::popLsb(origins);
+                previous.enPassant  = -1;
+                if (possible(previous))
+                    callback(previous);
+            }
+        }
+    }
+
+    // Calls the callback with every position after an en passant capture of the color on turn
+    template <typename Callback>
+    static void enPassantCaptures(const Placement& placement, Callback&& callback)
+    {
+        if (placement.enPassant < 0)
+            return;
+
+        const auto passed = placement.enPassant + (placement.turn == Color::white ? -8 : 8);
+        for (int i = 0; i < placement.count; i++)
+        {
+            if (placement.colors[i] != placement.turn || placement.types[i] != FigureType::pawn
+                || placement.squares[i] / 8 != passed / 8 || std::abs(placement.squares[i] % 8 - passed % 8) != 1)
+                continue;
+
+            Placement next;
+            next.turn = ChessTypes::getOpponent(placement.turn);
+            for (int j = 0; j < placement.count; j++)
+            {
+                if (placement.squares[j] == passed)
+                    continue;
+
+                next.colors[next.count]  = placement.colors[j];
+                next.types[next.count]   = placement.types[j];
+                next.squares[next.count] = j == i ? placement.enPassant : placement.squares[j];
+                next.count++;
+            }
+
+            if (!inCheck(next, placement.turn))
+                callback(next);
+        }
+    }
+
+    // Orders the values from the view of the color on turn, short wins first and long losses last
+    static int preference(uint8_t entry)
+    {
+        if (entry == unknown || entry == impossible)
+            return 0;
+
+        const auto length = entry - 1;
+        return length % 2 == 1 ? 1000 - length : length - 1000;
+    }
+
+    static void parallel(size_t size, unsigned threads, const std::function<void(size_t, size_t, unsigned)>& work)
+    {
+        std::vector<std::thread> workers;
+        const auto               chunk = (size + threads - 1) / threads;
+        for (unsigned thread = 0; thread < threads; thread++)
+        {
+            const auto begin = std::min(size, thread * chunk);
+            const auto end   = std::min(size, begin + chunk);
+            workers.emplace_back(work, begin, end, thread);
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    Tablebase::Tablebase(const std::string& directory)
+        : _directory(directory) { }
+
+    Tablebase::~Tablebase() = default;
+
+    bool Tablebase::generate(const std::string& material, unsigned threads)
+    {
+        auto result = std::unique_ptr<Table>(new Table());
+        if (!parse(material, *result))
+            return false;
+
+        auto& table = *result;
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // the materials one capture or promotion away, the other way round if only that table exists
+        std::set<std::string> smaller;
+        for (int captured = -1; captured < table.count; captured++)
+            for (int promoted = -1; promoted < table.count; promoted++)
+            {
+                if ((captured >= 0 && table.types[captured] == FigureType::king)
+                    || (promoted >= 0 && (table.types[promoted] != FigureType::pawn || promoted == captured))
+                    || (captured >= 0 && promoted >= 0 && table.colors[captured] == table.colors[promoted])
+                    || (captured < 0 && promoted < 0))
+                    continue;
+
+                for (auto type : {FigureType::queen, FigureType::rook, FigureType::bishop, FigureType::knight})
+                {
+                    Placement placement;
+                    for (int i = 0; i < table.count; i++)
+                        if (i != captured)
+                        {
+                            placement.colors[placement.count] = table.colors[i];
+                            placement.types[placement.count]  = i == promoted ? type : table.types[i];
+                            placement.count++;
+                        }
+                    smaller.insert(ChessNS::material(placement));
+                }
+            }
+
+        std::map<std::string, std::pair<const Table*, bool>> subtables;
+        for (const auto& sub : smaller)
+        {
+            auto  flip = false;
+            auto* next = this->table(sub);
+            if (next == nullptr)
+            {
+                next = this->table(flipped(sub));
+                flip = next != nullptr;
+            }
+
+            if (next == nullptr && (!generate(sub, threads) || (next = this->table(sub)) == nullptr))
+                return false;
+
+            subtables[sub] = {next, flip};
+        }
+
+        table.data.assign(2 * table.size, unknown);
+        uint8_t* values[2] = {table.data.data(), table.data.data() + table.size};
+        table.values[0]    = values[0];
+        table.values[1]    = values[1];
+
+        auto lookup = [&table, &subtables](const Placement& next)
+        {
+            // without a capture or promotion the figures are still in the order of the slots
+            if (next.count == table.count && std::equal(next.types, next.types + next.count, table.types))
+                return value(table, next, false);
+
+            const auto name = ChessNS::material(next);
+            if (name == table.material)
+                return value(table, next, false);
+
+            const auto& sub = subtables.at(name);
+            return value(*sub.first, next, sub.second);
+        };
+
+        // a position with an en passant capture is not stored, its value is the one of the same position without it
+        // or of the capture, whichever is better for the color on turn
+        auto successor = [&lookup](const Placement& next)
+        {
+            auto entry = lookup(next);
+            enPassantCaptures(next, [&](const Placement& captured)
+            {
+                const auto reply = lookup(captured);
+                if (reply == unknown || reply == impossible)
+                {
+                    if (preference(entry) < 0)
+                        entry = unknown;
+                }
+                else if (preference(static_cast<uint8_t>(reply + 1)) > preference(entry))
+                    entry = static_cast<uint8_t>(reply + 1);
+            });
+            return entry;
+        };
+
+        auto inTable = [&table](const Placement& next)
+        {
+            return (next.count == table.count && std::equal(next.types, next.types + next.count, table.types))
+                || ChessNS::material(next) == table.material;
+        };
+
+        // Decides whether a position wins or loses in a number of plies, a win needs a move to a loss one ply shorter
+        // and a loss only has moves to wins, the longest of them one ply shorter
+        auto decided = [&successor](const Placement& placement, unsigned plies)
+        {
+            const auto win      = plies % 2 == 1;
+            auto       resolved = false;
+            auto       moves    = 0;
+            unsigned   maximum  = 0;
+            const auto stopped  = successors(placement, [&](const Placement& next)
+            {
+                const auto entry  = successor(next);
+                const auto known  = entry != unknown && entry != impossible;
+                const auto length = known ? entry - 1u : 0u;
+                moves++;
+
+                if (win)
+                    return resolved = known && length % 2 == 0 && length == plies - 1;
+                if (!known || length % 2 == 0)
+                    return true;
+                maximum = std::max(maximum, length);
+                return false;
+            });
+
+            return win ? resolved : !stopped && moves > 0 && maximum == plies - 1;
+        };
+
+        // The mates, the impossible positions and the plies at which a move into a smaller table or an en passant
+        // capture can decide a position. The values of the smaller tables are final, so such a position is checked
+        // again at these plies. A position is addressed by its side and index, side * size + index.
+        std::vector<std::vector<uint32_t>>              found(threads);
+        std::vector<std::vector<std::vector<uint32_t>>> scheduled(threads, std::vector<std::vector<uint32_t>>(impossible));
+        parallel(table.size, threads, [&](size_t begin, size_t end, unsigned thread)
+        {
+            auto& schedule = scheduled[thread];
+            for (size_t side = 0; side < 2; side++)
+                for (auto i = begin; i < end; i++)
+                {
+                    Placement placement;
+                    decode(table, i, side == 0 ? Color::white : Color::black, placement);
+                    if (!possible(placement))
+                    {
+                        values[side][i] = impossible;
+                        continue;
+                    }
+
+                    const auto position = static_cast<uint32_t>(side * table.size + i);
+                    auto       moves    = 0;
+                    unsigned   shortest = impossible;
+                    unsigned   longest  = 0;
+                    successors(placement, [&](const Placement& next)
+                    {
+                        moves++;
+                        if (!inTable(next))
+                        {
+                            // the shortest win and the longest loss through the smaller tables
+                            const auto entry = lookup(next);
+                            if (entry != unknown && entry != impossible)
+                            {
+                                const auto length = entry - 1u;
+                                if (length % 2 == 0)
+                                    shortest = std::min(shortest, length + 1);
+                                else
+                                    longest = std::max(longest, length + 1);
+                            }
+                        }
+
+                        enPassantCaptures(next, [&](const Placement& captured)
+                        {
+                            const auto reply = lookup(captured);
+                            if (reply != unknown && reply + 1u < impossible - 1u)
+                                schedule[reply + 1u].push_back(position);
+                        });
+                        return false;
+                    });
+
+                    if (moves == 0 && inCheck(placement, placement.turn))
+                    {
+                        values[side][i] = 1;
+                        found[thread].push_back(position);
+                    }
+                    if (shortest < impossible - 1u)
+                        schedule[shortest].push_back(position);
+                    if (longest > 0 && longest < impossible - 1u)
+                        schedule[longest].push_back(position);
+                }
+        });
+
+        std::vector<std::vector<uint32_t>> pending(impossible);
+        unsigned                           last = 0;
+        for (auto& schedule : scheduled)
+            for (unsigned plies = 0; plies < impossible; plies++)
+            {
+                pending[plies].insert(pending[plies].end(), schedule[plies].begin(), schedule[plies].end());
+                if (!pending[plies].empty())
+                    last = std::max(last, plies);
+                std::vector<uint32_t>().swap(schedule[plies]);
+            }
+
+        // Retrograde analysis: a position can only be decided in n plies by a move to a position decided in n - 1,
+        // so the candidates are the predecessors of the positions decided one ply before and the scheduled ones
+        std::vector<uint32_t> resolved;
+        for (auto& positions : found)
+            resolved.insert(resolved.end(), positions.begin(), positions.end());
+
+        std::vector<std::vector<uint32_t>> candidates(threads);
+        std::vector<uint32_t>              merged;
+        for (unsigned plies = 1; plies < impossible - 1u && (!resolved.empty() || plies <= last); plies++)
+        {
+            parallel(resolved.size(), threads, [&](size_t begin, size_t end, unsigned thread)
+            {
+                candidates[thread].clear();
+                for (auto i = begin; i < end; i++)
+                {
+                    Placement placement;
+                    const auto side = resolved[i] / table.size;
+                    decode(table, resolved[i] % table.size, side == 0 ? Color::white : Color::black, placement);
+                    predecessors(placement, [&](const Placement& previous)
+                    {
+                        const auto offset = previous.turn == Color::white ? 0 : table.size;
+                        forEachIndex(table, previous, [&](size_t index)
+                        {
+                            if (table.data[offset + index] == unknown)
+                                candidates[thread].push_back(static_cast<uint32_t>(offset + index));
+                        });
+                    });
+                }
+            });
+
+            merged.swap(pending[plies]);
+            for (auto& positions : candidates)
+                merged.insert(merged.end(), positions.begin(), positions.end());
+            std::sort(merged.begin(), merged.end());
+            merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+
+            parallel(merged.size(), threads, [&](size_t begin, size_t end, unsigned thread)
+            {
+                found[thread].clear();
+                for (auto i = begin; i < end; i++)
+                {
+                    if (table.data[merged[i]] != unknown)
+                        continue;
+
+                    Placement placement;
+                    const auto side = merged[i] / table.size;
+                    decode(table, merged[i] % table.size, side == 0 ? Color::white : Color::black, placement);
+                    if (decided(placement, plies))
+                        found[thread].push_back(merged[i]);
+                }
+            });
+
+            resolved.clear();
+            for (const auto& positions : found)
+                for (auto position : positions)
+                {
+                    table.data[position] = static_cast<uint8_t>(plies + 1);
+                    resolved.push_back(position);
+                }
+            std::vector<uint32_t>().swap(merged);
+        }
+
+        // the impossible positions are kept, everything else which is not resolved is a draw
+        std::ofstream out(_directory + "/" + table.material + ".cmtb", std::ios::binary | std::ios::trunc);
+        const auto    length = static_cast<uint32_t>(table.material.size());
+        out.write(magic, sizeof(magic));
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(table.material.data(), static_cast<std::streamsize>(length));
+        out.write(reinterpret_cast<const char*>(table.data.data()), static_cast<std::streamsize>(table.data.size()));
+        if (!out)
+            return false;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tables[table.material] = std::move(result);
+        return true;
+    }
+
+    bool Tablebase::probe(Board& board, TablebaseResult& result)
+    {
+        if (BitboardHelper::count(board.getOccupied()) > maxFigures || board.getEnPassantColumn() >= 0)
+            return false;
+
+        Placement placement;
+        placement.turn = board.getCurrentColorTurn();
+        for (auto color : {Color::white, Color::black})
+        {
+            if (BitboardHelper::count(board.getFigures(color, FigureType::king)) != 1 || board.hasCastlingRight(color, true)
+                || board.hasCastlingRight(color, false))
+                return false;
+
+            for (auto type : figureOrder)
+            {
+                auto figures = board.getFigures(color, type);
+                while (figures != 0)
+                {
+                    placement.colors[placement.count]  = color;
+                    placement.types[placement.count]   = type;
+                    placement.squares[placement.count] = BitboardHelper::popLsb(figures);
+                    placement.count++;
+                }
+            }
+        }
+
+        const auto name = ChessNS::material(placement);
+        auto       flip = false;
+        auto*      next = table(name);
+        if (next == nullptr)
+        {
+            next = table(flipped(name));
+            flip = true;
+        }
+
+        if (next == nullptr)
+            return false;
+
+        const auto entry = value(*next, placement, flip);
+        if (entry == impossible)
+            return false;
+
+        result.plies = entry == unknown ? 0 : entry - 1u;
+        result.wdl   = entry == unknown ? Wdl::draw : result.plies % 2 == 1 ? Wdl::win : Wdl::loss;
+        return true;
+    }
+
+    GameResult Tablebase::adjudicate(Board& board)
+    {
+        TablebaseResult result;
+        if (!probe(board, result))
+            return GameResult::none;
+
+        if (result.wdl == Wdl::draw)
+            return GameResult::draw;
+
+        const auto white = (board.getCurrentColorTurn() == Color::white) == (result.wdl == Wdl::win);
+        return white ? GameResult::victoryWhite : GameResult::victoryBlack;
+    }
+
+    const Tablebase::Table* Tablebase::table(const std::string& material)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const auto found = _tables.find(material);
+        if (found != _tables.end())
+            return found->second.get();
+
+        // a missing file is remembered as nullptr
+        auto& entry = _tables[material];
+        auto  table = std::unique_ptr<Table>(new Table());
+        if (!parse(material, *table) || table->material != material || !table->file.open(_directory + "/" + material + ".cmtb"))
+            return nullptr;
+
+        const auto* data   = table->file.data();
+        const auto  header = sizeof(magic) + 2 * sizeof(uint32_t) + material.size();
+        uint32_t    fileVersion;
+        uint32_t    length;
+        if (table->file.size() != header + 2 * table->size || !std::equal(magic, magic + 4, reinterpret_cast<const char*>(data)))
+            return nullptr;
+
+        std::copy(data + 4, data + 8, reinterpret_cast<unsigned char*>(&fileVersion));
+        std::copy(data + 8, data + 12, reinterpret_cast<unsigned char*>(&length));
+        if (fileVersion != version || length != material.size()
+            || !std::equal(material.begin(), material.end(), reinterpret_cast<const char*>(data + 12)))
+            return nullptr;
+
+        table->values[0] = data + header;
+        table->values[1] = data + header + table->size;
+        entry            = std::move(table);
+        return entry.get();
+    }
+}
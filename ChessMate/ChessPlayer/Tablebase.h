@@ -0,0 +1,132 @@
+/*!
+* \brief:  Declares the endgame tablebase class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "ChessEngine/Board.h"
+
+namespace ChessNS
+{
+    /*!
+     * \enum    Wdl
+     *
+     * \brief   Values that represent the outcome of a position under perfect play
+     */
+    enum class Wdl { loss, draw, win };
+
+    /*!
+     * \struct  TablebaseResult
+     *
+     * \brief   The value of a position in the tablebase, from the view of the color on turn.
+     */
+    struct TablebaseResult
+    {
+        /*! \brief   The outcome */
+        Wdl wdl{Wdl::draw};
+        /*! \brief   The plies until the mate, 0 for a draw */
+        unsigned plies{};
+    };
+
+    /*!
+     * \class   Tablebase
+     *
+     * \brief   Endgame tablebases with the distance to mate for up to five figures. A table belongs to a material
+     *          like "KQK" or "KRPKR", white first, and is generated by retrograde analysis: starting from the mates
+     *          and the exits into other tables, each pass takes back a move from the positions decided in the pass
+     *          before and looks only at the positions reached this way. Captures and promotions lead into the tables
+     *          of the smaller material, which are generated first. The positions are indexed with the symmetries of
+     *          the board, the white king stays in one eighth of the board or, with pawns, in one half. Positions with
+     *          a castling right or an en passant capture are not in the tables, but a double step of a pawn is
+     *          answered with the en passant capture while the tables are generated.
+     */
+    class Tablebase
+    {
+    public:
+
+        /*! \brief   The maximum number of figures including the kings */
+        static constexpr int maxFigures = 5;
+
+        /*!
+         * \fn  explicit Tablebase::Tablebase(const std::string& directory);
+         *
+         * \brief   Constructor, the tables are loaded from the directory when they are needed first
+         *
+         * \param   directory   The directory of the table files.
+         */
+        explicit Tablebase(const std::string& directory);
+
+        ~Tablebase();
+
+        /*!
+         * \fn  bool Tablebase::generate(const std::string& material, unsigned threads = 0);
+         *
+         * \brief   Generates a table and the missing ones of smaller material and writes them to the directory
+         *
+         * \param   material    The material, the figures of white and then of black in the order KQRBNP.
+         * \param   threads     (Optional) The number of threads, 0 for one per core.
+         *
+         * \returns True if it succeeds, false if the material is invalid or a file can not be written.
+         */
+        bool generate(const std::string& material, unsigned threads = 0);
+
+        /*!
+         * \fn  bool Tablebase::probe(Board& board, TablebaseResult& result);
+         *
+         * \brief   Looks up a position, it is thread safe
+         *
+         * \param [in,out]  board   The board.
+         * \param [out]     result  The result, only set if found.
+         *
+         * \returns True if the position is in a table, false if not.
+         */
+        bool probe(Board& board, TablebaseResult& result);
+
+        /*!
+         * \fn  GameResult Tablebase::adjudicate(Board& board);
+         *
+         * \brief   Gets the result of the game under perfect play
+         *
+         * \param [in,out]  board   The board.
+         *
+         * \returns The result, GameResult::none if the position is not in a table.
+         */
+        GameResult adjudicate(Board& board);
+
+        /*! \brief   A loaded or generated table */
+        struct Table;
+
+    private:
+
+        const Table* table(const std::string& material);
+
+        std::string                                   _directory;
+        std::mutex                                    _mutex;
+        std::map<std::string, std::unique_ptr<Table>> _tables;
+    };
+}
@@ -0,0 +1,86 @@
+/*!
+* \brief:  Implements the transposition table
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "TranspositionTable.h"
+#include <algorithm>
+
+namespace ChessNS
+{
+    TranspositionTable::TranspositionTable(size_t megabytes)
+    {
+        resize(megabytes);
+    }
+
+    void TranspositionTable::resize(size_t megabytes)
+    {
+        size_t count = 1;
+        while (count * 2 * sizeof(TranspositionEntry) <= megabytes * 1024 * 1024)
+            count *= 2;
+
+        _megabytes = megabytes;
+        _entries.assign(count, TranspositionEntry());
+    }
+
+    size_t TranspositionTable::megabytes() const
+    {
+        return _megabytes;
+    }
+
+    void TranspositionTable::clear()
+    {
+        std::fill(_entries.begin(), _entries.end(), TranspositionEntry());
+    }
+
+    bool TranspositionTable::probe(uint64_t key, TranspositionEntry& entry) const
+    {
+        const auto& slot = _entries[key & (_entries.size() - 1)];
+        if (slot.bound == Bound::none || slot.key != key)
+            return false;
+
+        entry = slot;
+        return true;
+    }
+
+    void TranspositionTable::store(uint64_t key, PackedMove move, int score, int depth, Bound bound)
+    {
+        auto& slot = _entries[key & (_entries.size() - 1)];
+        if (slot.key == key && slot.bound != Bound::none)
+        {
+            // a deeper result of the same position is worth more than a newer one
+            if (depth < slot.depth && bound != Bound::exact)
+                return;
+
+            if (move == 0)
+                move = slot.move;
+        }
+
+        slot.key   = key;
+        slot.move  = move;
+        slot.score = static_cast<int16_t>(score);
+        slot.depth = static_cast<int8_t>(depth);
+        slot.bound = bound;
+    }
+}
@@ -0,0 +1,133 @@
+/*!
+* \brief:  Declares the transposition table
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "MoveHistory.h"
+
+namespace ChessNS
+{
+    /*!
+     * \enum    Bound
+     *
+     * \brief   Values that represent how a stored score relates to the real score
+     */
+    enum class Bound : uint8_t { none, exact, lower, upper };
+
+    /*!
+     * \struct  TranspositionEntry
+     *
+     * \brief   A searched position.
+     */
+    struct TranspositionEntry
+    {
+        /*! \brief   The hash of the position */
+        uint64_t key{};
+        /*! \brief   The best move found */
+        PackedMove move{};
+        /*! \brief   The score */
+        int16_t score{};
+        /*! \brief   The remaining depth of the search */
+        int8_t depth{};
+        /*! \brief   The kind of the score */
+        Bound bound{Bound::none};
+    };
+
+    /*!
+     * \class   TranspositionTable
+     *
+     * \brief   A hash table of searched positions, one entry per slot which is replaced by deeper or newer searches.
+     */
+    class TranspositionTable
+    {
+    public:
+
+        /*!
+         * \fn  explicit TranspositionTable::TranspositionTable(size_t megabytes);
+         *
+         * \brief   Constructor
+         *
+         * \param   megabytes   The size of the table in megabytes, rounded down to a power of two entries.
+         */
+        explicit TranspositionTable(size_t megabytes);
+
+        /*!
+         * \fn  void TranspositionTable::resize(size_t megabytes);
+         *
+         * \brief   Changes the size of the table, all entries are lost
+         *
+         * \param   megabytes   The size of the table in megabytes.
+         */
+        void resize(size_t megabytes);
+
+        /*!
+         * \fn  size_t TranspositionTable::megabytes() const;
+         *
+         * \brief   Gets the size the table was created with
+         *
+         * \returns The size in megabytes.
+         */
+        size_t megabytes() const;
+
+        /*!
+         * \fn  void TranspositionTable::clear();
+         *
+         * \brief   Removes all entries
+         */
+        void clear();
+
+        /*!
+         * \fn  bool TranspositionTable::probe(uint64_t key, TranspositionEntry& entry) const;
+         *
+         * \brief   Looks up a position
+         *
+         * \param           key     The hash of the position.
+         * \param [out]     entry   The entry, only set if found.
+         *
+         * \returns True if the position was found, false if not.
+         */
+        bool probe(uint64_t key, TranspositionEntry& entry) const;
+
+        /*!
+         * \fn  void TranspositionTable::store(uint64_t key, PackedMove move, int score, int depth, Bound bound);
+         *
+         * \brief   Stores a position, the best move of an older entry of the same position is kept if none is given
+         *
+         * \param   key     The hash of the position.
+         * \param   move    The best move, 0 if unknown.
+         * \param   score   The score.
+         * \param   depth   The remaining depth.
+         * \param   bound   The kind of the score.
+         */
+        void store(uint64_t key, PackedMove move, int score, int depth, Bound bound);
+
+    private:
+
+        std::vector<TranspositionEntry> _entries;
+        size_t                          _megabytes{};
+    };
+}
@@ -0,0 +1,144 @@
+﻿/*!
+* \brief:  Implements the bench tool, which searches a fixed set of positions for reproducible node counts
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ChessPlayer/Mcts.h"
+#include "ChessPlayer/Search.h"
+
+// the positions are given by their moves from the start, so they do not depend on a position format
+static const std::vector<std::string> positions = {
+    "",
+    "e2-e4 e7-e5 g1-f3 b8-c6 f1-b5 a7-a6",
+    "d2-d4 d7-d5 c2-c4 e7-e6 b1-c3 g8-f6 c1-g5 f8-e7",
+    "e2-e4 c7-c5 g1-f3 d7-d6 d2-d4 c5-d4 f3-d4 g8-f6 b1-c3 a7-a6",
+    "e2-e4 e7-e6 d2-d4 d7-d5 e4-e5 c7-c5 c2-c3 b8-c6",
+    "c2-c4 e7-e5 b1-c3 g8-f6 g2-g3 d7-d5 c4-d5 f6-d5 f1-g2 d5-b6",
+    "e2-e4 e7-e5 g1-f3 b8-c6 f1-c4 f8-c5 c2-c3 g8-f6 d2-d4 e5-d4 c3-d4 c5-b4",
+    "d2-d4 g8-f6 c2-c4 g7-g6 b1-c3 f8-g7 e2-e4 d7-d6 g1-f3 e8-g8 f1-e2 e7-e5"};
+
+static int usage()
+{
+    std::cout << "Usage: bench [--depth N] [--nodes N] [--playouts N] [--seed N]" << std::endl;
+    return 1;
+}
+
+static bool setup(ChessNS::Board& board, const std::string& moves)
+{
+    std::istringstream in(moves);
+    std::string        move;
+    while (in >> move)
+    {
+        if (move.size() != 5)
+            return false;
+
+        ChessNS::Position origin;
+        ChessNS::Position destination;
+        origin.set(move[1] - '1', move[0] - 'a');
+        destination.set(move[4] - '1', move[3] - 'a');
+        if (board.move(origin, destination).moveResult() != ChessNS::MoveResult::valid)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    ChessNS::SearchConfig searchConfig;
+    ChessNS::MctsConfig   mctsConfig;
+    bool                  mcts = false;
+
+    searchConfig.depth = 5;
+    mctsConfig.threads = 1;
+    mctsConfig.seeded  = true;
+    mctsConfig.seed    = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (i + 1 >= argc)
+            return usage();
+
+        const auto value = std::strtoull(argv[++i], nullptr, 10);
+        if (argument == "--depth")
+            searchConfig.depth = static_cast<unsigned>(value);
+        else if (argument == "--nodes")
+            searchConfig.nodes = value;
+        else if (argument == "--playouts")
+        {
+            mcts                = true;
+            mctsConfig.playouts = value;
+        }
+        else if (argument == "--seed")
+            mctsConfig.seed = static_cast<uint32_t>(value);
+        else
+            return usage();
+    }
+
+    // one thread and fresh tables for every position, so the counts only change with the code
+    uint64_t   total = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        ChessNS::Board board;
+        if (!setup(board, positions[i]))
+        {
+            std::cout << "Position " << i + 1 << " is invalid" << std::endl;
+            return 1;
+        }
+
+        ChessNS::Movement best;
+        uint64_t          count;
+        if (mcts)
+        {
+            auto result = ChessNS::Mcts(mctsConfig).run(board);
+            best        = result.bestMove;
+            count       = result.playouts;
+        }
+        else
+        {
+            auto result = ChessNS::Search(searchConfig).run(board);
+            best        = result.bestMove;
+            count       = result.nodes;
+        }
+
+        total += count;
+        std::cout << "Position " << i + 1 << ": " << best.origin().toString() << "-" << best.destination().toString()
+            << " " << count << std::endl;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << (mcts ? "Playouts: " : "Nodes searched: ") << total << std::endl;
+    std::cout << (mcts ? "Playouts/second: " : "Nodes/second: ") << total * 1000 / std::max<uint64_t>(1, elapsed) << std::endl;
+    std::cout << "Time: " << elapsed << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+﻿/*!
+* \brief:  Implements the bookbuild tool, which compiles PGN files into a Polyglot opening book
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ChessParser/PgnParser.h"
+#include "ChessPlayer/BookBuilder.h"
+
+static int usage()
+{
+    std::cout << "Usage: bookbuild [--plies N] [--threads N] [--memory MB] [--min-games N] <book.bin> <games.pgn>..." << std::endl;
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    ChessNS::BookBuildConfig config;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument.substr(0, 2) != "--")
+        {
+            files.push_back(argument);
+            continue;
+        }
+
+        if (i + 1 >= argc)
+            return usage();
+
+        const auto value = std::strtoul(argv[++i], nullptr, 10);
+        if (argument == "--plies")
+            config.plies = static_cast<unsigned>(value);
+        else if (argument == "--threads")
+            config.threads = static_cast<unsigned>(value);
+        else if (argument == "--memory")
+            config.memory = value;
+        else if (argument == "--min-games")
+            config.minGames = static_cast<unsigned>(value);
+        else
+            return usage();
+    }
+
+    if (files.size() < 2)
+        return usage();
+
+    // the games are parsed here and replayed by the workers of the builder in batches
+    const size_t               batchSize = 256;
+    ChessNS::BookBuilder       builder(files[0], config);
+    ChessNS::PgnParser         parser;
+    std::vector<ChessNS::Game> batch;
+    uint64_t                   skipped = 0;
+
+    for (size_t i = 1; i < files.size(); i++)
+    {
+        std::ifstream in(files[i]);
+        if (!in)
+        {
+            std::cout << "Can not open " << files[i] << std::endl;
+            continue;
+        }
+
+        while (!in.eof())
+        {
+            try
+            {
+                batch.push_back(parser.parseSingleGame(in));
+            }
+            catch (const std::exception&)
+            {
+                skipped++;
+            }
+
+            if (batch.size() == batchSize)
+            {
+                builder.add(std::move(batch));
+                batch = std::vector<ChessNS::Game>();
+            }
+        }
+    }
+
+    builder.add(std::move(batch));
+    if (!builder.finish())
+    {
+        std::cout << "Can not write " << files[0] << std::endl;
+        return 1;
+    }
+
+    std::cout << builder.games() << " games, " << skipped << " skipped, " << builder.entries() << " book entries" << std::endl;
+    return 0;
+}
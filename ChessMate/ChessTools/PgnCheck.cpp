@@ -0,0 +1,235 @@
+﻿/*!
+* \brief:  Implements the pgncheck tool, which replays every game of a pgn archive to find invalid games
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BasicUtils/MappedFile.h"
+#include "ChessEngine/Board.h"
+#include "ChessParser/PgnParser.h"
+
+namespace
+{
+    struct Error
+    {
+        size_t      offset;
+        size_t      game;
+        size_t      ply;
+        std::string message;
+    };
+
+    struct Part
+    {
+        size_t             games{};
+        uint64_t           moves{};
+        std::vector<Error> errors;
+    };
+
+    // replays a game on a board in the start position and takes the moves back afterwards, returns the error
+    std::string replay(ChessNS::Board& board, ChessNS::Game& game, size_t& ply)
+    {
+        std::string error;
+        size_t      made = 0;
+        for (ply = 0; ply < game.movements.size(); ply++)
+        {
+            auto&      parsed   = game.movements[ply];
+            auto       resolved = parsed;
+            const auto color    = board.getCurrentColorTurn();
+            const auto resolve  = board.resolve(resolved);
+            if (resolve != ChessNS::ResolveResult::unique)
+            {
+                error = resolve == ChessNS::ResolveResult::ambiguous ? "ambiguous move" : "illegal move";
+                break;
+            }
+
+            const auto lastRow = color == ChessNS::Color::white ? ChessNS::BoardRow::r8 : ChessNS::BoardRow::r1;
+            if (parsed.figureType() == ChessNS::FigureType::pawn && parsed.destination().row == lastRow
+                && parsed.promotedTo() == ChessNS::FigureType::none)
+            {
+                error = "missing promotion";
+                break;
+            }
+
+            // the resolved move is legal, so it is not checked again
+            const auto check = board.makeLegalMove(resolved.origin(), resolved.destination(), parsed.promotedTo()).hasFlag(ChessNS::EventFlag::check);
+            made++;
+
+            // a mate is only looked for where it is claimed or at the end, as it needs all moves
+            const auto last = ply + 1 == game.movements.size();
+            const auto mate     = check && (last || parsed.hasFlag(ChessNS::EventFlag::checkmate))
+                && !board.hasLegalMove();
+
+            if (parsed.hasFlag(ChessNS::EventFlag::checkmate) != mate)
+                error = mate ? "missing checkmate marker" : "wrong checkmate marker";
+            else if (!mate && parsed.hasFlag(ChessNS::EventFlag::check) != check)
+                error = check ? "missing check marker" : "wrong check marker";
+            else if (mate && game.result != ChessNS::GameResult::none
+                && game.result != (color == ChessNS::Color::white ? ChessNS::GameResult::victoryWhite : ChessNS::GameResult::victoryBlack))
+                error = "result does not fit the checkmate";
+            else if (last && !check && game.result != ChessNS::GameResult::draw && !board.hasLegalMove())
+                error = "result does not fit the stalemate";
+
+            if (!error.empty())
+                break;
+        }
+
+        // the board is reused for the next game
+        for (; made > 0; made--)
+            board.unmakeMove();
+        return error;
+    }
+}
+
+static int usage()
+{
+    std::cout << "Usage: pgncheck [--threads N] [--max-errors N] <games.pgn>" << std::endl;
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned    threads   = 0;
+    size_t      maxErrors = 100;
+    std::string filename;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument.substr(0, 2) != "--")
+        {
+            filename = argument;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+            return usage();
+
+        const auto value = std::strtoul(argv[++i], nullptr, 10);
+        if (argument == "--threads")
+            threads = static_cast<unsigned>(value);
+        else if (argument == "--max-errors")
+            maxErrors = value;
+        else
+            return usage();
+    }
+
+    if (filename.empty())
+        return usage();
+
+    ChessNS::MappedFile file;
+    if (!file.open(filename))
+    {
+        std::cout << "Can not open " << filename << std::endl;
+        return 1;
+    }
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    const auto start  = std::chrono::steady_clock::now();
+    const auto buffer = ChessNS::StringView(reinterpret_cast<const char*>(file.data()), file.size());
+    const auto parts  = ChessNS::PgnParser::splitGames(buffer, 4 * threads);
+
+    // every worker takes the next part and keeps its board, lexer and game for all of them
+    std::vector<Part>   results(parts.size());
+    std::atomic<size_t> next{0};
+    auto                work = [&]()
+    {
+        ChessNS::Board     board;
+        ChessNS::PgnLexer  lexer;
+        ChessNS::PgnParser parser;
+        ChessNS::Game      game;
+        for (auto index = next++; index < parts.size(); index = next++)
+        {
+            auto& part = results[index];
+            lexer.reset(parts[index]);
+            for (auto token = lexer.peek(); token.type != ChessNS::PgnTokenType::end; token = lexer.peek())
+            {
+                const auto offset = static_cast<size_t>(token.text.data() - buffer.data());
+                size_t     ply    = 0;
+                std::string error;
+                try
+                {
+                    if (!parser.parseNextGame(lexer, game))
+                        break;
+                    error = replay(board, game, ply);
+                }
+                catch (const std::out_of_range&)
+                {
+                    // the moves before the invalid one are in the game
+                    ply   = game.movements.size();
+                    error = "invalid movetext";
+                }
+
+                if (!error.empty())
+                    part.errors.push_back({offset, part.games, ply, error});
+                part.moves += error.empty() ? game.movements.size() : ply;
+                part.games++;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threads && i < parts.size(); i++)
+        workers.emplace_back(work);
+    work();
+    for (auto& worker : workers)
+        worker.join();
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // the parts are in the order of the file, so the games can be numbered now
+    size_t   games  = 0;
+    uint64_t moves  = 0;
+    size_t   errors = 0;
+    for (auto& part : results)
+    {
+        for (auto& error : part.errors)
+        {
+            if (errors++ < maxErrors)
+                std::cout << "Offset " << error.offset << ", game " << games + error.game + 1 << ", ply " << error.ply + 1
+                    << ": " << error.message << std::endl;
+        }
+        games += part.games;
+        moves += part.moves;
+    }
+
+    const auto seconds = std::max<double>(1, static_cast<double>(elapsed)) / 1000;
+    std::cout << "Games: " << games << std::endl;
+    std::cout << "Moves: " << moves << std::endl;
+    std::cout << "Errors: " << errors << std::endl;
+    std::cout << "Games/second: " << static_cast<uint64_t>(games / seconds) << std::endl;
+    std::cout << "Moves/second: " << static_cast<uint64_t>(moves / seconds) << std::endl;
+    std::cout << "Time: " << elapsed << " ms" << std::endl;
+    return errors == 0 ? 0 : 2;
+}
@@ -0,0 +1,74 @@
+﻿/*!
+* \brief:  Implements the tbgen tool, which generates endgame tablebases
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ChessPlayer/Tablebase.h"
+
+static int usage()
+{
+    std::cout << "Usage: tbgen [--threads N] <directory> <material>..., e.g. tbgen tables KQK KRK KPK" << std::endl;
+    return 1;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned                 threads = 0;
+    std::vector<std::string> arguments;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (argument.substr(0, 2) == "--")
+            return usage();
+        else
+            arguments.push_back(argument);
+    }
+
+    if (arguments.size() < 2)
+        return usage();
+
+    ChessNS::Tablebase tablebase(arguments[0]);
+    for (size_t i = 1; i < arguments.size(); i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (!tablebase.generate(arguments[i], threads))
+        {
+            std::cout << "Can not generate " << arguments[i] << std::endl;
+            return 1;
+        }
+
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << arguments[i] << " generated in " << seconds << " s" << std::endl;
+    }
+
+    return 0;
+}
@@ -25,6 +25,7 @@
  */
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include "ChessEngine/Board.h"
 
 namespace ChessNS
@@ -36,9 +37,9 @@ namespace ChessNS
 
         virtual ~TestBoard() = default;
 
-        static void createFigure(Field& field, FigureType figureType, Color color)
+        void createFigure(Field& field, FigureType figureType, Color color)
         {
-            Board::createFigure(field, figureType, color);
+            _board.createFigure(field, figureType, color);
         }
 
         void renewBoard()
@@ -52,9 +53,9 @@ namespace ChessNS
     class TestBoardRelationalMove : public ::testing::TestWithParam<Position>
     {
     protected:
-        static void createFigure(Field& field, FigureType figureType, Color color)
+        void createFigure(Field& field, FigureType figureType, Color color)
         {
-            Board::createFigure(field, figureType, color);
+            _board.createFigure(field, figureType, color);
         }
 
         Board _board{Board::BoardStartType::empty};
@@ -63,9 +64,9 @@ namespace ChessNS
     class TestBoardDiagonalMove : public ::testing::TestWithParam<FigureType>
     {
     protected:
-        static void createFigure(Field& field, FigureType figureType, Color color)
+        void createFigure(Field& field, FigureType figureType, Color color)
         {
-            Board::createFigure(field, figureType, color);
+            _board.createFigure(field, figureType, color);
         }
 
         void renewBoard()
@@ -79,9 +80,9 @@ namespace ChessNS
     class TestBoardRankFieldMove : public ::testing::TestWithParam<FigureType>
     {
     protected:
-        static void createFigure(Field& field, FigureType figureType, Color color)
+        void createFigure(Field& field, FigureType figureType, Color color)
         {
-            Board::createFigure(field, figureType, color);
+            _board.createFigure(field, figureType, color);
         }
 
         void renewBoard()
@@ -427,6 +428,21 @@ namespace ChessNS
         ASSERT_EQ(MoveResult::invalid, _board.move(origin, target).moveResult());
     }
 
+    TEST_F(TestBoard, moveKing_queenSideCastlingInCheck_invalid)
+    {
+        const Position origin(BoardRow::r1, BoardColumn::cE);
+        const Position target(BoardRow::r1, BoardColumn::cC);
+        const Position attacker(BoardRow::r8, BoardColumn::cE);
+
+        createFigure(_board.at(origin), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cA), FigureType::rook, Color::white);
+        ASSERT_EQ(MoveResult::valid, _board.at(origin).figure.move(target, &_board, false).moveResult());
+
+        // the king may not castle out of check, although f1 is not attacked
+        createFigure(_board.at(attacker), FigureType::rook, Color::black);
+        ASSERT_EQ(MoveResult::invalid, _board.at(origin).figure.move(target, &_board, false).moveResult());
+    }
+
     TEST_P(TestBoardRankFieldMove, move_emptyFieldDownToTop_valid)
     {
         const Position origin(BoardRow::r1, BoardColumn::cE);
@@ -786,4 +802,442 @@ namespace ChessNS
         ASSERT_EQ(GameResult::draw, _board.checkVictory());
         ASSERT_TRUE(_board.hasEnded());
     }
+
+    TEST_F(TestBoard, makeMove_allPossibleMoves_unmakeMoveRestoresBoard)
+    {
+        Board board;
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE)).moveResult());
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r7, BoardColumn::cD), Position(BoardRow::r5, BoardColumn::cD)).moveResult());
+
+        auto before = board;
+        auto moves  = board.getAllPossibleMoves(Color::white);
+        ASSERT_FALSE(moves.empty());
+
+        for (auto&& movement : moves)
+        {
+            ASSERT_EQ(MoveResult::valid, board.makeMove(movement.origin(), movement.destination()).moveResult());
+            ASSERT_EQ(Color::black, board.getCurrentColorTurn());
+            board.unmakeMove();
+
+            ASSERT_EQ(before.currentMove(), board.currentMove());
+            ASSERT_EQ(before.getCurrentColorTurn(), board.getCurrentColorTurn());
+            ASSERT_EQ(before.getAllMadeMoves().size(), board.getAllMadeMoves().size());
+
+            for (int row = 0; row < 8; row++)
+                for (int col = 0; col < 8; col++)
+                {
+                    const Position position(row, col);
+                    ASSERT_EQ(before.at(position).empty, board.at(position).empty);
+                    ASSERT_EQ(before.at(position).figure.getType(), board.at(position).figure.getType());
+                    ASSERT_EQ(before.at(position).figure.getColor(), board.at(position).figure.getColor());
+                    ASSERT_EQ(before.at(position).figure.nbrOfMovements(), board.at(position).figure.nbrOfMovements());
+                }
+        }
+    }
+
+    TEST_F(TestBoard, makeLegalMove_allPossibleMoves_sameAsMakeMove)
+    {
+        // white can capture en passant, castle and give check
+        Board board;
+        for (auto move : {std::make_pair(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE)),
+                          std::make_pair(Position(BoardRow::r7, BoardColumn::cA), Position(BoardRow::r6, BoardColumn::cA)),
+                          std::make_pair(Position(BoardRow::r4, BoardColumn::cE), Position(BoardRow::r5, BoardColumn::cE)),
+                          std::make_pair(Position(BoardRow::r7, BoardColumn::cF), Position(BoardRow::r5, BoardColumn::cF)),
+                          std::make_pair(Position(BoardRow::r1, BoardColumn::cG), Position(BoardRow::r3, BoardColumn::cF)),
+                          std::make_pair(Position(BoardRow::r6, BoardColumn::cA), Position(BoardRow::r5, BoardColumn::cA)),
+                          std::make_pair(Position(BoardRow::r1, BoardColumn::cF), Position(BoardRow::r4, BoardColumn::cC)),
+                          std::make_pair(Position(BoardRow::r7, BoardColumn::cD), Position(BoardRow::r5, BoardColumn::cD))})
+            ASSERT_EQ(MoveResult::valid, board.move(move.first, move.second).moveResult());
+
+        auto moves = board.getAllPossibleMoves(Color::white);
+        ASSERT_FALSE(moves.empty());
+
+        for (auto&& movement : moves)
+        {
+            auto       expected = board.makeMove(movement.origin(), movement.destination(), FigureType::queen);
+            const auto hash     = board.getHash();
+            board.unmakeMove();
+
+            auto result = board.makeLegalMove(movement.origin(), movement.destination(), FigureType::queen);
+            ASSERT_EQ(MoveResult::valid, result.moveResult());
+            ASSERT_EQ(expected.hasFlag(EventFlag::check), result.hasFlag(EventFlag::check));
+            ASSERT_EQ(expected.hasFlag(EventFlag::capture), result.hasFlag(EventFlag::capture));
+            ASSERT_EQ(hash, board.getHash());
+            board.unmakeMove();
+        }
+    }
+
+    TEST_F(TestBoard, makeMove_intoCheck_invalidAndUnchanged)
+    {
+        const Position kingPos(BoardRow::r1, BoardColumn::cE);
+        const Position knightPos(BoardRow::r2, BoardColumn::cE);
+        const Position rookPos(BoardRow::r8, BoardColumn::cE);
+        const Position knightDes(BoardRow::r4, BoardColumn::cF);
+
+        createFigure(_board.at(kingPos), FigureType::king, Color::white);
+        createFigure(_board.at(knightPos), FigureType::knight, Color::white);
+        createFigure(_board.at(rookPos), FigureType::rook, Color::black);
+
+        ASSERT_EQ(MoveResult::invalid, _board.makeMove(knightPos, knightDes).moveResult());
+        ASSERT_EQ(FigureType::knight, _board.at(knightPos).figure.getType());
+        ASSERT_TRUE(_board.at(knightDes).empty);
+        ASSERT_TRUE(_board.getAllMadeMoves().empty());
+    }
+
+    TEST_F(TestBoard, makeNullMove_afterDoubleStep_noEnPassantAndRestored)
+    {
+        const Position originWhite(BoardRow::r2, BoardColumn::cE);
+        const Position destinationWhite(BoardRow::r4, BoardColumn::cE);
+        const Position originBlack(BoardRow::r4, BoardColumn::cD);
+        const Position enPassant(BoardRow::r3, BoardColumn::cE);
+
+        createFigure(_board.at(originWhite), FigureType::pawn, Color::white);
+        createFigure(_board.at(originBlack), FigureType::pawn, Color::black);
+
+        ASSERT_EQ(MoveResult::valid, _board.makeMove(originWhite, destinationWhite).moveResult());
+        const auto currentMove = _board.currentMove();
+
+        _board.makeNullMove();
+        ASSERT_EQ(Color::white, _board.getCurrentColorTurn());
+        _board.makeNullMove();
+        ASSERT_EQ(MoveResult::invalid, _board.makeMove(originBlack, enPassant).moveResult());
+
+        _board.unmakeMove();
+        _board.unmakeMove();
+        ASSERT_EQ(Color::black, _board.getCurrentColorTurn());
+        ASSERT_EQ(currentMove, _board.currentMove());
+        ASSERT_EQ(1, _board.getAllMadeMoves().size());
+        ASSERT_EQ(MoveResult::valid, _board.makeMove(originBlack, enPassant).moveResult());
+    }
+
+    TEST_F(TestBoard, getHash_transposition_sameHashAndRestored)
+    {
+        Board first;
+        Board second;
+        const auto start = first.getHash();
+
+        ASSERT_EQ(MoveResult::valid, first.makeMove(Position(BoardRow::r1, BoardColumn::cG), Position(BoardRow::r3, BoardColumn::cF)).moveResult());
+        ASSERT_NE(start, first.getHash());
+        ASSERT_EQ(MoveResult::valid, first.makeMove(Position(BoardRow::r8, BoardColumn::cG), Position(BoardRow::r6, BoardColumn::cF)).moveResult());
+        ASSERT_EQ(MoveResult::valid, first.makeMove(Position(BoardRow::r1, BoardColumn::cB), Position(BoardRow::r3, BoardColumn::cC)).moveResult());
+
+        ASSERT_EQ(MoveResult::valid, second.makeMove(Position(BoardRow::r1, BoardColumn::cB), Position(BoardRow::r3, BoardColumn::cC)).moveResult());
+        ASSERT_EQ(MoveResult::valid, second.makeMove(Position(BoardRow::r8, BoardColumn::cG), Position(BoardRow::r6, BoardColumn::cF)).moveResult());
+        ASSERT_EQ(MoveResult::valid, second.makeMove(Position(BoardRow::r1, BoardColumn::cG), Position(BoardRow::r3, BoardColumn::cF)).moveResult());
+
+        ASSERT_EQ(first.getHash(), second.getHash());
+
+        first.unmakeMove();
+        first.unmakeMove();
+        first.unmakeMove();
+        ASSERT_EQ(start, first.getHash());
+
+        // the same figures with the other color on turn
+        first.makeNullMove();
+        ASSERT_NE(start, first.getHash());
+    }
+
+    TEST_F(TestBoard, getPawnHash_figureAndPawnMoves_onlyPawnsChangeIt)
+    {
+        Board      board;
+        const auto start = board.getPawnHash();
+
+        ASSERT_EQ(MoveResult::valid, board.makeMove(Position(BoardRow::r1, BoardColumn::cG), Position(BoardRow::r3, BoardColumn::cF)).moveResult());
+        ASSERT_EQ(start, board.getPawnHash());
+
+        ASSERT_EQ(MoveResult::valid, board.makeMove(Position(BoardRow::r7, BoardColumn::cE), Position(BoardRow::r5, BoardColumn::cE)).moveResult());
+        ASSERT_NE(start, board.getPawnHash());
+
+        board.unmakeMove();
+        ASSERT_EQ(start, board.getPawnHash());
+    }
+
+    TEST_F(TestBoard, getAllPossibleQuietMoves_mixedPosition_allMovesWithoutCaptures)
+    {
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cE), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cH), FigureType::rook, Color::white);
+        createFigure(_board.at(BoardRow::r2, BoardColumn::cB), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r7, BoardColumn::cA), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r3, BoardColumn::cC), FigureType::knight, Color::white);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cH), FigureType::king, Color::black);
+        createFigure(_board.at(BoardRow::r4, BoardColumn::cB), FigureType::bishop, Color::black);
+
+        auto quiets = _board.getAllPossibleQuietMoves(Color::white);
+        for (auto&& quiet : quiets)
+            ASSERT_FALSE(quiet.hasFlag(EventFlag::capture) || quiet.hasFlag(EventFlag::promotion));
+
+        size_t expected = 0;
+        bool   castling = false;
+        for (auto&& movement : _board.getAllPossibleMoves(Color::white))
+        {
+            if (!movement.hasFlag(EventFlag::capture) && !movement.hasFlag(EventFlag::promotion))
+                ++expected;
+            castling |= movement.hasFlag(EventFlag::castling);
+        }
+
+        ASSERT_TRUE(castling);
+        ASSERT_EQ(expected, quiets.size());
+    }
+
+    TEST_F(TestBoard, evaluate_movesAndCaptures_incrementalEqualsRecalculated)
+    {
+        Board board;
+        ASSERT_EQ(0, board.evaluate());
+
+        const char* moves[][2] = {{"e2", "e4"}, {"d7", "d5"}, {"e4", "d5"}, {"d8", "d5"}, {"b1", "c3"}};
+        for (auto&& move : moves)
+        {
+            const Position origin(move[0][1] - '1', move[0][0] - 'a');
+            const Position destination(move[1][1] - '1', move[1][0] - 'a');
+            ASSERT_EQ(MoveResult::valid, board.makeMove(origin, destination).moveResult());
+        }
+
+        const auto middlegame = board.evaluate(GamePhase::middlegame);
+        const auto endgame    = board.evaluate(GamePhase::endgame);
+        const auto score      = board.evaluate();
+
+        board.setEvalParams(EvalParams::defaults());
+        ASSERT_EQ(middlegame, board.evaluate(GamePhase::middlegame));
+        ASSERT_EQ(endgame, board.evaluate(GamePhase::endgame));
+        ASSERT_EQ(score, board.evaluate());
+
+        for (size_t i = 0; i < 5; i++)
+            board.unmakeMove();
+
+        ASSERT_EQ(0, board.evaluate(GamePhase::middlegame));
+        ASSERT_EQ(0, board.evaluate(GamePhase::endgame));
+    }
+
+    TEST_F(TestBoard, getAllPossibleCaptures_mixedPosition_onlyCapturesAndPromotions)
+    {
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cE), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r3, BoardColumn::cC), FigureType::knight, Color::white);
+        createFigure(_board.at(BoardRow::r7, BoardColumn::cA), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cH), FigureType::king, Color::black);
+        createFigure(_board.at(BoardRow::r5, BoardColumn::cD), FigureType::pawn, Color::black);
+        createFigure(_board.at(BoardRow::r5, BoardColumn::cB), FigureType::bishop, Color::black);
+
+        auto captures = _board.getAllPossibleCaptures(Color::white);
+        ASSERT_EQ(3, captures.size());
+
+        for (auto&& capture : captures)
+            ASSERT_TRUE(capture.hasFlag(EventFlag::capture) || capture.hasFlag(EventFlag::promotion));
+
+        size_t expected = 0;
+        for (auto&& movement : _board.getAllPossibleMoves(Color::white))
+            if (movement.hasFlag(EventFlag::capture) || movement.hasFlag(EventFlag::promotion))
+                ++expected;
+
+        ASSERT_EQ(expected, captures.size());
+    }
+
+    TEST_F(TestBoard, see_captureDefendedByPawn_losesKnight)
+    {
+        const Position knightPos(BoardRow::r3, BoardColumn::cC);
+        const Position pawnPos(BoardRow::r5, BoardColumn::cD);
+
+        createFigure(_board.at(knightPos), FigureType::knight, Color::white);
+        createFigure(_board.at(pawnPos), FigureType::pawn, Color::black);
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cE), FigureType::pawn, Color::black);
+
+        ASSERT_EQ(100 - 320, _board.see(knightPos, pawnPos));
+    }
+
+    TEST_F(TestBoard, see_captureUndefended_winsFigure)
+    {
+        const Position rookPos(BoardRow::r1, BoardColumn::cD);
+        const Position bishopPos(BoardRow::r6, BoardColumn::cD);
+
+        createFigure(_board.at(rookPos), FigureType::rook, Color::white);
+        createFigure(_board.at(bishopPos), FigureType::bishop, Color::black);
+
+        ASSERT_EQ(330, _board.see(rookPos, bishopPos));
+    }
+
+    TEST_F(TestBoard, see_xRayBehindRook_recaptureCounted)
+    {
+        const Position rookPos(BoardRow::r1, BoardColumn::cD);
+        const Position pawnPos(BoardRow::r5, BoardColumn::cD);
+
+        // the queen behind the rook takes back after the knight recaptured
+        createFigure(_board.at(rookPos), FigureType::rook, Color::white);
+        createFigure(_board.at(BoardRow::r2, BoardColumn::cD), FigureType::queen, Color::white);
+        createFigure(_board.at(pawnPos), FigureType::pawn, Color::black);
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cF), FigureType::knight, Color::black);
+
+        ASSERT_EQ(100 - 500 + 320, _board.see(rookPos, pawnPos));
+
+        _board.removeFigure(Position(BoardRow::r2, BoardColumn::cD));
+        ASSERT_EQ(100 - 500, _board.see(rookPos, pawnPos));
+    }
+
+    TEST_F(TestBoard, resolve_pinsAndDisambiguation_uniqueAmbiguousOrIllegal)
+    {
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cE), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r3, BoardColumn::cE), FigureType::knight, Color::white);
+        createFigure(_board.at(BoardRow::r2, BoardColumn::cB), FigureType::knight, Color::white);
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cH), FigureType::rook, Color::white);
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cA), FigureType::rook, Color::white);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cE), FigureType::rook, Color::black);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cH), FigureType::king, Color::black);
+
+        // the knight on e3 is pinned, so only the one on b2 reaches c4
+        Movement movement;
+        movement.figureType()  = FigureType::knight;
+        movement.destination() = Position(BoardRow::r4, BoardColumn::cC);
+        ASSERT_EQ(ResolveResult::unique, _board.resolve(movement));
+        ASSERT_EQ(Position(BoardRow::r2, BoardColumn::cB), movement.origin());
+
+        // the king blocks the rook on h1
+        movement               = Movement();
+        movement.figureType()  = FigureType::rook;
+        movement.destination() = Position(BoardRow::r1, BoardColumn::cD);
+        ASSERT_EQ(ResolveResult::unique, _board.resolve(movement));
+        ASSERT_EQ(Position(BoardRow::r1, BoardColumn::cA), movement.origin());
+        movement.origin()      = Position();
+        movement.destination() = Position(BoardRow::r1, BoardColumn::cE);
+        ASSERT_EQ(ResolveResult::illegal, _board.resolve(movement));
+
+        // both rooks reach d1 unless the column is given
+        _board.removeFigure(Position(BoardRow::r1, BoardColumn::cE));
+        createFigure(_board.at(BoardRow::r2, BoardColumn::cE), FigureType::king, Color::white);
+        movement               = Movement();
+        movement.figureType()  = FigureType::rook;
+        movement.destination() = Position(BoardRow::r1, BoardColumn::cD);
+        ASSERT_EQ(ResolveResult::ambiguous, _board.resolve(movement));
+        movement.origin().set(-1, static_cast<int>(BoardColumn::cA));
+        ASSERT_EQ(ResolveResult::unique, _board.resolve(movement));
+        ASSERT_EQ(Position(BoardRow::r1, BoardColumn::cA), movement.origin());
+
+        // the king may not step along the line of the rook
+        _board.removeFigure(Position(BoardRow::r3, BoardColumn::cE));
+        movement               = Movement();
+        movement.figureType()  = FigureType::king;
+        movement.destination() = Position(BoardRow::r1, BoardColumn::cE);
+        ASSERT_EQ(ResolveResult::illegal, _board.resolve(movement));
+        movement.destination() = Position(BoardRow::r3, BoardColumn::cD);
+        ASSERT_EQ(ResolveResult::unique, _board.resolve(movement));
+    }
+
+    TEST_F(TestBoard, resolve_pawnsAndCastling_sameAsTheFullMove)
+    {
+        Board board;
+        auto  resolveAndMove = [&board](FigureType type, Position destination, bool castling = false)
+        {
+            Movement movement;
+            movement.figureType()  = type;
+            movement.destination() = destination;
+            movement.color()       = board.getCurrentColorTurn();
+            if (castling)
+                movement.addFlag(EventFlag::castling);
+            if (board.resolve(movement) != ResolveResult::unique)
+                return Position();
+
+            const auto origin = movement.origin();
+            movement.origin() = Position();
+            return board.move(movement).isValid() ? origin : Position();
+        };
+
+        ASSERT_EQ(Position(BoardRow::r2, BoardColumn::cE), resolveAndMove(FigureType::pawn, Position(BoardRow::r4, BoardColumn::cE)));
+        ASSERT_EQ(Position(BoardRow::r7, BoardColumn::cA), resolveAndMove(FigureType::pawn, Position(BoardRow::r6, BoardColumn::cA)));
+        ASSERT_EQ(Position(BoardRow::r4, BoardColumn::cE), resolveAndMove(FigureType::pawn, Position(BoardRow::r5, BoardColumn::cE)));
+        ASSERT_EQ(Position(BoardRow::r7, BoardColumn::cD), resolveAndMove(FigureType::pawn, Position(BoardRow::r5, BoardColumn::cD)));
+
+        // en passant, the captured pawn is not on the destination
+        ASSERT_EQ(Position(BoardRow::r5, BoardColumn::cE), resolveAndMove(FigureType::pawn, Position(BoardRow::r6, BoardColumn::cD)));
+        ASSERT_EQ(FigureType::none, board.at(BoardRow::r5, BoardColumn::cD).figure.getType());
+
+        ASSERT_EQ(Position(BoardRow::r7, BoardColumn::cB), resolveAndMove(FigureType::pawn, Position(BoardRow::r5, BoardColumn::cB)));
+        ASSERT_EQ(Position(BoardRow::r1, BoardColumn::cG), resolveAndMove(FigureType::knight, Position(BoardRow::r3, BoardColumn::cF)));
+        ASSERT_EQ(Position(BoardRow::r6, BoardColumn::cA), resolveAndMove(FigureType::pawn, Position(BoardRow::r5, BoardColumn::cA)));
+        ASSERT_EQ(Position(BoardRow::r1, BoardColumn::cF), resolveAndMove(FigureType::bishop, Position(BoardRow::r2, BoardColumn::cE)));
+        ASSERT_EQ(Position(BoardRow::r5, BoardColumn::cA), resolveAndMove(FigureType::pawn, Position(BoardRow::r4, BoardColumn::cA)));
+        ASSERT_EQ(Position(BoardRow::r1, BoardColumn::cE), resolveAndMove(FigureType::king, Position(BoardRow::r1, BoardColumn::cG), true));
+        ASSERT_EQ(FigureType::rook, board.at(BoardRow::r1, BoardColumn::cF).figure.getType());
+
+        ASSERT_EQ(Position(BoardRow::r7, BoardColumn::cH), resolveAndMove(FigureType::pawn, Position(BoardRow::r5, BoardColumn::cH)));
+
+        // no pawn can capture there and the own pawn blocks the queen
+        ASSERT_EQ(Position(), resolveAndMove(FigureType::pawn, Position(BoardRow::r5, BoardColumn::cH)));
+        ASSERT_EQ(Position(), resolveAndMove(FigureType::queen, Position(BoardRow::r6, BoardColumn::cD)));
+    }
+
+    TEST_F(TestBoard, moveMovement_finalMoves_checkmateAndStalemate)
+    {
+        auto parsed = [](FigureType type, Color color, Position destination)
+        {
+            Movement movement;
+            movement.figureType()  = type;
+            movement.destination() = destination;
+            movement.color()       = color;
+            return movement;
+        };
+
+        // fool's mate
+        Board board;
+        ASSERT_TRUE(board.move(parsed(FigureType::pawn, Color::white, Position(BoardRow::r3, BoardColumn::cF))).isValid());
+        ASSERT_TRUE(board.move(parsed(FigureType::pawn, Color::black, Position(BoardRow::r5, BoardColumn::cE))).isValid());
+        ASSERT_TRUE(board.move(parsed(FigureType::pawn, Color::white, Position(BoardRow::r4, BoardColumn::cG))).isValid());
+        auto result = board.move(parsed(FigureType::queen, Color::black, Position(BoardRow::r4, BoardColumn::cH)));
+        ASSERT_TRUE(result.hasFlag(EventFlag::checkmate));
+        ASSERT_FALSE(result.hasFlag(EventFlag::check));
+        ASSERT_TRUE(board.getAllMadeMoves().back().hasFlag(EventFlag::checkmate));
+        ASSERT_TRUE(board.hasEnded());
+
+        // the queen takes the last field of the king without giving check
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cA), FigureType::king, Color::black);
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cB), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r5, BoardColumn::cC), FigureType::queen, Color::white);
+        result = _board.move(parsed(FigureType::queen, Color::white, Position(BoardRow::r7, BoardColumn::cC)));
+        ASSERT_TRUE(result.isValid());
+        ASSERT_FALSE(result.hasFlag(EventFlag::check));
+        ASSERT_FALSE(result.hasFlag(EventFlag::checkmate));
+        ASSERT_TRUE(_board.hasEnded());
+
+        // a check with an escape does not end the game
+        Board other;
+        ASSERT_TRUE(other.move(parsed(FigureType::pawn, Color::white, Position(BoardRow::r4, BoardColumn::cE))).isValid());
+        ASSERT_TRUE(other.move(parsed(FigureType::pawn, Color::black, Position(BoardRow::r5, BoardColumn::cF))).isValid());
+        result = other.move(parsed(FigureType::queen, Color::white, Position(BoardRow::r5, BoardColumn::cH)));
+        ASSERT_TRUE(result.hasFlag(EventFlag::check));
+        ASSERT_FALSE(other.hasEnded());
+    }
+
+    TEST_F(TestBoard, hasLegalMove_gameAndFinalPositions_sameAsAllMoves)
+    {
+        Board                 board;
+        std::vector<uint16_t> legal;
+        for (unsigned ply = 0; ply < 80; ply++)
+        {
+            auto moves = board.getAllPossibleMoves(board.getCurrentColorTurn());
+            ASSERT_EQ(!moves.empty(), board.hasLegalMove());
+
+            // the same moves without making them
+            board.getLegalMoves(legal);
+            ASSERT_EQ(moves.size(), legal.size());
+            for (auto& move : moves)
+            {
+                const auto packed = BitboardHelper::square(move.origin()) | BitboardHelper::square(move.destination()) << 6;
+                ASSERT_NE(legal.end(), std::find(legal.begin(), legal.end(), packed));
+            }
+            if (moves.empty())
+                break;
+
+            auto& move = moves[(ply * 7) % moves.size()];
+            ASSERT_TRUE(board.makeMove(move.origin(), move.destination()).isValid());
+        }
+
+        // stalemate of the black king in the corner
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cH), FigureType::king, Color::black);
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cG), FigureType::queen, Color::white);
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cA), FigureType::king, Color::white);
+        _board.makeMove(Position(BoardRow::r1, BoardColumn::cA), Position(BoardRow::r1, BoardColumn::cB));
+        ASSERT_FALSE(_board.hasLegalMove());
+
+        _board.unmakeMove();
+        _board.removeFigure(Position(BoardRow::r6, BoardColumn::cG));
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cF), FigureType::queen, Color::white);
+        _board.makeMove(Position(BoardRow::r1, BoardColumn::cA), Position(BoardRow::r1, BoardColumn::cB));
+        ASSERT_TRUE(_board.hasLegalMove());
+    }
 }
@@ -0,0 +1,70 @@
+/*!
+* \brief:  Implements the test eval params class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "gtest/gtest.h"
+#include <sstream>
+#include "ChessEngine/Board.h"
+
+namespace ChessNS
+{
+    TEST(TestEvalParams, saveLoad_defaults_sameValues)
+    {
+        const auto&       defaults = *EvalParams::defaults();
+        std::stringstream stream;
+        defaults.save(stream);
+
+        EvalParams loaded;
+        ASSERT_TRUE(loaded.load(stream));
+
+        for (size_t type = 0; type < 7; type++)
+        {
+            ASSERT_EQ(defaults.phase[type], loaded.phase[type]);
+            for (size_t phase = 0; phase < 2; phase++)
+            {
+                ASSERT_EQ(defaults.material[phase][type], loaded.material[phase][type]);
+                for (size_t square = 0; square < 64; square++)
+                    ASSERT_EQ(defaults.pst[phase][type][square], loaded.pst[phase][type][square]);
+            }
+        }
+    }
+
+    TEST(TestEvalParams, load_partialAndMalformed_onlyGivenEntriesChanged)
+    {
+        EvalParams        params = *EvalParams::defaults();
+        std::stringstream partial("# a tuned knight\nmaterial.middlegame knight 310 # was 320\nphase knight 2\n");
+
+        ASSERT_TRUE(params.load(partial));
+        ASSERT_EQ(310, params.material[0][static_cast<size_t>(FigureType::knight)]);
+        ASSERT_EQ(2, params.phase[static_cast<size_t>(FigureType::knight)]);
+        ASSERT_EQ(330, params.material[0][static_cast<size_t>(FigureType::bishop)]);
+
+        std::stringstream unknown("material.middlegame dragon 1000");
+        ASSERT_FALSE(params.load(unknown));
+
+        std::stringstream incomplete("pst.endgame pawn 1 2 3");
+        ASSERT_FALSE(params.load(incomplete));
+    }
+}
@@ -0,0 +1,133 @@
+/*!
+* \brief:  Implements the test nnue class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "gtest/gtest.h"
+#include <random>
+#include <sstream>
+#include "ChessEngine/Board.h"
+
+namespace ChessNS
+{
+    static std::shared_ptr<Nnue> randomNetwork()
+    {
+        auto         network = std::make_shared<Nnue>(32);
+        std::mt19937 random(42);
+
+        auto fill = [&random](auto& values, int low, int high)
+        {
+            std::uniform_int_distribution<int> distribution(low, high);
+            for (auto& value : values)
+                value = static_cast<typename std::decay<decltype(value)>::type>(distribution(random));
+        };
+
+        fill(network->featureWeights, -16, 16);
+        fill(network->featureBiases, 0, 64);
+        fill(network->hiddenWeights, -64, 64);
+        fill(network->hiddenBiases, -2000, 2000);
+        fill(network->outputWeights, -128, 128);
+        network->outputBias = 500;
+        return network;
+    }
+
+    static void makeMoves(Board& board, const std::vector<std::pair<const char*, const char*>>& moves)
+    {
+        for (auto&& move : moves)
+        {
+            const Position origin(move.first[1] - '1', move.first[0] - 'a');
+            const Position destination(move.second[1] - '1', move.second[0] - 'a');
+            ASSERT_NE(MoveResult::invalid, board.makeMove(origin, destination).moveResult());
+        }
+    }
+
+    TEST(TestNnue, evaluateNetwork_movesCastlingAndCaptures_incrementalEqualsRefreshed)
+    {
+        Board board;
+        board.setNetwork(randomNetwork());
+        const auto start = board.evaluateNetwork();
+
+        makeMoves(board, {{"e2", "e4"}, {"e7", "e5"}, {"g1", "f3"}, {"b8", "c6"}, {"f1", "c4"}, {"f8", "c5"},
+                          {"e1", "g1"}, {"c5", "f2"}, {"g1", "f2"}, {"g8", "f6"}, {"f3", "e5"}});
+
+        const auto score = board.evaluateNetwork();
+        auto       copy  = board;
+        copy.setNetwork(board.getNetwork());
+        ASSERT_EQ(copy.evaluateNetwork(), score);
+
+        for (size_t i = 0; i < 11; i++)
+            board.unmakeMove();
+        ASSERT_EQ(start, board.evaluateNetwork());
+    }
+
+    TEST(TestNnue, constructor_invalidSizes_roundedAndLimited)
+    {
+        ASSERT_EQ(16u, Nnue(0).accumulatorSize());
+        ASSERT_EQ(48u, Nnue(40).accumulatorSize());
+        const size_t maxSize = Nnue::maxAccumulatorSize;
+        ASSERT_EQ(maxSize, Nnue(maxSize + 1).accumulatorSize());
+
+        Nnue network(40);
+        ASSERT_EQ(Nnue::featureCount * 48, network.featureWeights.size());
+        ASSERT_EQ(48u, network.featureBiases.size());
+    }
+
+    TEST(TestNnue, evaluate_allKernels_sameScore)
+    {
+        auto  network = randomNetwork();
+        Board board;
+        board.setNetwork(network);
+        makeMoves(board, {{"d2", "d4"}, {"g8", "f6"}, {"c2", "c4"}});
+
+        network->setKernel(Nnue::Kernel::scalar);
+        ASSERT_EQ(Nnue::Kernel::scalar, network->kernel());
+        const auto expected = board.evaluateNetwork();
+
+        for (auto kernel : {Nnue::Kernel::sse41, Nnue::Kernel::avx2, Nnue::detectKernel()})
+        {
+            network->setKernel(kernel);
+            ASSERT_EQ(expected, board.evaluateNetwork());
+        }
+    }
+
+    TEST(TestNnue, saveLoad_randomNetwork_sameWeightsAndInvalidRejected)
+    {
+        const auto        network = randomNetwork();
+        std::stringstream stream;
+        network->save(stream);
+
+        Nnue loaded(16);
+        ASSERT_TRUE(loaded.load(stream));
+        ASSERT_EQ(network->accumulatorSize(), loaded.accumulatorSize());
+        ASSERT_EQ(network->featureWeights, loaded.featureWeights);
+        ASSERT_EQ(network->hiddenWeights, loaded.hiddenWeights);
+        ASSERT_EQ(network->outputBias, loaded.outputBias);
+
+        std::stringstream truncated(stream.str().substr(0, 1000));
+        ASSERT_FALSE(loaded.load(truncated));
+        std::stringstream wrong("XXXX");
+        ASSERT_FALSE(loaded.load(wrong));
+        ASSERT_EQ(network->accumulatorSize(), loaded.accumulatorSize());
+    }
+}
@@ -0,0 +1,201 @@
+/*!
+* \brief:  Implements the test book builder class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include "ChessParser/PgnParser.h"
+#include "ChessPlayer/BookBuilder.h"
+#include "ChessPlayer/OpeningBook.h"
+
+namespace ChessNS
+{
+    TEST(TestBookBuilder, resolve_ambiguousKnights_originByColumn)
+    {
+        PgnParser         parser;
+        std::stringstream stream("1. Nf3 d5 2. Nc3 e5 3. Nb5 e4 4. Nbd4 1-0\n");
+        auto              game = parser.parseSingleGame(stream);
+        ASSERT_EQ(7, game.movements.size());
+
+        Board board;
+        for (size_t i = 0; i < 6; i++)
+        {
+            auto move = BookBuilder::resolve(board, game.movements[i]);
+            ASSERT_TRUE(move.isValid());
+            board.makeMove(move.origin(), move.destination());
+        }
+
+        auto move = BookBuilder::resolve(board, game.movements[6]);
+        ASSERT_TRUE(move.isValid());
+        ASSERT_EQ(Position(BoardRow::r5, BoardColumn::cB), move.origin());
+    }
+
+    TEST(TestBookBuilder, finish_threeGames_sortedBookWithWeights)
+    {
+        std::stringstream stream("1. e4 e5 2. Nf3 1-0\n\n1. e4 c5 1/2-1/2\n\n1. d4 d5 0-1\n\n1. e4 e5 2. Nf3 Nc6 1-0\n");
+        PgnParser         parser;
+        auto              games = parser.parseMultipleGames(stream);
+        ASSERT_EQ(4, games.size());
+
+        const std::string filename = "TestBookBuilder.bin";
+        BookBuildConfig   config;
+        config.threads = 2;
+        config.plies   = 3;
+        {
+            BookBuilder builder(filename, config);
+            builder.add(std::vector<Game>(games.begin(), games.begin() + 2));
+            builder.add(std::vector<Game>(games.begin() + 2, games.end()));
+            ASSERT_TRUE(builder.finish());
+            ASSERT_EQ(4, builder.games());
+        }
+
+        auto book = OpeningBook::open(filename);
+        ASSERT_NE(nullptr, book);
+
+        // e4 won twice and drew once, d4 lost
+        Board board;
+        auto  entries = book->find(Polyglot::key(board));
+        ASSERT_EQ(2, entries.size());
+        ASSERT_EQ(Polyglot::encode(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE), FigureType::pawn, FigureType::none), entries[0].move);
+        ASSERT_EQ(5, entries[0].weight);
+        ASSERT_EQ(0, entries[1].weight);
+
+        board.makeMove(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE));
+        entries = book->find(Polyglot::key(board));
+        ASSERT_EQ(2, entries.size());
+        ASSERT_EQ(1, entries[0].weight);
+
+        // the third ply is the last one
+        board.makeMove(Position(BoardRow::r7, BoardColumn::cE), Position(BoardRow::r5, BoardColumn::cE));
+        ASSERT_EQ(1, book->find(Polyglot::key(board)).size());
+        board.makeMove(Position(BoardRow::r1, BoardColumn::cG), Position(BoardRow::r3, BoardColumn::cF));
+        ASSERT_TRUE(book->find(Polyglot::key(board)).empty());
+
+        uint64_t previous = 0;
+        for (size_t i = 0; i < book->size(); i++)
+        {
+            std::ifstream in(filename, std::ios::binary);
+            in.seekg(static_cast<std::streamoff>(i * Polyglot::entrySize));
+            unsigned char data[Polyglot::entrySize];
+            in.read(reinterpret_cast<char*>(data), sizeof(data));
+            const auto key = Polyglot::read(data).key;
+            ASSERT_LE(previous, key);
+            previous = key;
+        }
+
+        book.reset();
+        std::remove(filename.c_str());
+        std::ifstream runs(filename + ".runs");
+        ASSERT_FALSE(runs.good());
+    }
+
+    TEST(TestBookBuilder, finish_moreRecordsThanMemory_runsMerged)
+    {
+        std::string text;
+        for (int i = 0; i < 300; i++)
+            text += "1. e4 e5 2. Nf3 Nc6 1-0\n\n1. d4 d5 2. c4 e6 1/2-1/2\n\n";
+        std::stringstream stream(text);
+        PgnParser         parser;
+        auto              games = parser.parseMultipleGames(stream);
+        ASSERT_EQ(600, games.size());
+
+        // without memory a run holds 1024 records, so the 2400 records of the games are written in three runs
+        const std::string filename = "TestBookBuilderRuns.bin";
+        BookBuildConfig   config;
+        config.threads = 1;
+        config.plies   = 4;
+        config.memory  = 0;
+        {
+            BookBuilder builder(filename, config);
+            for (size_t i = 0; i < games.size(); i += 100)
+                builder.add(std::vector<Game>(games.begin() + i, games.begin() + i + 100));
+            ASSERT_TRUE(builder.finish());
+            ASSERT_EQ(8, builder.entries());
+        }
+
+        auto book = OpeningBook::open(filename);
+        ASSERT_NE(nullptr, book);
+
+        Board board;
+        auto  entries = book->find(Polyglot::key(board));
+        ASSERT_EQ(2, entries.size());
+        ASSERT_EQ(600, entries[0].weight);
+        ASSERT_EQ(300, entries[1].weight);
+
+        board.makeMove(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE));
+        entries = book->find(Polyglot::key(board));
+        ASSERT_EQ(1, entries.size());
+        ASSERT_EQ(0, entries[0].weight);
+
+        book.reset();
+        std::remove(filename.c_str());
+        std::ifstream runs(filename + ".runs");
+        ASSERT_FALSE(runs.good());
+    }
+
+    TEST(TestBookBuilder, finish_specificationGame_standardKeysAndMoves)
+    {
+        std::stringstream stream("1. e4 d5 2. e5 f5 3. Ke2 Kf7 1-0\n");
+        PgnParser         parser;
+        auto              games = parser.parseMultipleGames(stream);
+        ASSERT_EQ(1, games.size());
+
+        const std::string filename = "TestBookBuilderKeys.bin";
+        BookBuildConfig   config;
+        config.plies = 6;
+        {
+            BookBuilder builder(filename, config);
+            builder.add(std::move(games));
+            ASSERT_TRUE(builder.finish());
+        }
+
+        // the keys of the Polyglot specification for the positions before each move, read without this code
+        std::map<uint64_t, uint16_t> expected = {
+            {0x463b96181691fc9cull, 0x031C}, // e2e4
+            {0x823c9b50fd114196ull, 0x0CE3}, // d7d5
+            {0x0756b94461c50fb0ull, 0x0724}, // e4e5
+            {0x662fafb965db29d4ull, 0x0D65}, // f7f5
+            {0x22a48b5a8e47ff78ull, 0x010C}, // e1e2
+            {0x652a607ca3f242c1ull, 0x0F35}}; // e8f7
+
+        std::ifstream in(filename, std::ios::binary);
+        unsigned char data[Polyglot::entrySize];
+        size_t        count = 0;
+        while (in.read(reinterpret_cast<char*>(data), sizeof(data)))
+        {
+            const auto entry = Polyglot::read(data);
+            ASSERT_EQ(1, expected.count(entry.key));
+            ASSERT_EQ(expected[entry.key], entry.move);
+            count++;
+        }
+        ASSERT_EQ(expected.size(), count);
+
+        in.close();
+        std::remove(filename.c_str());
+    }
+}
@@ -0,0 +1,122 @@
+/*!
+* \brief:  Implements the test mcts class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "gtest/gtest.h"
+#include "ChessPlayer/Mcts.h"
+#include "ChessPlayer/PlayerMctsAi.h"
+
+namespace ChessNS
+{
+    class TestMcts : public ::testing::Test
+    {
+    protected:
+        TestMcts() = default;
+
+        virtual ~TestMcts() = default;
+
+        void createFigure(Field& field, FigureType figureType, Color color)
+        {
+            _board.createFigure(field, figureType, color);
+        }
+
+        Board _board{Board::BoardStartType::empty};
+    };
+
+    TEST_F(TestMcts, run_mateInOne_mateFoundAndBoardUnchanged)
+    {
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cB), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r2, BoardColumn::cH), FigureType::queen, Color::white);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cA), FigureType::king, Color::black);
+        const auto hash = _board.getHash();
+
+        MctsConfig config;
+        config.threads  = 2;
+        config.playouts = 3000;
+        auto result     = Mcts(config).run(_board);
+
+        ASSERT_TRUE(result.bestMove.isValid());
+        ASSERT_EQ(Position(BoardRow::r2, BoardColumn::cH), result.bestMove.origin());
+        ASSERT_EQ(Position(BoardRow::r8, BoardColumn::cH), result.bestMove.destination());
+        ASSERT_FLOAT_EQ(1.f, result.score);
+        ASSERT_GE(result.playouts, config.playouts);
+        ASSERT_GT(result.playoutsPerSecond, 0u);
+        ASSERT_EQ(hash, _board.getHash());
+    }
+
+    TEST_F(TestMcts, run_fullArena_searchStillAnswers)
+    {
+        auto board = Board();
+
+        MctsConfig config;
+        config.threads      = 2;
+        config.playouts     = 200;
+        config.playoutPlies = 10;
+        config.nodes        = 30;
+        auto result         = Mcts(config).run(board);
+
+        ASSERT_TRUE(result.bestMove.isValid());
+        ASSERT_LE(result.nodes, config.nodes);
+        ASSERT_GE(result.playouts, config.playouts);
+    }
+
+    TEST_F(TestMcts, run_seededSingleThread_reproducible)
+    {
+        auto board = Board();
+
+        MctsConfig config;
+        config.threads      = 1;
+        config.playouts     = 300;
+        config.playoutPlies = 10;
+        config.seeded       = true;
+        config.seed         = 7;
+
+        auto first  = Mcts(config).run(board);
+        auto second = Mcts(config).run(board);
+        ASSERT_EQ(first.bestMove.origin(), second.bestMove.origin());
+        ASSERT_EQ(first.bestMove.destination(), second.bestMove.destination());
+        ASSERT_EQ(first.visits, second.visits);
+        ASSERT_FLOAT_EQ(first.score, second.score);
+        ASSERT_EQ(first.nodes, second.nodes);
+    }
+
+    TEST_F(TestMcts, createPlayer_mctsAi_playsAMove)
+    {
+        auto board  = std::make_shared<Board>();
+        auto player = IPlayer::createPlayer(PlayerType::mctsAi, Color::white, board);
+        ASSERT_EQ(PlayerType::mctsAi, player->getPlayerType());
+
+        auto mcts                       = static_cast<PlayerMctsAi*>(player.get());
+        mcts->mctsConfig().threads      = 1;
+        mcts->mctsConfig().playouts     = 100;
+        mcts->mctsConfig().playoutPlies = 10;
+
+        auto movement = player->move(Movement::invalid());
+        ASSERT_TRUE(movement.isValid());
+        ASSERT_EQ(Color::black, board->getCurrentColorTurn());
+        ASSERT_EQ(100u, mcts->lastResult().playouts);
+    }
+}
@@ -0,0 +1,164 @@
+/*!
+* \brief:  Implements the test opening book class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include "ChessPlayer/OpeningBook.h"
+
+namespace ChessNS
+{
+    static Position square(const char* name)
+    {
+        return Position(name[1] - '1', name[0] - 'a');
+    }
+
+    TEST(TestOpeningBook, encodeDecode_castlingAndPromotion_roundtrip)
+    {
+        Board board;
+        for (auto&& move : {"e2e4", "e7e5", "g1f3", "b8c6", "f1c4", "f8c5"})
+            ASSERT_EQ(MoveResult::valid, board.makeMove(square(move), square(move + 2)).moveResult());
+
+        // castling is stored as e1h1
+        const auto castling = Polyglot::encode(square("e1"), square("g1"), FigureType::king, FigureType::none);
+        ASSERT_EQ(0x0107, castling);
+
+        auto movement = Polyglot::decode(board, castling);
+        ASSERT_TRUE(movement.isValid());
+        ASSERT_EQ(square("g1"), movement.destination());
+
+        ASSERT_EQ(0x4000 | 0x0DBF, Polyglot::encode(square("g7"), square("h8"), FigureType::pawn, FigureType::queen));
+        ASSERT_FALSE(Polyglot::decode(board, Polyglot::encode(square("e1"), square("d1"), FigureType::king, FigureType::none)).isValid());
+        ASSERT_FALSE(Polyglot::decode(board, Polyglot::encode(square("c6"), square("d4"), FigureType::knight, FigureType::none)).isValid());
+    }
+
+    TEST(TestOpeningBook, key_specificationPositions_standardKeys)
+    {
+        // the keys of the Polyglot book format specification
+        const std::vector<std::pair<std::vector<const char*>, uint64_t>> positions = {
+            {{}, 0x463b96181691fc9cull},
+            {{"e2e4"}, 0x823c9b50fd114196ull},
+            {{"e2e4", "d7d5"}, 0x0756b94461c50fb0ull},
+            {{"e2e4", "d7d5", "e4e5"}, 0x662fafb965db29d4ull},
+            {{"e2e4", "d7d5", "e4e5", "f7f5"}, 0x22a48b5a8e47ff78ull},
+            {{"e2e4", "d7d5", "e4e5", "f7f5", "e1e2"}, 0x652a607ca3f242c1ull},
+            {{"e2e4", "d7d5", "e4e5", "f7f5", "e1e2", "e8f7"}, 0x00fdd303c946bdd9ull},
+            {{"a2a4", "b7b5", "h2h4", "b5b4", "c2c4"}, 0x3c8123ea7b067637ull},
+            {{"a2a4", "b7b5", "h2h4", "b5b4", "c2c4", "b4c3", "a1a3"}, 0x5c3f9b829b279560ull}};
+
+        for (auto&& position : positions)
+        {
+            Board board;
+            for (auto&& move : position.first)
+                ASSERT_EQ(MoveResult::valid, board.makeMove(square(move), square(move + 2)).moveResult());
+            ASSERT_EQ(position.second, Polyglot::key(board));
+        }
+    }
+
+    TEST(TestOpeningBook, key_enPassant_onlyWithCapturingPawn)
+    {
+        // two null moves keep the position but lose the en passant capture
+        auto withoutEnPassant = [](Board& board)
+        {
+            board.makeNullMove();
+            board.makeNullMove();
+            const auto key = Polyglot::key(board);
+            board.unmakeMove();
+            board.unmakeMove();
+            return key;
+        };
+
+        Board board;
+        for (auto&& move : {"e2e4", "a7a6", "e4e5", "d7d5"})
+            ASSERT_EQ(MoveResult::valid, board.makeMove(square(move), square(move + 2)).moveResult());
+        ASSERT_NE(withoutEnPassant(board), Polyglot::key(board));
+
+        Board other;
+        for (auto&& move : {"e2e4", "d7d5"})
+            ASSERT_EQ(MoveResult::valid, other.makeMove(square(move), square(move + 2)).moveResult());
+        ASSERT_EQ(withoutEnPassant(other), Polyglot::key(other));
+
+        Board transposed;
+        for (auto&& move : {"e2e3", "d7d6", "e3e4", "d6d5"})
+            ASSERT_EQ(MoveResult::valid, transposed.makeMove(square(move), square(move + 2)).moveResult());
+        ASSERT_EQ(Polyglot::key(other), Polyglot::key(transposed));
+    }
+
+    TEST(TestOpeningBook, probe_sortedBook_weightedMovesOfPosition)
+    {
+        Board      board;
+        const auto key = Polyglot::key(board);
+
+        std::vector<PolyglotEntry> entries = {
+            {key - 1, Polyglot::encode(square("a2"), square("a3"), FigureType::pawn, FigureType::none), 100, 0},
+            {key, Polyglot::encode(square("e2"), square("e4"), FigureType::pawn, FigureType::none), 3, 0},
+            {key, Polyglot::encode(square("d2"), square("d4"), FigureType::pawn, FigureType::none), 1, 0},
+            {key, Polyglot::encode(square("e2"), square("e5"), FigureType::pawn, FigureType::none), 50, 0},
+            {key, Polyglot::encode(square("h2"), square("h3"), FigureType::pawn, FigureType::none), 0, 0},
+            {key + 1, Polyglot::encode(square("b2"), square("b3"), FigureType::pawn, FigureType::none), 100, 0}};
+
+        const std::string filename = "TestOpeningBook.bin";
+        {
+            std::ofstream out(filename, std::ios::binary);
+            for (auto&& entry : entries)
+            {
+                unsigned char data[Polyglot::entrySize];
+                Polyglot::write(entry, data);
+                out.write(reinterpret_cast<const char*>(data), sizeof(data));
+            }
+        }
+
+        auto book = OpeningBook::open(filename);
+        ASSERT_NE(nullptr, book);
+        ASSERT_EQ(book, OpeningBook::open(filename));
+        ASSERT_EQ(6, book->size());
+        ASSERT_EQ(4, book->find(key).size());
+        ASSERT_TRUE(book->find(key + 2).empty());
+
+        std::mt19937 random(1);
+        int          e4 = 0;
+        int          d4 = 0;
+        for (int i = 0; i < 400; i++)
+        {
+            auto movement = book->probe(board, random);
+            ASSERT_TRUE(movement.isValid());
+            if (movement.destination() == square("e4"))
+                e4++;
+            else if (movement.destination() == square("d4"))
+                d4++;
+        }
+
+        ASSERT_EQ(400, e4 + d4);
+        ASSERT_GT(e4, 2 * d4);
+        ASSERT_GT(d4, 0);
+
+        board.makeMove(square("g2"), square("g3"));
+        ASSERT_FALSE(book->probe(board, random).isValid());
+
+        book.reset();
+        std::remove(filename.c_str());
+    }
+}
@@ -0,0 +1,548 @@
+/*!
+* \brief:  Implements the test search class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include "ChessPlayer/MateSolver.h"
+#include "ChessPlayer/MovePicker.h"
+#include "ChessPlayer/OpeningBook.h"
+#include "ChessPlayer/PawnHashTable.h"
+#include "ChessPlayer/PlayerSearchAi.h"
+#include "ChessPlayer/Polyglot.h"
+#include "ChessPlayer/Search.h"
+
+namespace ChessNS
+{
+    class TestSearch : public ::testing::Test
+    {
+    protected:
+        TestSearch() = default;
+
+        virtual ~TestSearch() = default;
+
+        void createFigure(Field& field, FigureType figureType, Color color)
+        {
+            _board.createFigure(field, figureType, color);
+        }
+
+        static void createFigure(Board& board, Field& field, FigureType figureType, Color color)
+        {
+            board.createFigure(field, figureType, color);
+        }
+
+        Board _board{Board::BoardStartType::empty};
+    };
+
+    TEST_F(TestSearch, run_defendedPawnWithQuiescence_noCapture)
+    {
+        const Position queenPos(BoardRow::r1, BoardColumn::cD);
+        const Position pawnPos(BoardRow::r5, BoardColumn::cD);
+
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cG), FigureType::king, Color::white);
+        createFigure(_board.at(queenPos), FigureType::queen, Color::white);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cG), FigureType::king, Color::black);
+        createFigure(_board.at(pawnPos), FigureType::pawn, Color::black);
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cE), FigureType::pawn, Color::black);
+
+        // only the material, so the score is known exactly
+        auto params = std::make_shared<EvalParams>();
+        for (size_t type = 1; type < 7; type++)
+            for (size_t phase = 0; phase < 2; phase++)
+                params->material[phase][type] = ChessTypes::getFigureValue(static_cast<FigureType>(type));
+        params->material[0][static_cast<size_t>(FigureType::king)] = 0;
+        params->material[1][static_cast<size_t>(FigureType::king)] = 0;
+        _board.setEvalParams(params);
+
+        SearchConfig config;
+        config.depth = 1;
+
+        config.quiescence = false;
+        auto result       = Search(config).run(_board);
+        ASSERT_EQ(pawnPos, result.bestMove.destination());
+
+        config.quiescence = true;
+        result            = Search(config).run(_board);
+        ASSERT_TRUE(result.bestMove.isValid());
+        ASSERT_NE(pawnPos, result.bestMove.destination());
+        ASSERT_EQ(700, result.score);
+    }
+
+    TEST_F(TestSearch, run_mateInOne_mateFound)
+    {
+        const Position rookPos(BoardRow::r1, BoardColumn::cA);
+        const Position mateDes(BoardRow::r8, BoardColumn::cA);
+
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cG), FigureType::king, Color::white);
+        createFigure(_board.at(rookPos), FigureType::rook, Color::white);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cG), FigureType::king, Color::black);
+        createFigure(_board.at(BoardRow::r7, BoardColumn::cF), FigureType::pawn, Color::black);
+        createFigure(_board.at(BoardRow::r7, BoardColumn::cG), FigureType::pawn, Color::black);
+        createFigure(_board.at(BoardRow::r7, BoardColumn::cH), FigureType::pawn, Color::black);
+
+        SearchConfig config;
+        config.depth = 2;
+
+        auto result = Search(config).run(_board);
+        ASSERT_EQ(rookPos, result.bestMove.origin());
+        ASSERT_EQ(mateDes, result.bestMove.destination());
+        ASSERT_EQ(Search::mateScore - 1, result.score);
+        ASSERT_TRUE(_board.getAllMadeMoves().empty());
+    }
+
+    TEST_F(TestSearch, mateSolver_rookLadder_shortestMateWithQuietMove)
+    {
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cE), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r1, BoardColumn::cA), FigureType::rook, Color::white);
+        createFigure(_board.at(BoardRow::r2, BoardColumn::cB), FigureType::rook, Color::white);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cH), FigureType::king, Color::black);
+
+        MateConfig config;
+        auto       result = MateSolver(config).solve(_board);
+        ASSERT_TRUE(result.found);
+        ASSERT_EQ(2, result.moves);
+        ASSERT_EQ(3, result.line.size());
+        ASSERT_FALSE(result.line[0].hasFlag(EventFlag::check));
+        ASSERT_TRUE(_board.getAllMadeMoves().empty());
+
+        // the line ends with the mate
+        auto board = _board;
+        for (auto& movement : result.line)
+            ASSERT_TRUE(board.makeMove(movement.origin(), movement.destination()).isValid());
+        ASSERT_TRUE(board.isCheck(Color::black));
+        ASSERT_TRUE(board.getAllPossibleMoves(Color::black).empty());
+
+        // the mate needs the quiet move
+        config.checksOnly = true;
+        ASSERT_FALSE(MateSolver(config).solve(_board).found);
+
+        // a mate in one and the same ladder again, solved side by side
+        auto mateInOne = _board;
+        ASSERT_TRUE(mateInOne.makeMove(result.line[0].origin(), result.line[0].destination()).isValid());
+        ASSERT_TRUE(mateInOne.makeMove(result.line[1].origin(), result.line[1].destination()).isValid());
+
+        std::vector<Board> boards{_board, mateInOne, _board};
+        config.checksOnly = false;
+        config.threads    = 2;
+        const auto all    = MateSolver::solveAll(boards, config);
+        ASSERT_EQ(3, all.size());
+        ASSERT_EQ(2, all[0].moves);
+        ASSERT_EQ(1, all[1].moves);
+        ASSERT_EQ(1, all[1].line.size());
+        ASSERT_EQ(2, all[2].moves);
+        ASSERT_EQ(2, boards[1].getAllMadeMoves().size());
+    }
+
+    TEST(TestSearchSelectivity, run_pruningAndReductions_fewerNodesAndBoardUnchanged)
+    {
+        Board board;
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE)).moveResult());
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r7, BoardColumn::cE), Position(BoardRow::r5, BoardColumn::cE)).moveResult());
+
+        SearchConfig config;
+        config.depth = 4;
+
+        auto selective = Search(config).run(board);
+
+        config.nullMove           = false;
+        config.lateMoveReductions = false;
+        config.futilityPruning    = false;
+        config.razoring           = false;
+
+        const auto plain = Search(config).run(board);
+
+        ASSERT_TRUE(selective.bestMove.isValid());
+        ASSERT_LT(selective.nodes, plain.nodes);
+        ASSERT_EQ(2, board.getAllMadeMoves().size());
+        ASSERT_EQ(Color::white, board.getCurrentColorTurn());
+    }
+
+    TEST(TestSearchMultiPv, run_threeLines_sortedDistinctAndStreamed)
+    {
+        Board board;
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE)).moveResult());
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r7, BoardColumn::cE), Position(BoardRow::r5, BoardColumn::cE)).moveResult());
+
+        SearchConfig config;
+        config.depth = 4;
+
+        const auto single = Search(config).run(board);
+        ASSERT_EQ(1, single.lines.size());
+        ASSERT_EQ(single.score, single.lines[0].score);
+
+        std::vector<unsigned> streamed;
+        config.multiPv  = 3;
+        config.progress = [&streamed](const SearchResult& progress)
+        {
+            ASSERT_EQ(3, progress.lines.size());
+            streamed.push_back(progress.depth);
+        };
+
+        auto multi = Search(config).run(board);
+        ASSERT_EQ((std::vector<unsigned>{1, 2, 3, 4}), streamed);
+        ASSERT_EQ(3, multi.lines.size());
+        ASSERT_EQ(MoveHistory::pack(multi.bestMove), MoveHistory::pack(multi.lines[0].moves.front()));
+        ASSERT_EQ(multi.score, multi.lines[0].score);
+        ASSERT_GT(multi.lines[0].moves.size(), 1);
+
+        for (size_t i = 0; i < multi.lines.size(); i++)
+        {
+            ASSERT_EQ(4, multi.lines[i].depth);
+            for (size_t j = 0; j < i; j++)
+            {
+                ASSERT_GE(multi.lines[j].score, multi.lines[i].score);
+                ASSERT_NE(MoveHistory::pack(multi.lines[j].moves[0]), MoveHistory::pack(multi.lines[i].moves[0]));
+            }
+        }
+
+        // the other moves are still cut off by the worst line
+        ASSERT_LT(multi.nodes, 3 * single.nodes);
+        ASSERT_EQ(2, board.getAllMadeMoves().size());
+    }
+
+    TEST(TestPlayerSearchAi, move_pondering_hitAnswersAndMissSearchesAgain)
+    {
+        auto board    = std::make_shared<Board>();
+        auto player   = IPlayer::createPlayer(PlayerType::searchAi, Color::black, board);
+        auto computer = static_cast<PlayerSearchAi*>(player.get());
+        computer->searchConfig().depth = 3;
+        computer->setPondering(true);
+
+        ASSERT_EQ(MoveResult::valid, board->move(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE)).moveResult());
+        ASSERT_TRUE(computer->move(Movement::invalid()).isValid());
+
+        // the expected reply is played, the pondering search answers
+        auto expected = computer->ponderMove();
+        ASSERT_TRUE(expected.isValid());
+        ASSERT_EQ(MoveResult::valid, board->move(expected.origin(), expected.destination()).moveResult());
+        ASSERT_TRUE(computer->move(Movement::invalid()).isValid());
+        ASSERT_EQ(1, computer->ponderHits());
+        ASSERT_EQ(3, computer->lastResult().depth);
+
+        // another reply stops the pondering search
+        expected = computer->ponderMove();
+        ASSERT_TRUE(expected.isValid());
+        for (auto& movement : board->getAllPossibleMoves(Color::white))
+        {
+            if (MoveHistory::pack(movement) == MoveHistory::pack(expected))
+                continue;
+
+            ASSERT_EQ(MoveResult::valid, board->move(movement.origin(), movement.destination()).moveResult());
+            break;
+        }
+        ASSERT_TRUE(computer->move(Movement::invalid()).isValid());
+        ASSERT_EQ(1, computer->ponderHits());
+        ASSERT_EQ(3, computer->lastResult().depth);
+        ASSERT_EQ(Color::white, board->getCurrentColorTurn());
+
+        computer->setPondering(false);
+        ASSERT_FALSE(computer->ponderMove().isValid());
+    }
+
+    TEST(TestPlayerSearchAi, move_ponderHitWithBookMove_bookMoveWithoutPonderResult)
+    {
+        auto board    = std::make_shared<Board>();
+        auto player   = IPlayer::createPlayer(PlayerType::searchAi, Color::black, board);
+        auto computer = static_cast<PlayerSearchAi*>(player.get());
+        computer->searchConfig().depth = 3;
+        computer->setPondering(true);
+
+        ASSERT_EQ(MoveResult::valid, board->move(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE)).moveResult());
+        ASSERT_TRUE(computer->move(Movement::invalid()).isValid());
+
+        // the book knows a reply to the expected move
+        auto expected = computer->ponderMove();
+        ASSERT_TRUE(expected.isValid());
+        auto after = *board;
+        ASSERT_TRUE(after.makeMove(expected.origin(), expected.destination(), expected.promotedTo()).isValid());
+        auto reply = after.getAllPossibleMoves(Color::black).back();
+
+        const std::string filename = "TestPlayerSearchAi.bin";
+        {
+            PolyglotEntry entry{Polyglot::key(after),
+                                Polyglot::encode(reply.origin(), reply.destination(), after.at(reply.origin()).figure.getType(), FigureType::none), 1, 0};
+            unsigned char data[Polyglot::entrySize];
+            Polyglot::write(entry, data);
+            std::ofstream out(filename, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(data), sizeof(data));
+        }
+        computer->setOpeningBook(OpeningBook::open(filename));
+
+        // the book move is played instead of the result of the pondering search
+        ASSERT_EQ(MoveResult::valid, board->move(expected.origin(), expected.destination()).moveResult());
+        auto played = computer->move(Movement::invalid());
+        ASSERT_EQ(reply.origin(), played.origin());
+        ASSERT_EQ(reply.destination(), played.destination());
+        ASSERT_EQ(0, computer->ponderHits());
+        ASSERT_TRUE(computer->lastResult().lines.empty());
+        ASSERT_FALSE(computer->ponderMove().isValid());
+
+        computer->setOpeningBook(nullptr);
+        std::remove(filename.c_str());
+    }
+
+    TEST(TestSearchLimits, run_nodeLimitAndSeed_reproducible)
+    {
+        Board board;
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r2, BoardColumn::cD), Position(BoardRow::r4, BoardColumn::cD)).moveResult());
+
+        SearchConfig config;
+        config.depth = 5;
+        config.nodes = 3000;
+
+        // the limit cuts the search after the first iteration, at the same node every time
+        auto first  = Search(config).run(board);
+        auto second = Search(config).run(board);
+        ASSERT_TRUE(first.bestMove.isValid());
+        ASSERT_LT(first.depth, config.depth);
+        ASSERT_EQ(first.nodes, second.nodes);
+        ASSERT_EQ(first.depth, second.depth);
+        ASSERT_EQ(first.score, second.score);
+        ASSERT_EQ(MoveHistory::pack(first.bestMove), MoveHistory::pack(second.bestMove));
+
+        // the simple player only picks by chance
+        std::vector<PackedMove> moves;
+        for (int i = 0; i < 2; i++)
+        {
+            auto copy   = std::make_shared<Board>(board);
+            auto player = IPlayer::createPlayer(PlayerType::simpleAi, Color::black, copy);
+            player->setSeed(42);
+            auto movement = player->move(Movement::invalid());
+            ASSERT_TRUE(movement.isValid());
+            moves.push_back(MoveHistory::pack(movement));
+        }
+        ASSERT_EQ(moves[0], moves[1]);
+    }
+
+    TEST(TestMovePicker, next_allStages_everyMoveOnceTtMoveFirst)
+    {
+        Board board;
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r2, BoardColumn::cE), Position(BoardRow::r4, BoardColumn::cE)).moveResult());
+        ASSERT_EQ(MoveResult::valid, board.move(Position(BoardRow::r7, BoardColumn::cD), Position(BoardRow::r5, BoardColumn::cD)).moveResult());
+
+        Movement    ttMovement;
+        MoveHistory history;
+        ttMovement.origin()      = Position(BoardRow::r1, BoardColumn::cG);
+        ttMovement.destination() = Position(BoardRow::r3, BoardColumn::cF);
+        const auto ttMove        = MoveHistory::pack(ttMovement);
+
+        ttMovement.origin()      = Position(BoardRow::r2, BoardColumn::cA);
+        ttMovement.destination() = Position(BoardRow::r3, BoardColumn::cA);
+        history.addKiller(0, MoveHistory::pack(ttMovement));
+
+        MovePicker picker(board, history, ttMove, 0, 0);
+        Movement   movement;
+
+        // a cutoff on the first move would need no generation at all
+        ASSERT_TRUE(picker.next(movement));
+        ASSERT_EQ(ttMove, MoveHistory::pack(movement));
+        ASSERT_EQ(MovePicker::Stage::generateCaptures, picker.stage());
+
+        ASSERT_TRUE(picker.next(movement));
+        ASSERT_TRUE(movement.hasFlag(EventFlag::capture));
+
+        std::vector<PackedMove> picked{ttMove, MoveHistory::pack(movement)};
+        while (picker.next(movement))
+            picked.emplace_back(MoveHistory::pack(movement));
+
+        std::vector<PackedMove> expected;
+        for (auto&& possible : board.getAllPossibleMoves(Color::white))
+            expected.emplace_back(MoveHistory::pack(possible));
+
+        std::sort(picked.begin(), picked.end());
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(expected, picked);
+        ASSERT_EQ(2, board.getAllMadeMoves().size());
+    }
+
+    TEST(TestTranspositionTable, store_probe_deeperEntryKept)
+    {
+        TranspositionTable table(1);
+        TranspositionEntry entry;
+
+        ASSERT_FALSE(table.probe(42, entry));
+
+        table.store(42, 7, 150, 4, Bound::lower);
+        table.store(42, 0, -20, 2, Bound::upper);
+        ASSERT_TRUE(table.probe(42, entry));
+        ASSERT_EQ(7, entry.move);
+        ASSERT_EQ(150, entry.score);
+        ASSERT_EQ(4, entry.depth);
+        ASSERT_EQ(Bound::lower, entry.bound);
+
+        table.store(42, 0, 30, 5, Bound::exact);
+        ASSERT_TRUE(table.probe(42, entry));
+        ASSERT_EQ(7, entry.move);
+        ASSERT_EQ(30, entry.score);
+
+        table.clear();
+        ASSERT_FALSE(table.probe(42, entry));
+    }
+
+    TEST_F(TestSearch, pawnHashTable_structure_termsAndHit)
+    {
+        const Position passedPos(BoardRow::r4, BoardColumn::cA);
+
+        createFigure(_board.at(passedPos), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r2, BoardColumn::cC), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r3, BoardColumn::cC), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r5, BoardColumn::cD), FigureType::pawn, Color::black);
+
+        // white: a4 passed and isolated, c2 and c3 isolated, c2 doubled; black: d5 isolated
+        const auto&   params = _board.getEvalParams();
+        PawnHashTable table(1);
+
+        const auto& entry = table.probe(_board);
+        for (size_t phase = 0; phase < 2; phase++)
+            ASSERT_EQ(params.passed[phase][3] + 2 * params.isolated[phase] + params.doubled[phase], entry.score[phase]);
+
+        ASSERT_EQ(BitboardHelper::bit(BitboardHelper::square(passedPos)), entry.passed[0]);
+        ASSERT_EQ(0, entry.passed[1]);
+        ASSERT_EQ(0, table.hits());
+
+        table.probe(_board);
+        ASSERT_EQ(2, table.probes());
+        ASSERT_EQ(1, table.hits());
+
+        // other parameters give another score for the same pawns
+        const auto score   = entry.score[0];
+        auto       changed = std::make_shared<EvalParams>(params);
+        changed->passed[0][3] += 50;
+        _board.setEvalParams(changed);
+        ASSERT_EQ(score + 50, table.probe(_board).score[0]);
+        ASSERT_EQ(1, table.hits());
+        ASSERT_EQ(score + 50, table.probe(_board).score[0]);
+        ASSERT_EQ(2, table.hits());
+    }
+
+    TEST_F(TestSearch, pawnHashTable_unsupportedAndGuarded_backward)
+    {
+        createFigure(_board.at(BoardRow::r3, BoardColumn::cE), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r4, BoardColumn::cD), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r5, BoardColumn::cF), FigureType::pawn, Color::black);
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cD), FigureType::pawn, Color::black);
+
+        // e3 can not be supported and e4 is guarded by f5, black d6 and f5 are isolated
+        const auto& params = _board.getEvalParams();
+        PawnEntry   entry{};
+        PawnHashTable::evaluate(_board, entry);
+
+        for (size_t phase = 0; phase < 2; phase++)
+            ASSERT_EQ(params.backward[phase] - 2 * params.isolated[phase], entry.score[phase]);
+    }
+
+    TEST_F(TestSearch, tablebase_kqk_perfectPlayAndAdjudication)
+    {
+        auto tablebase = std::make_shared<Tablebase>(".");
+        ASSERT_TRUE(tablebase->generate("KQK"));
+        ASSERT_FALSE(tablebase->generate("KQ"));
+        auto mirrored = _board;
+
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cB), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r2, BoardColumn::cH), FigureType::queen, Color::white);
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cA), FigureType::king, Color::black);
+
+        TablebaseResult result;
+        ASSERT_TRUE(tablebase->probe(_board, result));
+        ASSERT_EQ(Wdl::win, result.wdl);
+        ASSERT_EQ(1, result.plies);
+        ASSERT_EQ(GameResult::victoryWhite, tablebase->adjudicate(_board));
+
+        SearchConfig config;
+        config.tablebase = tablebase;
+        Search search(config);
+        auto   best = search.run(_board);
+        ASSERT_EQ(Position(BoardRow::r8, BoardColumn::cH), best.bestMove.destination());
+        ASSERT_EQ(Search::mateScore - 1, best.score);
+
+        // the queen on c7 stalemates the king
+        _board.makeMove(Position(BoardRow::r2, BoardColumn::cH), Position(BoardRow::r7, BoardColumn::cC));
+        ASSERT_TRUE(tablebase->probe(_board, result));
+        ASSERT_EQ(Wdl::draw, result.wdl);
+        ASSERT_EQ(GameResult::draw, tablebase->adjudicate(_board));
+        _board.unmakeMove();
+
+        // the same position with the colors swapped is found in the table the other way round
+        createFigure(mirrored, mirrored.at(BoardRow::r3, BoardColumn::cB), FigureType::king, Color::black);
+        createFigure(mirrored, mirrored.at(BoardRow::r7, BoardColumn::cH), FigureType::queen, Color::black);
+        createFigure(mirrored, mirrored.at(BoardRow::r1, BoardColumn::cA), FigureType::king, Color::white);
+        mirrored.makeNullMove();
+        ASSERT_TRUE(tablebase->probe(mirrored, result));
+        ASSERT_EQ(Wdl::win, result.wdl);
+        ASSERT_EQ(1, result.plies);
+        ASSERT_EQ(GameResult::victoryBlack, tablebase->adjudicate(mirrored));
+
+        for (auto name : {"./KQK.cmtb", "./KK.cmtb"})
+            std::remove(name);
+    }
+
+    TEST_F(TestSearch, tablebase_kpkpDoubleStep_answeredEnPassant)
+    {
+        // the promotions are not part of the test, their tables are left empty to save the time
+        for (auto material : {"KQKP", "KRKP", "KBKP", "KNKP"})
+        {
+            const std::string name(material);
+            const uint32_t    version = 1;
+            const uint32_t    length  = 4;
+            std::ofstream     out("./" + name + ".cmtb", std::ios::binary);
+            out.write("CMTB", 4);
+            out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(name.data(), length);
+            out.seekp(2 * 32 * 64 * 64 * 64 - 1, std::ios::cur);
+            out.put(0);
+        }
+
+        Tablebase tablebase(".");
+        ASSERT_TRUE(tablebase.generate("KPKP"));
+        auto doubleStepped = _board;
+
+        // the king has to go to b8, the double step c7-c5 is answered with b5xc6
+        createFigure(_board.at(BoardRow::r8, BoardColumn::cA), FigureType::king, Color::white);
+        createFigure(_board.at(BoardRow::r5, BoardColumn::cB), FigureType::pawn, Color::white);
+        createFigure(_board.at(BoardRow::r6, BoardColumn::cB), FigureType::king, Color::black);
+        createFigure(_board.at(BoardRow::r7, BoardColumn::cC), FigureType::pawn, Color::black);
+
+        TablebaseResult result;
+        ASSERT_TRUE(tablebase.probe(_board, result));
+        ASSERT_EQ(Wdl::draw, result.wdl);
+
+        // after the double step without the right to capture en passant white loses
+        createFigure(doubleStepped, doubleStepped.at(BoardRow::r8, BoardColumn::cB), FigureType::king, Color::white);
+        createFigure(doubleStepped, doubleStepped.at(BoardRow::r5, BoardColumn::cB), FigureType::pawn, Color::white);
+        createFigure(doubleStepped, doubleStepped.at(BoardRow::r6, BoardColumn::cB), FigureType::king, Color::black);
+        createFigure(doubleStepped, doubleStepped.at(BoardRow::r5, BoardColumn::cC), FigureType::pawn, Color::black);
+        ASSERT_TRUE(tablebase.probe(doubleStepped, result));
+        ASSERT_EQ(Wdl::loss, result.wdl);
+        ASSERT_EQ(26, result.plies);
+
+        for (auto name : {"./KPKP.cmtb", "./KQKP.cmtb", "./KRKP.cmtb", "./KBKP.cmtb", "./KNKP.cmtb", "./KPK.cmtb", "./KKP.cmtb",
+                          "./KQK.cmtb", "./KKQ.cmtb", "./KRK.cmtb", "./KKR.cmtb", "./KBK.cmtb", "./KKB.cmtb", "./KNK.cmtb",
+                          "./KKN.cmtb", "./KK.cmtb"})
+            std::remove(name);
+    }
+}
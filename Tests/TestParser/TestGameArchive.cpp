@@ -0,0 +1,138 @@
+/*!
+* \brief:  Implements the test game archive class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include "ChessParser/GameArchive.h"
+#include "ChessParser/PgnParser.h"
+
+namespace ChessNS
+{
+    TEST(TestGameArchive, fromPgn_read_sameGamesAsParsed)
+    {
+        const std::string archive = "TestGameArchive.cmga";
+        for (const std::string filename : {"./pgn_examples/10_games.pgn", "./pgn_examples/promotion_with_checkmate_and_enpassant.pgn"})
+        {
+            PgnParser  parser;
+            auto       games   = parser.parseFile(filename);
+            uint64_t   skipped = 1;
+            ASSERT_TRUE(GameArchive::fromPgn(filename, archive, 2, &skipped));
+            ASSERT_EQ(0u, skipped);
+
+            GameArchive reader;
+            ASSERT_TRUE(reader.open(archive));
+            ASSERT_EQ(games.size(), reader.size());
+
+            Game game;
+            for (uint64_t i = reader.size(); i-- > 0;)
+            {
+                ASSERT_TRUE(reader.read(i, game));
+                ASSERT_EQ(games[i].result, game.result);
+                ASSERT_EQ(games[i].header.size(), game.header.size());
+                ASSERT_EQ(games[i].header.white(), game.header.white());
+                ASSERT_EQ(games[i].movements.size(), game.movements.size());
+                for (size_t j = 0; j < game.movements.size(); j++)
+                {
+                    ASSERT_EQ(games[i].movements[j].destination(), game.movements[j].destination());
+                    ASSERT_EQ(games[i].movements[j].promotedTo(), game.movements[j].promotedTo());
+                    ASSERT_TRUE(game.movements[j].origin().isValid());
+                }
+            }
+            ASSERT_FALSE(reader.read(reader.size(), game));
+
+            std::atomic<uint64_t> moves{0};
+            ASSERT_EQ(games.size(), reader.forEach([&](uint64_t, Game& read) { moves += read.movements.size(); }, 3));
+            size_t expected = 0;
+            for (auto& parsed : games)
+                expected += parsed.movements.size();
+            ASSERT_EQ(expected, moves);
+        }
+        std::remove(archive.c_str());
+    }
+
+    TEST(TestGameArchive, encode_illegalMove_nothingAppended)
+    {
+        PgnParser parser;
+        auto      games = parser.parseFile("./pgn_examples/fools_mate.pgn");
+        ASSERT_EQ(1u, games.size());
+
+        Board                      board;
+        std::vector<unsigned char> data{42};
+        ASSERT_TRUE(GameArchive::encode(board, games[0], data));
+        ASSERT_LT(data.size(), 48u);
+
+        Game        game;
+        const auto* current = data.data() + 1;
+        ASSERT_TRUE(GameArchive::decode(board, current, data.data() + data.size(), game));
+        ASSERT_EQ(data.data() + data.size(), current);
+        ASSERT_EQ(games[0].movements.size(), game.movements.size());
+
+        // the board is in the start position again, so a move into the own figures is illegal
+        const auto size = data.size();
+        games[0].movements[0].destination() = Position(1, 4);
+        ASSERT_FALSE(GameArchive::encode(board, games[0], data));
+        ASSERT_EQ(size, data.size());
+    }
+
+    TEST(TestGameArchive, decode_unknownResultOrPromotion_rejected)
+    {
+        PgnParser parser;
+        auto      games = parser.parseFile("./pgn_examples/promotion_with_checkmate_and_enpassant.pgn");
+        ASSERT_EQ(1u, games.size());
+
+        Board                      board;
+        std::vector<unsigned char> data;
+        ASSERT_TRUE(GameArchive::encode(board, games[0], data));
+
+        // the result follows the length, the last move of the game is a promotion and its figure ends the record
+        const size_t resultAt = data.size() - 1 < 0x80 ? 1 : 2;
+        ASSERT_EQ(static_cast<unsigned char>(GameResult::victoryWhite), data[resultAt]);
+        ASSERT_EQ(static_cast<unsigned char>(FigureType::queen), data.back());
+
+        Game game;
+        for (const unsigned char figure : {static_cast<unsigned char>(FigureType::none), static_cast<unsigned char>(FigureType::king),
+                                           static_cast<unsigned char>(FigureType::pawn), static_cast<unsigned char>(200)})
+        {
+            auto broken   = data;
+            broken.back() = figure;
+            const auto* current = broken.data();
+            ASSERT_FALSE(GameArchive::decode(board, current, broken.data() + broken.size(), game));
+        }
+
+        auto broken      = data;
+        broken[resultAt] = static_cast<unsigned char>(GameResult::draw) + 1;
+        const auto* current = broken.data();
+        ASSERT_FALSE(GameArchive::decode(board, current, broken.data() + broken.size(), game));
+
+        // the board is in the start position again after a broken record
+        current = data.data();
+        ASSERT_TRUE(GameArchive::decode(board, current, data.data() + data.size(), game));
+        ASSERT_EQ(games[0].movements.size(), game.movements.size());
+    }
+}
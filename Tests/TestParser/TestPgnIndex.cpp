@@ -0,0 +1,133 @@
+/*!
+* \brief:  Implements the test pgn index class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include "ChessParser/GameReader.h"
+#include "ChessParser/PgnIndex.h"
+#include "ChessParser/PgnParser.h"
+
+namespace ChessNS
+{
+    TEST(TestPgnIndex, build_tenGames_entriesFitTheGames)
+    {
+        const std::string filename = "./pgn_examples/10_games.pgn";
+        const std::string index    = "TestPgnIndex.cmpi";
+        PgnParser         parser;
+        const auto        games = parser.parseFile(filename);
+        MappedFile        file(filename);
+        ASSERT_TRUE(file.isOpen());
+
+        ASSERT_TRUE(PgnIndex::build(filename, index, 3));
+        PgnIndex    entries;
+        std::string text(reinterpret_cast<const char*>(file.data()), file.size());
+        ASSERT_FALSE(entries.open(index, StringView(text.data(), text.size() - 1)));
+
+        // a file of the same size with another result at the end is another file
+        const auto result = text.rfind("1-0");
+        ASSERT_NE(std::string::npos, result);
+        text.replace(result, 3, "0-1");
+        ASSERT_FALSE(entries.open(index, text));
+        text.replace(result, 3, "1-0");
+        ASSERT_TRUE(entries.open(index, text));
+        ASSERT_EQ(games.size(), entries.size());
+
+        uint64_t end = 3;
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            // the games follow each other without a gap, the first one after the byte order mark
+            ASSERT_EQ(end, entries[i].offset);
+            ASSERT_EQ('[', file.data()[entries[i].offset]);
+            end = entries[i].offset + entries[i].length;
+
+            ASSERT_EQ(PgnIndex::hash(games[i].header.white()), entries[i].white);
+            ASSERT_EQ(PgnIndex::hash(games[i].header.black()), entries[i].black);
+            ASSERT_EQ(games[i].header.whiteElo(), entries[i].whiteElo);
+            ASSERT_EQ(static_cast<uint8_t>(games[i].result), entries[i].result);
+        }
+        ASSERT_EQ(file.size(), end);
+        ASSERT_EQ(PgnIndex::hash("BarneyGamble"), entries[0].white);
+        std::remove(index.c_str());
+    }
+
+    TEST(TestPgnIndex, openIndexed_seek_sameGameAsReadInOrder)
+    {
+        const std::string filename = "TestPgnIndex.pgn";
+        {
+            std::ifstream in("./pgn_examples/10_games.pgn", std::ios::binary);
+            std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+            out << in.rdbuf();
+        }
+
+        {
+            // the files are mapped as long as the reader lives
+            PgnParser  parser;
+            const auto games = parser.parseFile(filename);
+            GameReader reader;
+            ASSERT_TRUE(reader.openIndexed(filename, 2));
+            ASSERT_EQ(games.size(), reader.index().size());
+
+            for (auto game : {7u, 2u, 9u, 0u})
+            {
+                ASSERT_TRUE(reader.seek(game));
+                ASSERT_TRUE(reader.next());
+                ASSERT_EQ(games[game].movements.size(), reader.game().movements.size());
+                ASSERT_EQ(games[game].header.white(), reader.game().header.white());
+                ASSERT_EQ(game + 1, reader.games());
+            }
+            ASSERT_FALSE(reader.seek(games.size()));
+
+            // the index is kept until the file changes
+            ASSERT_TRUE(reader.openIndexed(filename));
+            {
+                std::ofstream out(filename, std::ios::binary | std::ios::app);
+                out << "\n[Event \"more\"]\n[Result \"1-0\"]\n1. e4 1-0\n";
+            }
+            ASSERT_TRUE(reader.openIndexed(filename));
+            ASSERT_EQ(games.size() + 1, reader.index().size());
+            ASSERT_TRUE(reader.seek(games.size()));
+            ASSERT_TRUE(reader.next());
+            ASSERT_EQ("more", reader.game().header.event());
+            ASSERT_FALSE(reader.next());
+            ASSERT_EQ(static_cast<uint8_t>(GameResult::victoryWhite), reader.index()[games.size()].result);
+
+            // an edit which keeps the size of the file is found as well
+            {
+                std::fstream out(filename, std::ios::binary | std::ios::in | std::ios::out);
+                const std::string edit = "0-1\"]\n1. e4 0-1\n";
+                out.seekp(-static_cast<std::streamoff>(edit.size()), std::ios::end);
+                out << edit;
+            }
+            ASSERT_TRUE(reader.openIndexed(filename));
+            ASSERT_EQ(static_cast<uint8_t>(GameResult::victoryBlack), reader.index()[games.size()].result);
+        }
+
+        std::remove(PgnIndex::filename(filename).c_str());
+        std::remove(filename.c_str());
+    }
+}
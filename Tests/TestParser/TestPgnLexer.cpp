@@ -0,0 +1,279 @@
+/*!
+* \brief:  Implements the test pgn lexer class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <vector>
+#include "ChessParser/GameReader.h"
+#include "ChessParser/PgnLexer.h"
+#include "ChessParser/PgnParser.h"
+
+namespace ChessNS
+{
+    TEST(TestPgnLexer, next_allTokenTypes_viewsIntoTheBuffer)
+    {
+        const std::string text = "[Event \"A \\\"b\\\"\"]\n% escaped\n1. e4 {two\nlines} e5 $14 (1... d5) ; rest\n2. O-O+ *";
+        PgnLexer          lexer(text);
+
+        const std::vector<std::pair<PgnTokenType, std::string>> expected = {
+            {PgnTokenType::leftBracket, "["}, {PgnTokenType::symbol, "Event"}, {PgnTokenType::string, "A \\\"b\\\""},
+            {PgnTokenType::rightBracket, "]"}, {PgnTokenType::integer, "1"}, {PgnTokenType::period, "."},
+            {PgnTokenType::symbol, "e4"}, {PgnTokenType::comment, "two\nlines"}, {PgnTokenType::symbol, "e5"},
+            {PgnTokenType::nag, "14"}, {PgnTokenType::leftParenthesis, "("}, {PgnTokenType::integer, "1"},
+            {PgnTokenType::period, "."}, {PgnTokenType::period, "."}, {PgnTokenType::period, "."},
+            {PgnTokenType::symbol, "d5"}, {PgnTokenType::rightParenthesis, ")"}, {PgnTokenType::comment, " rest"},
+            {PgnTokenType::integer, "2"}, {PgnTokenType::period, "."}, {PgnTokenType::symbol, "O-O+"},
+            {PgnTokenType::asterisk, "*"}, {PgnTokenType::end, ""}};
+
+        for (auto& token : expected)
+        {
+            const auto next = lexer.next();
+            ASSERT_EQ(token.first, next.type);
+            ASSERT_EQ(token.second, next.text.toString());
+            if (next.type != PgnTokenType::end)
+            {
+                ASSERT_TRUE(next.text.data() >= text.data() && next.text.data() < text.data() + text.size());
+            }
+        }
+
+        ASSERT_EQ(5, lexer.line());
+        ASSERT_EQ(text.size(), lexer.offset());
+    }
+
+    TEST(TestPgnLexer, parseNextGame_invalidMoveAndMissingResult_skippedAndContinued)
+    {
+        const std::string text = "1. e4 e5 2. Zz9 Nc6 1-0\n\n[Event \"broken\"]\n1. e4 Zz9 e5\n\n"
+                                 "[Event \"next\"]\n1. d4 d5 2. O-O-O#\n[Event \"last\"]\n1. c4 1/2-1/2\n";
+        PgnLexer          lexer(text);
+        PgnParser         parser;
+        Game              game;
+
+        ASSERT_THROW(parser.parseNextGame(lexer, game), std::out_of_range);
+
+        // a broken game without a result ends at the tags of the next game
+        ASSERT_THROW(parser.parseNextGame(lexer, game), std::out_of_range);
+
+        // the tags of the next game end a game without a result
+        ASSERT_TRUE(parser.parseNextGame(lexer, game));
+        ASSERT_EQ("next", game.header.event());
+        ASSERT_EQ(GameResult::none, game.result);
+        ASSERT_EQ(3, game.movements.size());
+        ASSERT_TRUE(game.movements[2].hasFlag(EventFlag::castling));
+        ASSERT_TRUE(game.movements[2].hasFlag(EventFlag::checkmate));
+        ASSERT_EQ(Position(BoardRow::r1, BoardColumn::cC), game.movements[2].destination());
+
+        ASSERT_TRUE(parser.parseNextGame(lexer, game));
+        ASSERT_EQ(GameResult::draw, game.result);
+        ASSERT_EQ(1, game.movements.size());
+
+        ASSERT_FALSE(parser.parseNextGame(lexer, game));
+    }
+
+    TEST(TestPgnLexer, parseFile_mappedFile_sameGamesAsTheStream)
+    {
+        PgnParser     parser;
+        std::ifstream in("./pgn_examples/10_games.pgn");
+        const auto    streamed = parser.parseMultipleGames(in);
+        const auto    mapped   = parser.parseFile("./pgn_examples/10_games.pgn");
+
+        ASSERT_EQ(10, mapped.size());
+        ASSERT_EQ(streamed.size(), mapped.size());
+        for (size_t i = 0; i < mapped.size(); i++)
+        {
+            ASSERT_EQ(streamed[i].result, mapped[i].result);
+            ASSERT_EQ(streamed[i].movements.size(), mapped[i].movements.size());
+            for (size_t j = 0; j < mapped[i].movements.size(); j++)
+            {
+                auto expected = streamed[i].movements[j];
+                auto actual   = mapped[i].movements[j];
+                ASSERT_EQ(expected.destination(), actual.destination());
+                ASSERT_EQ(expected.figureType(), actual.figureType());
+                ASSERT_EQ(expected.color(), actual.color());
+            }
+        }
+
+        ASSERT_TRUE(parser.parseFile("./pgn_examples/missing.pgn").empty());
+    }
+
+    TEST(TestPgnLexer, parseFileParallel_splitAtGames_sameGamesInOrder)
+    {
+        PgnParser  parser;
+        const auto sequential = parser.parseFile("./pgn_examples/10_games.pgn");
+
+        MappedFile file("./pgn_examples/10_games.pgn");
+        ASSERT_TRUE(file.isOpen());
+        const auto buffer = StringView(reinterpret_cast<const char*>(file.data()), file.size());
+        const auto parts  = PgnParser::splitGames(buffer, 4);
+        ASSERT_EQ(4, parts.size());
+        ASSERT_EQ(buffer.data(), parts[0].data());
+        for (size_t i = 1; i < parts.size(); i++)
+        {
+            ASSERT_TRUE(parts[i].startsWith("[Event "));
+            ASSERT_EQ(parts[i - 1].end(), parts[i].begin());
+        }
+        ASSERT_EQ(buffer.end(), parts.back().end());
+
+        const auto parallel = parser.parseFileParallel("./pgn_examples/10_games.pgn", 3);
+        ASSERT_EQ(sequential.size(), parallel.size());
+        for (size_t i = 0; i < parallel.size(); i++)
+        {
+            ASSERT_EQ(sequential[i].result, parallel[i].result);
+            ASSERT_EQ(sequential[i].movements.size(), parallel[i].movements.size());
+        }
+
+        std::atomic<size_t> moves{0};
+        ASSERT_TRUE(parser.parseFileParallel("./pgn_examples/10_games.pgn", [&moves](Game& game) { moves += game.movements.size(); }, 3));
+        size_t expected = 0;
+        for (auto& game : sequential)
+            expected += game.movements.size();
+        ASSERT_EQ(expected, moves.load());
+    }
+
+    namespace
+    {
+        class CountingVisitor : public PgnVisitor
+        {
+        public:
+            void onGameStart() override { games++; }
+
+            void onTag(StringView name, StringView value) override
+            {
+                tags++;
+                if (name == "PlyCount")
+                    plies.push_back(std::stoul(value.toString()));
+            }
+
+            void onMove(const Movement&) override { moves[games - 1]++; }
+
+            void onResult(GameResult result) override
+            {
+                if (result != GameResult::none)
+                    results++;
+            }
+
+            size_t                   games{}, tags{}, results{};
+            std::map<size_t, size_t> moves;
+            std::vector<size_t>      plies;
+        };
+    }
+
+    TEST(TestPgnLexer, visitGames_tagsMovesAndResults_sameAsTheGames)
+    {
+        PgnParser       parser;
+        const auto      games = parser.parseFile("./pgn_examples/10_games.pgn");
+        PgnLexer        lexer;
+        CountingVisitor visitor;
+        ASSERT_TRUE(lexer.open("./pgn_examples/10_games.pgn"));
+
+        ASSERT_EQ(10, parser.visitGames(lexer, visitor));
+        ASSERT_EQ(10, visitor.games);
+        ASSERT_EQ(10, visitor.results);
+        ASSERT_EQ(167, visitor.tags);
+        ASSERT_EQ(10, visitor.plies.size());
+        for (size_t i = 0; i < games.size(); i++)
+        {
+            ASSERT_EQ(games[i].movements.size(), visitor.moves[i]);
+            ASSERT_EQ(visitor.plies[i], visitor.moves[i]);
+        }
+    }
+
+    TEST(TestPgnLexer, gameReader_everyGame_gameReusedAndInvalidCounted)
+    {
+        PgnParser  parser;
+        const auto games = parser.parseFile("./pgn_examples/10_games.pgn");
+        GameReader reader;
+        ASSERT_TRUE(reader.open("./pgn_examples/10_games.pgn"));
+
+        size_t index    = 0;
+        size_t capacity = 0;
+        while (reader.next())
+        {
+            ASSERT_LT(index, games.size());
+            ASSERT_EQ(games[index].result, reader.game().result);
+            ASSERT_EQ(games[index].movements.size(), reader.game().movements.size());
+            index++;
+
+            // the memory of the longest game so far is kept
+            ASSERT_LE(capacity, reader.game().movements.capacity());
+            capacity = reader.game().movements.capacity();
+        }
+        ASSERT_EQ(games.size(), index);
+        ASSERT_EQ(games.size(), reader.games());
+        ASSERT_EQ(0, reader.invalidGames());
+
+        const std::string text = "1. e4 e5 2. Zz9 Nc6 1-0\n1. d4 d5 0-1\n";
+        GameReader        buffered(text);
+        ASSERT_TRUE(buffered.next());
+        ASSERT_EQ(GameResult::victoryBlack, buffered.game().result);
+        ASSERT_FALSE(buffered.next());
+        ASSERT_EQ(1, buffered.games());
+        ASSERT_EQ(1, buffered.invalidGames());
+    }
+
+    TEST(TestPgnLexer, parseNextHeader_movetextSkipped_sameHeadersAsTheGames)
+    {
+        PgnParser  parser;
+        const auto games = parser.parseFile("./pgn_examples/10_games.pgn");
+        PgnLexer   lexer;
+        GameHeader header;
+        ASSERT_TRUE(lexer.open("./pgn_examples/10_games.pgn"));
+
+        for (auto& game : games)
+        {
+            ASSERT_TRUE(parser.parseNextHeader(lexer, header));
+            ASSERT_EQ(game.header.size(), header.size());
+            ASSERT_EQ(game.header.white(), header.white());
+            ASSERT_EQ(game.header.whiteElo(), header.whiteElo());
+            ASSERT_EQ(game.result, header.result());
+        }
+        ASSERT_FALSE(parser.parseNextHeader(lexer, header));
+        ASSERT_EQ("BarneyGamble", games[0].header.white());
+        ASSERT_EQ(1956, games[0].header.whiteElo());
+
+        // brace comments may contain anything
+        const std::string text = "[White \"a\"]\n1. e4 {a\n[comment]} e5 1-0\n\n[White \"b\"]\n1. d4 *\n";
+        lexer.reset(text);
+        ASSERT_TRUE(parser.parseNextHeader(lexer, header));
+        ASSERT_EQ("a", header.white());
+        ASSERT_TRUE(parser.parseNextHeader(lexer, header));
+        ASSERT_EQ("b", header.white());
+        ASSERT_EQ(GameResult::none, header.result());
+        ASSERT_EQ(7, lexer.line());
+        ASSERT_FALSE(parser.parseNextHeader(lexer, header));
+
+        GameReader reader;
+        reader.setHeadersOnly(true);
+        ASSERT_TRUE(reader.open("./pgn_examples/10_games.pgn"));
+        size_t strong = 0;
+        while (reader.next())
+            strong += reader.game().header.whiteElo() >= 2000 ? 1 : 0;
+        ASSERT_EQ(games.size(), reader.games());
+        ASSERT_LT(0, strong);
+    }
+}
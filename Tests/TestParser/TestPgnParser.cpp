@@ -25,6 +25,8 @@
  */
 
 #include "gtest/gtest.h"
+#include <sstream>
+#include <stdexcept>
 #include "ChessParser/PgnParser.h"
 #include "ChessEngine//Board.h"
 
@@ -198,4 +200,53 @@ namespace ChessNS
             ASSERT_EQ(game.movements.at(i).moveResult(), madeMoves.at(i).moveResult());
         }
     }
+
+    TEST_F(TestPgnParser, parseSingleGame_tagsAndMovetext_HeaderAndMovements)
+    {
+        PgnParser          parser;
+        std::istringstream in("[Event \"Test\"]\n[White \"Alice\"]\n[WhiteElo \"2100\"]\n[Result \"0-1\"]\n\n"
+                              "1. f3 e5 2. g4 Qh4# 0-1\n");
+        auto               game = parser.parseSingleGame(in);
+
+        ASSERT_EQ(GameResult::victoryBlack, game.result);
+        ASSERT_EQ(4, game.header.size());
+        ASSERT_EQ("Test", game.header.event());
+        ASSERT_EQ("Alice", game.header.white());
+        ASSERT_TRUE(game.header.black().empty());
+        ASSERT_EQ(2100, game.header.whiteElo());
+        ASSERT_EQ(0, game.header.blackElo());
+        ASSERT_EQ(GameResult::victoryBlack, game.header.result());
+
+        ASSERT_EQ(4, game.movements.size());
+        ASSERT_EQ(Position(BoardRow::r5, BoardColumn::cE), game.movements[1].destination());
+        ASSERT_EQ(Color::black, game.movements[1].color());
+        ASSERT_EQ(Position(BoardRow::r4, BoardColumn::cH), game.movements[3].destination());
+        ASSERT_EQ(FigureType::queen, game.movements[3].figureType());
+        ASSERT_EQ(Color::black, game.movements[3].color());
+        ASSERT_TRUE(game.movements[3].hasFlag(EventFlag::checkmate));
+    }
+
+    TEST_F(TestPgnParser, parseSingleGame_brokenGameBeforeGoodGames_restOfBrokenGameSkipped)
+    {
+        PgnParser          parser;
+        std::istringstream in("[Event \"Broken\"]\n\n1. e4 e5 2. Zz9 Nc6\n3. Bb5 a6 1-0\n\n"
+                              "[Event \"Good\"]\n\n1. d4 d5 1/2-1/2\n\n"
+                              "1. e4 Zz9 0-1\n\n"
+                              "1. f3 e5\n2. Zz9\n\n[Event \"Last\"]\n\n1. c4 0-1\n");
+
+        ASSERT_THROW(parser.parseSingleGame(in), std::out_of_range);
+        auto game = parser.parseSingleGame(in);
+        ASSERT_EQ("Good", game.header.event());
+        ASSERT_EQ(GameResult::draw, game.result);
+        ASSERT_EQ(2, game.movements.size());
+        ASSERT_EQ(Color::white, game.movements[0].color());
+
+        // the result on the line of the error ends the game, a tag section ends a game without a result
+        ASSERT_THROW(parser.parseSingleGame(in), std::out_of_range);
+        ASSERT_THROW(parser.parseSingleGame(in), std::out_of_range);
+        game = parser.parseSingleGame(in);
+        ASSERT_EQ("Last", game.header.event());
+        ASSERT_EQ(GameResult::victoryBlack, game.result);
+        ASSERT_EQ(1, game.movements.size());
+    }
 }
@@ -0,0 +1,183 @@
+/*!
+* \brief:  Implements the test pgn writer class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "ChessParser/GameArchive.h"
+#include "ChessParser/PgnParser.h"
+#include "ChessParser/PgnWriter.h"
+
+namespace ChessNS
+{
+    TEST(TestPgnWriter, write_markersMissingInSource_computedFromBoard)
+    {
+        PgnParser          parser;
+        std::istringstream in("[Event \"Say \\\"hi\\\"\"]\n\n1. e4 f5 2. Qh5 g6 3. d3 a6 4. Nf3 a5 5. Nbd2 a4 6. Nd4 a3 7. N2f3 axb2 "
+                              "8. Bxb2 gxh5 1-0");
+        auto               game = parser.parseSingleGame(in);
+
+        std::string text;
+        {
+            PgnWriter writer([&text](const char* data, size_t size)
+                             {
+                                 text.append(data, size);
+                                 return true;
+                             });
+            ASSERT_TRUE(writer.write(game));
+            ASSERT_EQ(1u, writer.games());
+        }
+
+        // the escapes are kept in the tag, the lines end before 80 characters
+        ASSERT_EQ("[Event \"Say \\\"hi\\\"\"]\n[Result \"1-0\"]\n\n"
+                  "1. e4 f5 2. Qh5+ g6 3. d3 a6 4. Nf3 a5 5. Nbd2 a4 6. Nd4 a3 7. N2f3 axb2\n"
+                  "8. Bxb2 gxh5 1-0\n\n",
+                  text);
+
+        std::istringstream written(text);
+        auto               reparsed = parser.parseSingleGame(written);
+        ASSERT_EQ(game.movements.size(), reparsed.movements.size());
+        ASSERT_EQ("Say \\\"hi\\\"", reparsed.header.event());
+    }
+
+    TEST(TestPgnWriter, write_illegalMove_nothingWritten)
+    {
+        PgnParser          parser;
+        auto               game = parser.parseSingleGame("./pgn_examples/fools_mate.pgn");
+        std::ostringstream out;
+        {
+            PgnWriter writer(out);
+            ASSERT_TRUE(writer.write(game));
+            game.movements[2].destination() = Position(5, 6);
+            ASSERT_FALSE(writer.write(game));
+            ASSERT_EQ(1u, writer.games());
+        }
+        ASSERT_EQ("[Result \"0-1\"]\n\n1. f3 e5 2. g4 Qh4# 0-1\n\n", out.str());
+    }
+
+    TEST(TestPgnWriter, write_board_madeMoves)
+    {
+        Board board;
+        board.makeMove(Position(1, 4), Position(3, 4));
+        board.makeMove(Position(6, 3), Position(4, 3));
+        board.makeMove(Position(3, 4), Position(4, 3));
+
+        GameHeader header;
+        header.add("White", "Alice");
+        std::ostringstream out;
+        {
+            PgnWriter writer(out);
+            ASSERT_TRUE(writer.write(board, header, GameResult::none));
+        }
+        ASSERT_EQ("[White \"Alice\"]\n[Result \"*\"]\n\n1. e4 d5 2. exd5 *\n\n", out.str());
+        ASSERT_EQ(3u, board.getAllMadeMoves().size());
+    }
+
+    TEST(TestPgnWriter, toPgn_archive_sameGamesAsParsed)
+    {
+        const std::string archive = "TestPgnWriter.cmga";
+        const std::string pgn     = "TestPgnWriter.pgn";
+        for (const std::string filename : {"./pgn_examples/10_games.pgn", "./pgn_examples/promotion_with_checkmate_and_enpassant.pgn"})
+        {
+            PgnParser parser;
+            auto      games = parser.parseFile(filename);
+            ASSERT_TRUE(GameArchive::fromPgn(filename, archive));
+            ASSERT_TRUE(GameArchive::toPgn(archive, pgn));
+
+            auto written = parser.parseFile(pgn);
+            ASSERT_EQ(games.size(), written.size());
+            for (size_t i = 0; i < games.size(); i++)
+            {
+                ASSERT_EQ(games[i].result, written[i].result);
+                ASSERT_EQ(games[i].header.size(), written[i].header.size());
+                ASSERT_EQ(games[i].header.black(), written[i].header.black());
+                ASSERT_EQ(games[i].movements.size(), written[i].movements.size());
+                for (size_t j = 0; j < games[i].movements.size(); j++)
+                {
+                    ASSERT_EQ(games[i].movements[j].destination(), written[i].movements[j].destination());
+                    ASSERT_EQ(games[i].movements[j].promotedTo(), written[i].movements[j].promotedTo());
+                    ASSERT_EQ(games[i].movements[j].hasFlag(EventFlag::checkmate), written[i].movements[j].hasFlag(EventFlag::checkmate));
+                }
+            }
+        }
+        std::remove(archive.c_str());
+        std::remove(pgn.c_str());
+    }
+
+    TEST(TestPgnWriter, toPgn_severalBlocksOnThreads_writtenInOrder)
+    {
+        const std::string source  = "TestPgnWriterSource.pgn";
+        const std::string archive = "TestPgnWriter.cmga";
+        const std::string pgn     = "TestPgnWriter.pgn";
+        const std::string single  = "TestPgnWriterSingle.pgn";
+
+        // enough numbered copies of the games for several blocks
+        PgnParser parser;
+        auto      games = parser.parseFile("./pgn_examples/10_games.pgn");
+        {
+            std::ofstream out(source, std::ios::binary);
+            PgnWriter     writer(out);
+            for (unsigned copy = 0; copy < 100; copy++)
+                for (auto& game : games)
+                {
+                    const auto number = std::to_string(copy);
+                    game.header.add("Copy", number);
+                    ASSERT_TRUE(writer.write(game));
+                }
+        }
+
+        ASSERT_TRUE(GameArchive::fromPgn(source, archive, 1));
+        ASSERT_TRUE(GameArchive::toPgn(archive, pgn, 3));
+        ASSERT_TRUE(GameArchive::toPgn(archive, single, 1));
+
+        auto written = parser.parseFile(pgn);
+        ASSERT_EQ(100 * games.size(), written.size());
+        for (size_t i = 0; i < written.size(); i++)
+        {
+            const auto copy = written[i].header.tag("Copy");
+            ASSERT_EQ(std::to_string(i / games.size()), std::string(copy.data(), copy.size()));
+            ASSERT_EQ(games[i % games.size()].movements.size(), written[i].movements.size());
+        }
+
+        std::ifstream      threaded(pgn, std::ios::binary);
+        std::ifstream      ordered(single, std::ios::binary);
+        std::ostringstream threadedText;
+        std::ostringstream orderedText;
+        threadedText << threaded.rdbuf();
+        orderedText << ordered.rdbuf();
+        ASSERT_EQ(orderedText.str(), threadedText.str());
+
+        threaded.close();
+        ordered.close();
+        std::remove(source.c_str());
+        std::remove(archive.c_str());
+        std::remove(pgn.c_str());
+        std::remove(single.c_str());
+    }
+}
@@ -0,0 +1,90 @@
+/*!
+* \brief:  Implements the test san decoder class
+*
+* The MIT License (MIT)
+*
+* Copyright (c) 2020 Sascha Schiwy. All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+ */
+
+
+#include "gtest/gtest.h"
+#include "ChessParser/SanDecoder.h"
+
+namespace ChessNS
+{
+    TEST(TestSanDecoder, decode_everyKindOfMove_compactRecord)
+    {
+        SanMove move;
+        ASSERT_EQ(8, sizeof(SanMove));
+
+        ASSERT_TRUE(SanDecoder::decode("e4", move));
+        ASSERT_EQ(FigureType::pawn, move.figureType());
+        ASSERT_EQ(3, move.toRow);
+        ASSERT_EQ(4, move.toColumn);
+        ASSERT_EQ(-1, move.fromRow);
+        ASSERT_EQ(-1, move.fromColumn);
+        ASSERT_EQ(0, move.flags);
+
+        ASSERT_TRUE(SanDecoder::decode("exd5", move));
+        ASSERT_TRUE(move.hasFlag(EventFlag::capture));
+        ASSERT_EQ(4, move.fromColumn);
+        ASSERT_EQ(-1, move.fromRow);
+
+        ASSERT_TRUE(SanDecoder::decode("R1a3+", move));
+        ASSERT_EQ(FigureType::rook, move.figureType());
+        ASSERT_EQ(0, move.fromRow);
+        ASSERT_TRUE(move.hasFlag(EventFlag::check));
+
+        ASSERT_TRUE(SanDecoder::decode("Qh4xe1#", move));
+        ASSERT_EQ(3, move.fromRow);
+        ASSERT_EQ(7, move.fromColumn);
+        ASSERT_EQ(0, move.toRow);
+        ASSERT_TRUE(move.hasFlag(EventFlag::capture));
+        ASSERT_TRUE(move.hasFlag(EventFlag::checkmate));
+
+        ASSERT_TRUE(SanDecoder::decode("exf8=N+!?", move));
+        ASSERT_EQ(FigureType::knight, static_cast<FigureType>(move.promotedTo));
+        ASSERT_TRUE(move.hasFlag(EventFlag::promotion));
+        ASSERT_TRUE(move.hasFlag(EventFlag::check));
+
+        ASSERT_TRUE(SanDecoder::decode("b1Q", move));
+        ASSERT_EQ(FigureType::queen, static_cast<FigureType>(move.promotedTo));
+
+        ASSERT_TRUE(SanDecoder::decode("O-O-O#", move));
+        ASSERT_TRUE(move.hasFlag(EventFlag::castling));
+        ASSERT_TRUE(move.hasFlag(EventFlag::checkmate));
+        ASSERT_EQ(2, move.toColumn);
+
+        ASSERT_TRUE(SanDecoder::decode("0-0", move));
+        ASSERT_EQ(6, move.toColumn);
+        auto castling = move.toMovement(Color::black, 12);
+        ASSERT_EQ(Position(BoardRow::r8, BoardColumn::cG), castling.destination());
+        ASSERT_EQ(FigureType::king, castling.figureType());
+        ASSERT_EQ(12, castling.round());
+    }
+
+    TEST(TestSanDecoder, decode_invalidMoves_false)
+    {
+        SanMove move;
+        for (auto text : {"", "Z", "K", "e", "e9", "i4", "4e", "O", "O-O-O-O", "Nb1c3d4", "Ke8=Q", "e8=", "e8=K", "e4 "})
+            ASSERT_FALSE(SanDecoder::decode(text, move)) << text;
+    }
+}